@@ -23,7 +23,11 @@ void ofxOscParameterSync::setup(ofParameterGroup &group, int localPort, const st
 void ofxOscParameterSync::update(){
 	if(receiver.hasWaitingMessages()){
 		updatingParameter = true;
-		receiver.getParameter(syncGroup);
+		{
+			// all the waiting messages notify once per parameter
+			ofParameterTransaction transaction;
+			receiver.getParameter(syncGroup);
+		}
 		updatingParameter = false;
 	}
 }
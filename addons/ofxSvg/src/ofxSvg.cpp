@@ -53,6 +53,10 @@ void ofxSVG::load(string path){
 	setupDiagram(diagram);
 
 	svgtiny_free(diagram);
+
+	// tessellate everything in parallel now instead of one path at a time
+	// during the first draw
+	ofTessellateAll(paths);
 }
 
 void ofxSVG::draw(){
@@ -1,98 +1,279 @@
 #include "ofxThreadedImageLoader.h"
+#include <algorithm>
 #include <sstream>
-ofxThreadedImageLoader::ofxThreadedImageLoader(){
+ofxThreadedImageLoader::ofxThreadedImageLoader()
+:ofxThreadedImageLoader(Settings()){
+}
+
+ofxThreadedImageLoader::ofxThreadedImageLoader(const Settings & settings)
+:settings(settings)
+,decodingTasks(ofGetTaskPool()){
 	nextID = 0;
+	maxDecoding = settings.numThreads;
+	if(maxDecoding == 0){
+		maxDecoding = std::max<size_t>(ofGetTaskPool().getNumThreads(), 1);
+	}
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
-    startThread();
-    lastUpdate = 0;
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
-	waitForThread(true);
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		stopping = true;
+		images_to_decode.clear();
+	}
+	// the tasks finish the images they are decoding and return
+	decodingTasks.wait();
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename) {
+int ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename, int priority) {
 	nextID++;
 	ofImageLoaderEntry entry(image);
 	entry.filename = filename;
 	entry.image->setUseTexture(false);
 	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+	entry.id = nextID;
+	entry.priority = priority;
+	entry.requestTime = ofGetElapsedTimeMicros();
+
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		images_to_decode.push_back(entry);
+		std::push_heap(images_to_decode.begin(), images_to_decode.end());
+		startDecoding(lck);
+	}
+	return entry.id;
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url) {
+int ofxThreadedImageLoader::loadFromURL(ofImage& image, string url, int priority) {
 	nextID++;
 	ofImageLoaderEntry entry(image);
 	entry.url = url;
-	entry.image->setUseTexture(false);	
+	entry.image->setUseTexture(false);
 	entry.name = "image" + ofToString(nextID);
-	images_async_loading[entry.name] = entry;
-	ofLoadURLAsync(entry.url, entry.name);
+	entry.id = nextID;
+	entry.priority = priority;
+	entry.requestTime = ofGetElapsedTimeMicros();
+	entry.urlRequestId = ofLoadURLAsync(entry.url, entry.name);
+	images_async_loading[entry.urlRequestId] = entry;
+	return entry.id;
+}
+
+
+// Removes the load from every queue, waiting for a worker that might be
+// decoding it.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(int id) {
+	// images_async_loading is only used from the update thread
+	for(auto it = images_async_loading.begin(); it != images_async_loading.end(); ++it){
+		if(it->second.id == id){
+			ofRemoveURLRequest(it->second.urlRequestId);
+			images_async_loading.erase(it);
+			std::unique_lock<std::mutex> lck(mutex);
+			stats.numCancelled++;
+			return;
+		}
+	}
+
+	std::unique_lock<std::mutex> lck(mutex);
+	auto isCancelled = [id](const ofImageLoaderEntry & entry){
+		return entry.id == id;
+	};
+	auto decode = std::remove_if(images_to_decode.begin(), images_to_decode.end(), isCancelled);
+	bool found = decode != images_to_decode.end();
+	images_to_decode.erase(decode, images_to_decode.end());
+	std::make_heap(images_to_decode.begin(), images_to_decode.end());
+
+	decodedCondition.wait(lck, [&]{
+		return images_decoding.count(id) == 0;
+	});
+	auto update = std::remove_if(images_to_update.begin(), images_to_update.end(), isCancelled);
+	found |= update != images_to_update.end();
+	images_to_update.erase(update, images_to_update.end());
+	if(found){
+		stats.numCancelled++;
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll() {
+	for(auto & loading: images_async_loading){
+		ofRemoveURLRequest(loading.second.urlRequestId);
+	}
+	std::unique_lock<std::mutex> lck(mutex);
+	stats.numCancelled += images_async_loading.size() + images_to_decode.size();
+	images_async_loading.clear();
+	images_to_decode.clear();
+	decodedCondition.wait(lck, [&]{
+		return images_decoding.empty();
+	});
+	stats.numCancelled += images_to_update.size();
+	images_to_update.clear();
 }
 
 
-// Reads from the queue and loads new images.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::threadedFunction() {
-	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
-	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
+ofxThreadedImageLoader::Stats ofxThreadedImageLoader::getStats() const {
+	std::unique_lock<std::mutex> lck(mutex);
+	auto stats = this->stats;
+	stats.numDownloading = images_async_loading.size();
+	stats.numPending = images_to_decode.size();
+	stats.numDecoding = images_decoding.size();
+	stats.numPendingUploads = images_to_update.size();
+	return stats;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::stopThread() {
+	cancelAll();
+}
+
+
+// Starts another task decoding images if there are less than the
+// maximum. Needs lck locked and unlocks it before starting the task,
+// a pool without workers runs it right away and it locks the mutex.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::startDecoding(std::unique_lock<std::mutex> & lck) {
+	if(stopping || numDecodingTasks >= maxDecoding){
+		return;
+	}
+	numDecodingTasks++;
+	lck.unlock();
+	decodingTasks.run([this]{
+		decodeImages();
+	});
+}
+
+
+// Runs in the task pool. Takes the image with the highest priority and
+// decodes it, from its file or the downloaded data, until there are no
+// more images waiting.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::decodeImages() {
+	while(true){
+		ofImageLoaderEntry entry;
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			if(images_to_decode.empty()){
+				numDecodingTasks--;
+				return;
+			}
+			std::pop_heap(images_to_decode.begin(), images_to_decode.end());
+			entry = std::move(images_to_decode.back());
+			images_to_decode.pop_back();
+			images_decoding.insert(entry.id);
+		}
+
+		auto start = ofGetElapsedTimeMicros();
+		bool loaded;
+		if(entry.url.empty()){
+			loaded = entry.image->load(entry.filename);
+			if(!loaded){
+				ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			}
 		}else{
-			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			loaded = entry.image->load(entry.data);
+			entry.data.clear();
+			if(!loaded){
+				ofLogError("ofxThreadedImageLoader") << "couldn't decode url: \"" << entry.url << "\"";
+			}
 		}
+		auto decodeMillis = (ofGetElapsedTimeMicros() - start) / 1000.0;
+
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			images_decoding.erase(entry.id);
+			if(loaded){
+				numDecoded++;
+				stats.averageDecodeMillis += (decodeMillis - stats.averageDecodeMillis) / numDecoded;
+				images_to_update.push_back(std::move(entry));
+			}else{
+				stats.numFailed++;
+			}
+		}
+		decodedCondition.notify_all();
 	}
-	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
 }
 
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// When we receive an url response this method is called;
+// The loaded image is removed from the async_queue and its data is
+// queued to be decoded by the workers.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
 	// images_async_loading
-	entry_iterator it = images_async_loading.find(response.request.name);
+	entry_iterator it = images_async_loading.find(response.request.getId());
+	if(it == images_async_loading.end()) {
+		return;
+	}
 	if(response.status == 200) {
-		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
+		auto & entry = it->second;
+		entry.data = response.data;
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			images_to_decode.push_back(std::move(entry));
+			std::push_heap(images_to_decode.begin(), images_to_decode.end());
+			startDecoding(lck);
 		}
 	}else{
 		// log error.
 		ofLogError("ofxThreadedImageLoader") << "couldn't load url, response status: " << response.status;
-		ofRemoveURLRequest(response.request.getId());
+		std::unique_lock<std::mutex> lck(mutex);
+		stats.numFailed++;
 	}
 
 	// remove the entry from the queue
-	if(it != images_async_loading.end()) {
-		images_async_loading.erase(it);
-	}
+	images_async_loading.erase(it);
 }
 
 
-// Check the update queue and update the texture
+// Uploads the decoded images to their textures until this frame's
+// budget runs out
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
-	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
+	auto start = ofGetElapsedTimeMicros();
+	uint64_t bytes = 0;
+	while(true){
+		ofImageLoaderEntry entry;
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			if(images_to_update.empty()){
+				break;
+			}
+			entry = std::move(images_to_update.front());
+			images_to_update.pop_front();
+		}
 		entry.image->setUseTexture(true);
 		entry.image->update();
+		bytes += entry.image->getPixels().getTotalBytes();
+
+		auto now = ofGetElapsedTimeMicros();
+		auto latencyMillis = (now - entry.requestTime) / 1000.0;
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			stats.numLoaded++;
+			stats.averageLatencyMillis += (latencyMillis - stats.averageLatencyMillis) / stats.numLoaded;
+			stats.maxLatencyMillis = std::max(stats.maxLatencyMillis, latencyMillis);
+		}
+
+		if(settings.maxUploadBytesPerFrame > 0 && bytes >= settings.maxUploadBytesPerFrame){
+			break;
+		}
+		if(settings.maxUploadMillisPerFrame > 0 && (now - start) / 1000.0 >= settings.maxUploadMillisPerFrame){
+			break;
+		}
 	}
+	std::unique_lock<std::mutex> lck(mutex);
+	stats.lastFrameUploadBytes = bytes;
 }
-
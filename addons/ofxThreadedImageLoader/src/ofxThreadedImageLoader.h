@@ -1,35 +1,86 @@
 #pragma once
 
-#include "ofThread.h"
 #include "ofImage.h"
 #include "ofURLFileLoader.h"
-#include "ofTypes.h" 
-#include "ofThreadChannel.h"
+#include "ofTaskPool.h"
+#include "ofTypes.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
 
 
 using namespace std;
 
-class ofxThreadedImageLoader : public ofThread {
+/// \class ofxThreadedImageLoader
+/// \brief Loads images from disk or urls in background threads.
+///
+/// Images are decoded in the workers of ofGetTaskPool(), the ones with
+/// higher priority first. Their textures are uploaded from update, as many
+/// per frame as the upload budget allows.
+class ofxThreadedImageLoader {
 public:
+	struct Settings{
+		/// images decoded at the same time in the workers of the shared
+		/// task pool, 0 for as many as it has workers, at least one
+		size_t numThreads = 0;
+		/// bytes of pixels uploaded to textures every frame, 0 for no limit
+		uint64_t maxUploadBytesPerFrame = 8 * 1024 * 1024;
+		/// milliseconds spent uploading textures every frame, 0 for no
+		/// limit. one texture is always uploaded so loading never stalls
+		float maxUploadMillisPerFrame = 4;
+	};
+
+	struct Stats{
+		size_t numDownloading = 0; //< urls waiting for their response
+		size_t numPending = 0; //< images waiting for a worker
+		size_t numDecoding = 0; //< images being decoded
+		size_t numPendingUploads = 0; //< decoded images waiting for their texture
+		uint64_t numLoaded = 0;
+		uint64_t numFailed = 0;
+		uint64_t numCancelled = 0;
+		double averageDecodeMillis = 0;
+		double averageLatencyMillis = 0; //< from the load call to the texture upload
+		double maxLatencyMillis = 0;
+		uint64_t lastFrameUploadBytes = 0;
+	};
+
     ofxThreadedImageLoader();
+	ofxThreadedImageLoader(const Settings & settings);
     ~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, string file);
-	void loadFromURL(ofImage& image, string url);
+	/// \brief load an image from a file, images with higher priority are
+	/// decoded first
+	/// \return id of the load, to cancel it
+	int loadFromDisk(ofImage& image, string file, int priority = 0);
+
+	/// \brief download an image and decode it in the workers
+	/// \return id of the load, to cancel it
+	int loadFromURL(ofImage& image, string url, int priority = 0);
+
+	/// \brief stop a load that hasn't finished. if the image is being
+	/// decoded this waits for it so the image can be destroyed after
+	void cancel(int id);
+
+	/// \brief stop all the loads that haven't finished
+	void cancelAll();
 
+	Stats getStats() const;
 
+	OF_DEPRECATED_MSG("The loader doesn't have its own thread anymore, use cancelAll().", void stopThread());
 
 private:
 	void update(ofEventArgs & a);
-    virtual void threadedFunction();
+	void startDecoding(std::unique_lock<std::mutex> & lck);
+	void decodeImages();
 	void urlResponse(ofHttpResponse & response);
-    
+
     // Entry to load.
     struct ofImageLoaderEntry {
         ofImageLoaderEntry() {
             image = NULL;
         }
-        
+
         ofImageLoaderEntry(ofImage & pImage) {
             image = &pImage;
         }
@@ -37,17 +88,41 @@ private:
         string filename;
         string url;
         string name;
+		ofBuffer data; //< downloaded image waiting to be decoded
+		int id = 0;
+		int priority = 0;
+		int urlRequestId = -1;
+		uint64_t requestTime = 0;
+
+		// ordered by priority first and the order they were made after
+		bool operator<(const ofImageLoaderEntry & other) const{
+			if(priority != other.priority){
+				return priority < other.priority;
+			}
+			return id > other.id;
+		}
     };
 
 
-    typedef map<string, ofImageLoaderEntry>::iterator entry_iterator;
+    typedef map<int, ofImageLoaderEntry>::iterator entry_iterator;
 
+	Settings			settings;
 	int                 nextID;
-    int                 lastUpdate;
+	size_t				maxDecoding;
 
-	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
-};
+	// only used from the update thread
+	map<int,ofImageLoaderEntry> images_async_loading; // images loading async by url request id
 
+	// shared with the workers, protected by mutex
+	mutable std::mutex mutex;
+	vector<ofImageLoaderEntry> images_to_decode; // heap
+	set<int> images_decoding;
+	deque<ofImageLoaderEntry> images_to_update;
+	Stats stats;
+	uint64_t numDecoded = 0;
+	size_t numDecodingTasks = 0; // tasks running decodeImages in the pool
+	bool stopping = false;
+	std::condition_variable decodedCondition;
 
+	ofTaskGroup decodingTasks;
+};
@@ -37,7 +37,7 @@ void ofApp::draw(){
 
 //--------------------------------------------------------------
 void ofApp::exit(){
-	loader.stopThread();
+	loader.cancelAll();
 }
 
 //--------------------------------------------------------------
@@ -12,12 +12,14 @@
 #include "ofVboMesh.h"
 #include "ofTexture.h"
 #include "of3dUtils.h"
+#include "ofPrimitiveCache.h"
 
 using namespace std;
 
 of3dPrimitive::of3dPrimitive()
 :usingVbo(true)
 ,mesh(new ofVboMesh)
+,sharedMesh(false)
 {
     setScale(1.0, 1.0, 1.0);
 }
@@ -31,18 +33,24 @@ of3dPrimitive::~of3dPrimitive() {
 of3dPrimitive::of3dPrimitive(const of3dPrimitive & mom):ofNode(mom){
     texCoords = mom.texCoords;
     usingVbo = mom.usingVbo;
-	if(usingVbo){
-		mesh = std::make_shared<ofVboMesh>();
-	}else{
-		mesh = std::make_shared<ofMesh>();
+    sharedMesh = mom.sharedMesh;
+	if(sharedMesh){
+		mesh = mom.mesh;
+		return;
 	}
+	mesh = newMesh();
 	*mesh = *mom.mesh;
+	if(mom.ownedMesh){
+		ownedMesh = mesh;
+	}
 }
 
 //----------------------------------------------------------
 of3dPrimitive::of3dPrimitive(const ofMesh & mesh)
 :usingVbo(true)
-,mesh(new ofVboMesh(mesh)){
+,mesh(new ofVboMesh(mesh))
+,ownedMesh(this->mesh)
+,sharedMesh(false){
 
 }
 
@@ -51,8 +59,23 @@ of3dPrimitive & of3dPrimitive::operator=(const of3dPrimitive & mom){
 	if(&mom!=this){
 		(*(ofNode*)this)=mom;
 		texCoords = mom.texCoords;
-		setUseVbo(mom.usingVbo);
-		*mesh = *mom.mesh;
+		if(ownedMesh){
+			// keeps references returned by getMesh() valid
+			setUseVbo(mom.usingVbo);
+			*mesh = *mom.mesh;
+		}else if(mom.sharedMesh){
+			usingVbo = mom.usingVbo;
+			mesh = mom.mesh;
+			sharedMesh = true;
+		}else{
+			usingVbo = mom.usingVbo;
+			mesh = newMesh();
+			*mesh = *mom.mesh;
+			sharedMesh = false;
+			if(mom.ownedMesh){
+				ownedMesh = mesh;
+			}
+		}
 	}
     return *this;
 }
@@ -60,11 +83,13 @@ of3dPrimitive & of3dPrimitive::operator=(const of3dPrimitive & mom){
 // GETTERS //
 //----------------------------------------------------------
 ofMesh* of3dPrimitive::getMeshPtr() {
+    detachMesh();
     return mesh.get();
 }
 
 //----------------------------------------------------------
 ofMesh& of3dPrimitive::getMesh() {
+    detachMesh();
     return *mesh;
 }
 
@@ -147,6 +172,10 @@ void of3dPrimitive::disableColors() {
 void of3dPrimitive::mapTexCoords( float u1, float v1, float u2, float v2 ) {
 	
 	auto prevTcoord = getTexCoords();
+	if(prevTcoord == glm::vec4(u1, v1, u2, v2)){
+		// nothing to do, avoids copying a shared mesh
+		return;
+	}
     
 	for(std::size_t j = 0; j < getMesh().getNumTexCoords(); j++ ) {
 		auto tcoord = getMesh().getTexCoord(j);
@@ -265,7 +294,9 @@ void of3dPrimitive::drawAxes(float a_size)  const{
 
 //--------------------------------------------------------------
 void of3dPrimitive::setUseVbo(bool useVbo){
-	if(useVbo!=usingVbo){
+	// shared meshes are always ofVboMesh which can also be drawn
+	// as a plain ofMesh, a copy of the right type is made on detach
+	if(useVbo!=usingVbo && !sharedMesh){
 		shared_ptr<ofMesh> newMesh;
 		if(useVbo){
 			newMesh = std::make_shared<ofVboMesh>();
@@ -274,6 +305,9 @@ void of3dPrimitive::setUseVbo(bool useVbo){
 		}
 		*newMesh = *mesh;
 		mesh = newMesh;
+		if(ownedMesh){
+			ownedMesh = mesh;
+		}
 	}
 	usingVbo = useVbo;
 }
@@ -283,6 +317,44 @@ bool of3dPrimitive::isUsingVbo() const{
 	return usingVbo;
 }
 
+//--------------------------------------------------------------
+bool of3dPrimitive::isMeshShared() const{
+	return sharedMesh;
+}
+
+//--------------------------------------------------------------
+void of3dPrimitive::setSharedMesh(std::shared_ptr<const ofVboMesh> sharedVboMesh){
+	if(ownedMesh){
+		// getMesh() returned this mesh already, it's updated instead of
+		// replaced so references to it stay valid
+		*ownedMesh = *sharedVboMesh;
+		return;
+	}
+	// the mesh is never modified while shared, detachMesh() copies it
+	// before returning any non const reference
+	mesh = std::const_pointer_cast<ofVboMesh>(sharedVboMesh);
+	sharedMesh = true;
+}
+
+//--------------------------------------------------------------
+void of3dPrimitive::detachMesh(){
+	if(!ownedMesh){
+		ownedMesh = newMesh();
+		*ownedMesh = *mesh;
+		mesh = ownedMesh;
+		sharedMesh = false;
+	}
+}
+
+//--------------------------------------------------------------
+shared_ptr<ofMesh> of3dPrimitive::newMesh() const{
+	if(usingVbo){
+		return std::make_shared<ofVboMesh>();
+	}else{
+		return std::make_shared<ofMesh>();
+	}
+}
+
 // PLANE PRIMITIVE //
 //--------------------------------------------------------------
 ofPlanePrimitive::ofPlanePrimitive() {
@@ -306,7 +378,7 @@ void ofPlanePrimitive::set(float _width, float _height, int columns, int rows, o
     height = _height;
 	resolution = { columns, rows };
     
-    getMesh() = ofMesh::plane( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
+    setSharedMesh(ofPrimitiveCache::plane( getWidth(), getHeight(), getResolution().x, getResolution().y, mode ));
     
     normalizeAndApplySavedTexCoords();
     
@@ -349,14 +421,14 @@ void ofPlanePrimitive::setRows( int rows ) {
 //--------------------------------------------------------------
 void ofPlanePrimitive::setResolution( int columns, int rows ) {
 	resolution = { columns, rows };
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     
     set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
 }
 
 //--------------------------------------------------------------
 void ofPlanePrimitive::setMode(ofPrimitiveMode mode) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     
     if( mode != currMode )
         set( getWidth(), getHeight(), getResolution().x, getResolution().y, mode );
@@ -416,7 +488,7 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
     radius     = _radius;
     resolution = res;
 
-    getMesh() = ofMesh::sphere( getRadius(), getResolution(), mode );
+    setSharedMesh(ofPrimitiveCache::sphere( getRadius(), getResolution(), mode ));
     
     normalizeAndApplySavedTexCoords();
 }
@@ -424,14 +496,14 @@ void ofSpherePrimitive::set( float _radius, int res, ofPrimitiveMode mode ) {
 //----------------------------------------------------------
 void ofSpherePrimitive::setResolution( int res ) {
     resolution             = res;
-    ofPrimitiveMode mode   = getMesh().getMode();
+    ofPrimitiveMode mode   = mesh->getMode();
     
     set(getRadius(), getResolution(), mode );
 }
 
 //----------------------------------------------------------
 void ofSpherePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set(getRadius(), getResolution(), mode );
 }
@@ -484,7 +556,7 @@ void ofIcoSpherePrimitive::setResolution( int iterations ) {
     // store the number of iterations in the resolution //
     resolution = iterations;
     
-    getMesh() = ofMesh::icosphere( getRadius(), getResolution() );
+    setSharedMesh(ofPrimitiveCache::icosphere( getRadius(), getResolution() ));
     normalizeAndApplySavedTexCoords();
 }
 
@@ -568,7 +640,7 @@ void ofCylinderPrimitive::set(float _radius, float _height, int radiusSegments,
     vertices[2][1] = (getResolution().x+1) * (getResolution().z+1);
     
     
-    getMesh() = ofMesh::cylinder( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
+    setSharedMesh(ofPrimitiveCache::cylinder( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode ));
     
     normalizeAndApplySavedTexCoords();
     
@@ -616,20 +688,20 @@ void ofCylinderPrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setResolution( int radiusSegments, int heightSegments, int capSegments ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusSegments, heightSegments, capSegments, getCapped(), mode );
 }
 
 //----------------------------------------------------------
 void ofCylinderPrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, getCapped(), mode );
 }
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setTopCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setTopCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
@@ -637,7 +709,7 @@ void ofCylinderPrimitive::setTopCapColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setCylinderColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMode(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
@@ -645,7 +717,7 @@ void ofCylinderPrimitive::setCylinderColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofCylinderPrimitive::setBottomCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setBottomCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[2][0], strides[2][0]+strides[2][1], color );
@@ -658,7 +730,7 @@ vector<ofIndexType> ofCylinderPrimitive::getTopCapIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getTopCapMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getTopCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
@@ -668,7 +740,7 @@ ofMesh ofCylinderPrimitive::getTopCapMesh() const {
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getCylinderIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -676,7 +748,7 @@ vector<ofIndexType> ofCylinderPrimitive::getCylinderIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getCylinderMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "setCylinderMesh(): must be in triangle strip mode";
         return ofMesh();
     }
@@ -686,7 +758,7 @@ ofMesh ofCylinderPrimitive::getCylinderMesh() const {
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[2][0], strides[2][0] + strides[2][1] );
@@ -694,7 +766,7 @@ vector<ofIndexType> ofCylinderPrimitive::getBottomCapIndices() const {
 
 //--------------------------------------------------------------
 ofMesh ofCylinderPrimitive::getBottomCapMesh() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofCylinderPrimitive") << "getBottomCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
@@ -783,7 +855,7 @@ void ofConePrimitive::set( float _radius, float _height, int radiusSegments, int
     vertices[1][0] = vertices[0][0] + vertices[0][1];
     vertices[1][1] = (getResolution().x+1) * (getResolution().z+1);
     
-    getMesh() = ofMesh::cone( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
+    setSharedMesh(ofPrimitiveCache::cone( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode ));
     
     normalizeAndApplySavedTexCoords();
     
@@ -813,13 +885,13 @@ void ofConePrimitive::setResolutionCap( int capRes ) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setResolution( int radiusRes, int heightRes, int capRes ) {
-    ofPrimitiveMode mode = getMesh().getMode();
+    ofPrimitiveMode mode = mesh->getMode();
     set( getRadius(), getHeight(), radiusRes, heightRes, capRes, mode );
 }
 
 //----------------------------------------------------------
 void ofConePrimitive::setMode( ofPrimitiveMode mode ) {
-    ofPrimitiveMode currMode = getMesh().getMode();
+    ofPrimitiveMode currMode = mesh->getMode();
     if(currMode != mode)
         set( getRadius(), getHeight(), getResolution().x, getResolution().y, getResolution().z, mode );
 }
@@ -838,7 +910,7 @@ void ofConePrimitive::setHeight(float _height) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setTopColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setTopColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[0][0], strides[0][0]+strides[0][1], color );
@@ -846,7 +918,7 @@ void ofConePrimitive::setTopColor( ofColor color ) {
 
 //--------------------------------------------------------------
 void ofConePrimitive::setCapColor( ofColor color ) {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "setCapColor(): must be in triangle strip mode";
     }
     getMesh().setColorForIndices( strides[1][0], strides[1][0]+strides[1][1], color );
@@ -854,7 +926,7 @@ void ofConePrimitive::setCapColor( ofColor color ) {
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getConeIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices(strides[0][0], strides[0][0]+strides[0][1]);
@@ -867,7 +939,7 @@ ofMesh ofConePrimitive::getConeMesh() const {
     
     int startVertIndex  = vertices[0][0];
     int endVertIndex    = startVertIndex + vertices[0][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getConeMesh(): must be in triangle strip mode";
         return ofMesh();
     }
@@ -876,7 +948,7 @@ ofMesh ofConePrimitive::getConeMesh() const {
 
 //--------------------------------------------------------------
 vector<ofIndexType> ofConePrimitive::getCapIndices() const {
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapIndices(): must be in triangle strip mode";
     }
     return of3dPrimitive::getIndices( strides[1][0], strides[1][0] + strides[1][1] );
@@ -889,7 +961,7 @@ ofMesh ofConePrimitive::getCapMesh() const {
     
     int startVertIndex  = vertices[1][0];
     int endVertIndex    = startVertIndex + vertices[1][1];
-    if(getMesh().getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
+    if(mesh->getMode() != OF_PRIMITIVE_TRIANGLE_STRIP) {
         ofLogWarning("ofConePrimitive") << "getCapMesh(): must be in triangle strip mode";
         return ofMesh();
     }
@@ -995,7 +1067,7 @@ void ofBoxPrimitive::set( float width, float height, float depth, int resWidth,
     vertices[SIDE_BOTTOM][0] = vertices[SIDE_TOP][0] + vertices[SIDE_TOP][1];
     vertices[SIDE_BOTTOM][1] = (resY+1) * (resZ+1);
     
-    getMesh() = ofMesh::box( getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z );
+    setSharedMesh(ofPrimitiveCache::box( getWidth(), getHeight(), getDepth(), getResolution().x, getResolution().y, getResolution().z ));
     
     normalizeAndApplySavedTexCoords();
 }
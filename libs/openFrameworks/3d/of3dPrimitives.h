@@ -60,14 +60,30 @@ public:
 
     void setUseVbo(bool useVbo);
     bool isUsingVbo() const;
+
+    /// \brief Returns true if the mesh is shared with other primitives
+    /// through ofPrimitiveCache. Calling the non const getMesh() or
+    /// getMeshPtr() makes a copy of the mesh for this primitive, which
+    /// stays valid, unless setUseVbo() changes its type, and is updated
+    /// when the parameters change. References returned by the const
+    /// versions while the mesh is shared point to the cached mesh, and
+    /// shouldn't be kept after changing the parameters.
+    bool isMeshShared() const;
 protected:
 
+    // uses a mesh from ofPrimitiveCache, it's only copied once modified
+    void setSharedMesh(std::shared_ptr<const ofVboMesh> mesh);
+    void detachMesh();
+    std::shared_ptr<ofMesh> newMesh() const;
+
     // useful when creating a new model, since it uses normalized tex coords //
     void normalizeAndApplySavedTexCoords();
 
 	glm::vec4 texCoords;
     bool usingVbo;
     std::shared_ptr<ofMesh>  mesh;
+    std::shared_ptr<ofMesh>  ownedMesh; // set once getMesh() returned a non const mesh, kept when the parameters change
+    bool sharedMesh;
     mutable ofMesh normalsMesh;
 
     std::vector<ofIndexType> getIndices( int startIndex, int endIndex ) const;
@@ -5,10 +5,17 @@
 
 #include "ofConstants.h"
 #include "ofGLUtils.h"
+#include <iterator>
 
 template<class V, class N, class C, class T>
 class ofMeshFace_;
 
+template<class V, class N, class C, class T>
+class ofMeshFaceView_;
+
+template<class V, class N, class C, class T>
+class ofMeshFaceViews_;
+
 /// \brief Represents a set of vertices in 3D spaces with normals, colors,
 /// and texture coordinates at those points.
 ///
@@ -312,6 +319,17 @@ public:
         /// \brief Duplicates vertices and updates normals to get a low-poly look.
         void flatNormals();
 
+	/// \brief Converts the mesh into a non indexed one where every triangle
+	/// has its own 3 vertices.
+	///
+	/// All the attributes are copied into arrays allocated once and
+	/// filled from several threads, so it's fast even for meshes with
+	/// millions of triangles. Only works with OF_PRIMITIVE_TRIANGLES.
+	///
+	/// \param bUseFaceNormals if true, the normals are replaced by the
+	/// normal of each face which gives the mesh a faceted look.
+	void flatten(bool bUseFaceNormals = false);
+
 	/// \}
 	/// \name Faces
 	/// \{
@@ -328,8 +346,32 @@ public:
 
 	/// \returns the mesh as a vector of unique ofMeshFace_s
 	/// a list of triangles that do not share vertices or indices
+	///
+	/// This copies every attribute of every face, to iterate over the
+	/// triangles of big meshes prefer getFaceViews().
 	const std::vector<ofMeshFace_<V,N,C,T>> & getUniqueFaces() const;
 
+	/// \returns the number of triangles in the mesh, indexed or not,
+	/// or 0 if the mode is not OF_PRIMITIVE_TRIANGLES.
+	std::size_t getNumFaces() const;
+
+	/// \returns a lightweight reference to a triangle of the mesh, its
+	/// attributes are read from the mesh when accessed.
+	ofMeshFaceView_<V,N,C,T> getFaceView(std::size_t faceId) const;
+
+	/// \brief Allows to iterate over the triangles of the mesh without
+	/// copying them.
+	///
+	/// ~~~~{.cpp}
+	/// for(auto face: mesh.getFaceViews()){
+	///     auto normal = face.getFaceNormal();
+	///     auto center = (face.getVertex(0) + face.getVertex(1) + face.getVertex(2)) / 3.f;
+	/// }
+	/// ~~~~
+	///
+	/// The views are invalidated if the mesh is modified.
+	ofMeshFaceViews_<V,N,C,T> getFaceViews() const;
+
 	/// \}
 	/// \name Colors
 	/// \{
@@ -586,8 +628,20 @@ public:
 	/// \brief Loads a mesh from a file located at the provided path into the mesh.
 	/// This will replace any existing data within the mesh.
 	///
-	/// It expects that the file will be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
-	/// It will only load meshes saved in the PLY ASCII format; the binary format is not supported.
+	/// The format is chosen from the file extension:
+	///
+	/// - `.obj`: [Wavefront OBJ](https://en.wikipedia.org/wiki/Wavefront_.obj_file)
+	///   positions, normals, texture coordinates and faces. Polygons are
+	///   triangulated and vertices sharing the same position, normal and
+	///   texture coordinate are merged into one indexed vertex. Materials,
+	///   groups and other elements are ignored.
+	/// - `.stl`: binary or ASCII [STL](https://en.wikipedia.org/wiki/STL_(file_format))
+	///   loaded as non indexed triangles with flat normals.
+	/// - anything else is expected to be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
+	///   It will only load meshes saved in the PLY ASCII format; the binary format is not supported.
+	///
+	/// OBJ and STL files are parsed using several threads so big files
+	/// load much faster than through ofxAssimpModelLoader.
     void load(const std::filesystem::path& path);
 
 	///  \brief Saves the mesh at the passed path in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
@@ -702,9 +756,100 @@ private:
 	T texCoords[3];
 };
 
+/// \brief A reference to a triangle in an ofMesh_ as returned by
+/// ofMesh_::getFaceView() and ofMesh_::getFaceViews().
+///
+/// Unlike ofMeshFace_ it doesn't copy the attributes of the triangle, it
+/// only stores the mesh and the index of the face so it's cheap to create
+/// and pass around. It's only valid while the mesh isn't modified.
+template<class V, class N, class C, class T>
+class ofMeshFaceView_ {
+public:
+	ofMeshFaceView_(const ofMesh_<V,N,C,T> & mesh, std::size_t faceId);
+
+	/// \returns the index of the face in the mesh.
+	std::size_t getId() const;
+
+	/// \returns the index in the mesh of one of the 3 vertices of the face.
+	ofIndexType getIndex(std::size_t corner) const;
+
+	const V & getVertex(std::size_t corner) const;
+	const N & getNormal(std::size_t corner) const;
+	const C & getColor(std::size_t corner) const;
+	const T & getTexCoord(std::size_t corner) const;
+
+	bool hasNormals() const;
+	bool hasColors() const;
+	bool hasTexcoords() const;
+
+	/// \returns the normal of the triangle, calculated every time
+	/// it's called.
+	N getFaceNormal() const;
+
+	/// \returns a copy of the face as an ofMeshFace_.
+	ofMeshFace_<V,N,C,T> getFace() const;
+
+private:
+	const ofMesh_<V,N,C,T> * mesh;
+	std::size_t faceId;
+};
+
+/// \brief Range of all the faces of a mesh, see ofMesh_::getFaceViews()
+template<class V, class N, class C, class T>
+class ofMeshFaceViews_ {
+public:
+	class const_iterator{
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef ofMeshFaceView_<V,N,C,T> value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const ofMeshFaceView_<V,N,C,T> * pointer;
+		typedef ofMeshFaceView_<V,N,C,T> reference;
+
+		const_iterator(const ofMesh_<V,N,C,T> & mesh, std::size_t faceId)
+		:mesh(&mesh)
+		,faceId(faceId){}
+
+		ofMeshFaceView_<V,N,C,T> operator*() const{ return ofMeshFaceView_<V,N,C,T>(*mesh, faceId); }
+		ofMeshFaceView_<V,N,C,T> operator[](difference_type n) const{ return ofMeshFaceView_<V,N,C,T>(*mesh, faceId + n); }
+		const_iterator & operator++(){ ++faceId; return *this; }
+		const_iterator operator++(int){ auto it = *this; ++faceId; return it; }
+		const_iterator & operator--(){ --faceId; return *this; }
+		const_iterator operator--(int){ auto it = *this; --faceId; return it; }
+		const_iterator & operator+=(difference_type n){ faceId += n; return *this; }
+		const_iterator & operator-=(difference_type n){ faceId -= n; return *this; }
+		const_iterator operator+(difference_type n) const{ return const_iterator(*mesh, faceId + n); }
+		const_iterator operator-(difference_type n) const{ return const_iterator(*mesh, faceId - n); }
+		difference_type operator-(const const_iterator & other) const{ return difference_type(faceId) - difference_type(other.faceId); }
+		bool operator==(const const_iterator & other) const{ return faceId == other.faceId; }
+		bool operator!=(const const_iterator & other) const{ return faceId != other.faceId; }
+		bool operator<(const const_iterator & other) const{ return faceId < other.faceId; }
+		bool operator>(const const_iterator & other) const{ return faceId > other.faceId; }
+		bool operator<=(const const_iterator & other) const{ return faceId <= other.faceId; }
+		bool operator>=(const const_iterator & other) const{ return faceId >= other.faceId; }
+
+	private:
+		const ofMesh_<V,N,C,T> * mesh;
+		std::size_t faceId;
+	};
+
+	ofMeshFaceViews_(const ofMesh_<V,N,C,T> & mesh)
+	:mesh(&mesh){}
+
+	const_iterator begin() const{ return const_iterator(*mesh, 0); }
+	const_iterator end() const{ return const_iterator(*mesh, size()); }
+	std::size_t size() const{ return mesh->getNumFaces(); }
+	bool empty() const{ return size() == 0; }
+	ofMeshFaceView_<V,N,C,T> operator[](std::size_t faceId) const{ return ofMeshFaceView_<V,N,C,T>(*mesh, faceId); }
+
+private:
+	const ofMesh_<V,N,C,T> * mesh;
+};
+
 #include "ofMesh.inl"
 
 using ofMesh = ofMesh_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
 using ofMeshFace = ofMeshFace_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
+using ofMeshFaceView = ofMeshFaceView_<ofDefaultVertexType, ofDefaultNormalType, ofDefaultColorType, ofDefaultTexCoordType>;
 
 #endif
@@ -7,8 +7,26 @@
 #include "ofVectorMath.h"
 #include "ofMath.h"
 #include "ofLog.h"
+#include "ofUtils.h"
+#include "ofMeshLoaders.h"
+#include "ofParallel.h"
+#include <algorithm>
 #include <map>
 
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// calls f(begin, end) for consecutive ranges of [0, size) in the
+	// shared task pool, small sizes are processed in the calling thread
+	template<class F>
+	void parallelForMeshRange(std::size_t size, F f){
+		const std::size_t minRangeSize = 1 << 16;
+		ofParallelForRange(0, size, minRangeSize, f);
+	}
+}
+}
+/*! \endcond */
+
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 ofMesh_<V,N,C,T>::ofMesh_(){
@@ -1030,12 +1048,40 @@ void ofMesh_<V,N,C,T>::append(const ofMesh_<V,N,C,T> & mesh){
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::load(const std::filesystem::path& path){
-	ofFile is(path, ofFile::ReadOnly);
+	auto extension = ofToLower(ofFilePath::getFileExt(path));
+	if(extension == "obj" || extension == "stl"){
+		// const so reading the data doesn't copy the mapping
+		const ofBuffer buffer = ofBufferFromMappedFile(path, OF_BUFFER_ACCESS_SEQUENTIAL);
+		if(buffer.size() == 0){
+			ofLogError("ofMesh") << "load(): couldn't load \"" << path << "\", file is empty or doesn't exist";
+			return;
+		}
+		of::priv::ofMeshLoaderData loaded;
+		std::string error;
+		bool ok;
+		if(extension == "obj"){
+			ok = of::priv::loadOBJ(buffer.getData(), buffer.size(), loaded, error);
+		}else{
+			ok = of::priv::loadSTL(buffer.getData(), buffer.size(), loaded, error);
+		}
+		if(!ok){
+			ofLogError("ofMesh") << "load(): couldn't load \"" << path << "\": " << error;
+			return;
+		}
+		clear();
+		setMode(OF_PRIMITIVE_TRIANGLES);
+		of::priv::assignMeshAttribute(getVertices(), std::move(loaded.vertices));
+		of::priv::assignMeshAttribute(getNormals(), std::move(loaded.normals));
+		of::priv::assignMeshAttribute(getTexCoords(), std::move(loaded.texCoords));
+		getIndices() = std::move(loaded.indices);
+		return;
+	}
+
 	auto & data = *this;
 
 
 	std::string error;
-	ofBuffer buffer(is);
+	ofBuffer buffer = ofBufferFromMappedFile(path, OF_BUFFER_ACCESS_SEQUENTIAL);
 	auto backup = data;
 
 	int orderVertices=-1;
@@ -1556,9 +1602,8 @@ void ofMesh_<V,N,C,T>::mergeDuplicateVertices() {
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 ofMeshFace_<V,N,C,T> ofMesh_<V,N,C,T>::getFace(ofIndexType faceId) const{
-	const std::vector<ofMeshFace_<V,N,C,T>> & faces = getUniqueFaces();
-	if(faces.size()>faceId){
-		return faces[faceId];
+	if(faceId < getNumFaces()){
+		return getFaceView(faceId).getFace();
 	}else{
 		ofLogError() << "couldn't find face " << faceId;
 		return ofMeshFace_<V,N,C,T>();
@@ -1572,32 +1617,15 @@ const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() con
 	if(bFacesDirty){
 		// if we are doing triangles, we have to use a vert and normal for each triangle
 		// that way we can calculate face normals and use getFaceNormal();
-		faces.resize( indices.size()/3 );
-
-		int index	   = 0;
-		int triindex	= 0;
-
-		bool bHasColors	 = hasColors();
-		bool bHasNormals	= hasNormals();
-		bool bHasTexcoords  = hasTexCoords();
-
 		if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-			for(std::size_t j = 0; j < indices.size(); j += 3) {
-				ofMeshFace_<V,N,C,T> & tri = faces[triindex];
-				for(std::size_t k = 0; k < 3; k++) {
-					index = indices[j+k];
-					tri.setVertex( k, vertices[index] );
-					if(bHasNormals)
-						tri.setNormal(k, normals[index] );
-					if(bHasTexcoords)
-						tri.setTexCoord(k, texCoords[index] );
-					if(bHasColors)
-						tri.setColor(k, colors[index] );
+			faces.resize(getNumFaces());
+			of::priv::parallelForMeshRange(faces.size(), [&](std::size_t begin, std::size_t end){
+				for(std::size_t i = begin; i < end; i++){
+					faces[i] = getFaceView(i).getFace();
 				}
-				triindex++;
-			}
-
+			});
 		} else {
+			faces.clear();
 			ofLogWarning("ofMesh") << "getUniqueFaces(): only works with primitive mode OF_PRIMITIVE_TRIANGLES";
 		}
 
@@ -1609,6 +1637,34 @@ const std::vector<ofMeshFace_<V,N,C,T>> & ofMesh_<V,N,C,T>::getUniqueFaces() con
 }
 
 
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+std::size_t ofMesh_<V,N,C,T>::getNumFaces() const{
+	if(getMode() != OF_PRIMITIVE_TRIANGLES){
+		return 0;
+	}
+	if(hasIndices()){
+		return indices.size() / 3;
+	}else{
+		return vertices.size() / 3;
+	}
+}
+
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+ofMeshFaceView_<V,N,C,T> ofMesh_<V,N,C,T>::getFaceView(std::size_t faceId) const{
+	return ofMeshFaceView_<V,N,C,T>(*this, faceId);
+}
+
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+ofMeshFaceViews_<V,N,C,T> ofMesh_<V,N,C,T>::getFaceViews() const{
+	return ofMeshFaceViews_<V,N,C,T>(*this);
+}
+
+
 //--------------------------------------------------------------
 template<class V, class N, class C, class T>
 std::vector<N> ofMesh_<V,N,C,T>::getFaceNormals( bool perVertex ) const{
@@ -1652,42 +1708,33 @@ void ofMesh_<V,N,C,T>::setFromTriangles( const std::vector<ofMeshFace_<V,N,C,T>>
 		return;
 	}
 
-	typename std::vector<ofMeshFace_<V,N,C,T>>::const_iterator it;
-
-	vertices.resize(tris.size()*3 );
-	it = tris.begin();
 	// if the first tri has data, assume the rest do as well //
-	if(it->hasNormals()){
-		normals.resize(tris.size()*3);
-	}else{
-		normals.clear();
-	}
-	if(it->hasColors()){
-		colors.resize(tris.size()*3);
-	}else{
-		colors.clear();
-	}
-	if(it->hasTexcoords()){
-		texCoords.resize(tris.size()*3);
-	}else{
-		texCoords.clear();
-	}
-
-	int i = 0;
-	for(it = tris.begin(); it != tris.end(); it++) {
-		for(std::size_t k = 0; k < 3; k++) {
-			vertices[i] = it->getVertex(k);
-			if(it->hasTexcoords())
-				texCoords[i] = it->getTexCoord(k);
-			if(it->hasColors())
-				colors[i] = it->getColor(k);
-			if(bUseFaceNormal)
-				normals[i] = it->getFaceNormal();
-			else if(it->hasNormals())
-				normals[i] = it->getNormal(k);
-			i++;
+	bool bHasNormals = tris.front().hasNormals() || bUseFaceNormal;
+	bool bHasColors = tris.front().hasColors();
+	bool bHasTexcoords = tris.front().hasTexcoords();
+
+	vertices.resize(tris.size()*3);
+	normals.resize(bHasNormals ? tris.size()*3 : 0);
+	colors.resize(bHasColors ? tris.size()*3 : 0);
+	texCoords.resize(bHasTexcoords ? tris.size()*3 : 0);
+
+	of::priv::parallelForMeshRange(tris.size(), [&](std::size_t begin, std::size_t end){
+		for(std::size_t j = begin; j < end; j++) {
+			auto & tri = tris[j];
+			for(std::size_t k = 0; k < 3; k++) {
+				auto i = j * 3 + k;
+				vertices[i] = tri.getVertex(k);
+				if(bHasTexcoords)
+					texCoords[i] = tri.getTexCoord(k);
+				if(bHasColors)
+					colors[i] = tri.getColor(k);
+				if(bUseFaceNormal)
+					normals[i] = tri.getFaceNormal();
+				else if(bHasNormals)
+					normals[i] = tri.getNormal(k);
+			}
 		}
-	}
+	});
 
 	setupIndicesAuto();
 	bVertsChanged = true;
@@ -1706,11 +1753,19 @@ template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 
 	if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-		std::vector<ofMeshFace_<V,N,C,T>> triangles = getUniqueFaces();
+		// read the faces through views instead of copying them, only the
+		// face normals are precalculated
+		auto numFaces = getNumFaces();
+		if(numFaces == 0) {
+			return;
+		}
+		std::vector<N> faceNormals(numFaces);
 		std::vector<V> verts;
-		for(ofIndexType i = 0; i < triangles.size(); i++) {
+		verts.reserve(numFaces * 3);
+		for(auto face: getFaceViews()) {
+			faceNormals[face.getId()] = face.getFaceNormal();
 			for(ofIndexType j = 0; j < 3; j++) {
-				verts.push_back( triangles[i].getVertex(j) );
+				verts.push_back( face.getVertex(j) );
 			}
 		}
 
@@ -1735,7 +1790,7 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 		// string of vertex in 3d space to triangle index //
 		std::map<std::string, std::vector<int> > vertHash;
 
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
+		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << numFaces;
 
 		std::string xStr, yStr, zStr;
 
@@ -1745,11 +1800,12 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 			zStr = "z"+ofToString(verts[i].z==-0?0:verts[i].z);
 			std::string vstring = xStr+yStr+zStr;
 			if(vertHash.find(vstring) == vertHash.end()) {
-				for(ofIndexType j = 0; j < triangles.size(); j++) {
+				for(ofIndexType j = 0; j < numFaces; j++) {
+					auto face = getFaceView(j);
 					for(ofIndexType k = 0; k < 3; k++) {
-						if(verts[i].x == triangles[j].getVertex(k).x) {
-							if(verts[i].y == triangles[j].getVertex(k).y) {
-								if(verts[i].z == triangles[j].getVertex(k).z) {
+						if(verts[i].x == face.getVertex(k).x) {
+							if(verts[i].y == face.getVertex(k).y) {
+								if(verts[i].z == face.getVertex(k).z) {
 									vertHash[vstring].push_back( j );
 								}
 							}
@@ -1764,14 +1820,25 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 //			ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
 //		}
 
+		// corners that aren't found keep their current normal
+		std::vector<N> newNormals(numFaces * 3);
+		if(hasNormals()) {
+			for(auto face: getFaceViews()) {
+				for(ofIndexType k = 0; k < 3; k++) {
+					newNormals[face.getId() * 3 + k] = face.getNormal(k);
+				}
+			}
+		}
+
 		V vert;
 		N normal;
 		float angleCos = cos(angle * DEG_TO_RAD );
 		float numNormals=0;
 
-		for(ofIndexType j = 0; j < triangles.size(); j++) {
+		for(ofIndexType j = 0; j < numFaces; j++) {
+			auto face = getFaceView(j);
 			for(ofIndexType k = 0; k < 3; k++) {
-				vert = triangles[j].getVertex(k);
+				vert = face.getVertex(k);
 				xStr = "x"+ofToString(vert.x==-0?0:vert.x);
 				yStr = "y"+ofToString(vert.y==-0?0:vert.y);
 				zStr = "z"+ofToString(vert.z==-0?0:vert.z);
@@ -1781,8 +1848,8 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 				normal = {0.f,0.f,0.f};
 				if(vertHash.find(vstring) != vertHash.end()) {
 					for(ofIndexType i = 0; i < vertHash[vstring].size(); i++) {
-						auto f1 = triangles[j].getFaceNormal();
-						auto f2 = triangles[vertHash[vstring][i]].getFaceNormal();
+						auto f1 = faceNormals[j];
+						auto f2 = faceNormals[vertHash[vstring][i]];
 						if(glm::dot(toGlm(f1), toGlm(f2)) >= angleCos ) {
 							normal += f2;
 							numNormals+=1.f;
@@ -1791,13 +1858,15 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 					//normal /= (float)vertHash[vstring].size();
 					normal /= numNormals;
 
-					triangles[j].setNormal(k, normal);
+					newNormals[j * 3 + k] = normal;
 				}
 			}
 		}
 
-		//ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
-		setFromTriangles( triangles );
+		// duplicate the vertices of every face with their new normals
+		flatten(false);
+		normals = std::move(newNormals);
+		setupIndicesAuto();
 
 	}
 }
@@ -1806,47 +1875,76 @@ void ofMesh_<V,N,C,T>::smoothNormals( float angle ) {
 template<class V, class N, class C, class T>
 void ofMesh_<V,N,C,T>::flatNormals() {
     if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-        
-        // get copy original mesh data
-        auto numIndices = getIndices().size();
-        auto verts = getVertices();
-        auto texCoords = getTexCoords();
-        auto colors = getColors();
-        
-        // remove all data to start from scratch
-        clear();
-        
-        // add mesh data back, duplicating vertices and recalculating normals
-        N normal;
-        for(ofIndexType i = 0; i < numIndices; i++) {
-            ofIndexType indexCurr = getIndex(i);
-    
-            if(i % 3 == 0) {
-                ofIndexType indexNext1 = getIndex(i + 1);
-                ofIndexType indexNext2 = getIndex(i + 2);
-                auto e1 = verts[indexCurr] - verts[indexNext1];
-                auto e2 = verts[indexNext2] - verts[indexNext1];
-                normal = glm::normalize(glm::cross(e1, e2));
-            }
-    
-            addIndex(i);
-            addNormal(normal);
-    
-            if(indexCurr < texCoords.size()) {
-                addTexCoord(texCoords[indexCurr]);
-            }
-    
-            if(indexCurr < verts.size()) {
-                addVertex(verts[indexCurr]);
-            }
-    
-            if(indexCurr < colors.size()) {
-                addColor(colors[indexCurr]);
-            }
+        // duplicate the vertices of every face and use the face normal.
+        // flatNormals has always generated them opposite to
+        // getFaceNormal(), keep that so the lighting of existing meshes
+        // doesn't flip
+        flatten(true);
+        for(auto & normal: normals){
+            normal = -normal;
         }
+        setupIndicesAuto();
     }
 }
 
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+void ofMesh_<V,N,C,T>::flatten(bool bUseFaceNormals) {
+	if(getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogWarning("ofMesh") << "flatten(): only works with primitive mode OF_PRIMITIVE_TRIANGLES";
+		return;
+	}
+
+	auto numFaces = getNumFaces();
+	bool bHasNormals = hasNormals() || bUseFaceNormals;
+	bool bHasColors = hasColors();
+	bool bHasTexcoords = hasTexCoords();
+
+	std::vector<V> newVertices(numFaces * 3);
+	std::vector<N> newNormals(bHasNormals ? numFaces * 3 : 0);
+	std::vector<C> newColors(bHasColors ? numFaces * 3 : 0);
+	std::vector<T> newTexCoords(bHasTexcoords ? numFaces * 3 : 0);
+
+	of::priv::parallelForMeshRange(numFaces, [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			ofMeshFaceView_<V,N,C,T> face(*this, i);
+			N faceNormal;
+			if(bUseFaceNormals){
+				faceNormal = face.getFaceNormal();
+			}
+			for(std::size_t k = 0; k < 3; k++){
+				auto dst = i * 3 + k;
+				auto src = face.getIndex(k);
+				newVertices[dst] = vertices[src];
+				if(bUseFaceNormals){
+					newNormals[dst] = faceNormal;
+				}else if(bHasNormals){
+					newNormals[dst] = normals[src];
+				}
+				if(bHasColors){
+					newColors[dst] = colors[src];
+				}
+				if(bHasTexcoords){
+					newTexCoords[dst] = texCoords[src];
+				}
+			}
+		}
+	});
+
+	vertices = std::move(newVertices);
+	normals = std::move(newNormals);
+	colors = std::move(newColors);
+	texCoords = std::move(newTexCoords);
+	indices.clear();
+
+	bVertsChanged = true;
+	bNormalsChanged = true;
+	bColorsChanged = true;
+	bTexCoordsChanged = true;
+	bIndicesChanged = true;
+	bFacesDirty = true;
+}
+
 // PLANE MESH //
 
 
@@ -2996,3 +3094,103 @@ template<class V, class N, class C, class T>
 bool ofMeshFace_<V,N,C,T>::hasTexcoords() const{
 	return bHasTexcoords;
 }
+
+
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+ofMeshFaceView_<V,N,C,T>::ofMeshFaceView_(const ofMesh_<V,N,C,T> & mesh, std::size_t faceId)
+:mesh(&mesh)
+,faceId(faceId){
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+std::size_t ofMeshFaceView_<V,N,C,T>::getId() const{
+	return faceId;
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+ofIndexType ofMeshFaceView_<V,N,C,T>::getIndex(std::size_t corner) const{
+	if(mesh->hasIndices()){
+		return mesh->getIndices()[faceId * 3 + corner];
+	}else{
+		return ofIndexType(faceId * 3 + corner);
+	}
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+const V & ofMeshFaceView_<V,N,C,T>::getVertex(std::size_t corner) const{
+	return mesh->getVertices()[getIndex(corner)];
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+const N & ofMeshFaceView_<V,N,C,T>::getNormal(std::size_t corner) const{
+	return mesh->getNormals()[getIndex(corner)];
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+const C & ofMeshFaceView_<V,N,C,T>::getColor(std::size_t corner) const{
+	return mesh->getColors()[getIndex(corner)];
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+const T & ofMeshFaceView_<V,N,C,T>::getTexCoord(std::size_t corner) const{
+	return mesh->getTexCoords()[getIndex(corner)];
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+bool ofMeshFaceView_<V,N,C,T>::hasNormals() const{
+	return mesh->hasNormals();
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+bool ofMeshFaceView_<V,N,C,T>::hasColors() const{
+	return mesh->hasColors();
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+bool ofMeshFaceView_<V,N,C,T>::hasTexcoords() const{
+	return mesh->hasTexCoords();
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+N ofMeshFaceView_<V,N,C,T>::getFaceNormal() const{
+	glm::vec3 u, v;
+
+	u = toGlm(getVertex(1)-getVertex(0));
+	v = toGlm(getVertex(2)-getVertex(0));
+
+	N faceNormal;
+	faceNormal = glm::normalize(glm::cross(u, v));
+	return faceNormal;
+}
+
+//--------------------------------------------------------------
+template<class V, class N, class C, class T>
+ofMeshFace_<V,N,C,T> ofMeshFaceView_<V,N,C,T>::getFace() const{
+	ofMeshFace_<V,N,C,T> face;
+	bool bHasNormals = hasNormals();
+	bool bHasColors = hasColors();
+	bool bHasTexcoords = hasTexcoords();
+	for(std::size_t k = 0; k < 3; k++){
+		auto index = getIndex(k);
+		face.setVertex(k, mesh->getVertices()[index]);
+		if(bHasNormals)
+			face.setNormal(k, mesh->getNormals()[index]);
+		if(bHasTexcoords)
+			face.setTexCoord(k, mesh->getTexCoords()[index]);
+		if(bHasColors)
+			face.setColor(k, mesh->getColors()[index]);
+	}
+	return face;
+}
@@ -0,0 +1,661 @@
+#include "ofMeshBVH.h"
+#include "ofCamera.h"
+#include "ofRectangle.h"
+#include "glm/geometric.hpp"
+#include "glm/common.hpp"
+#include "ofTaskPool.h"
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace{
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	inline float surfaceArea(const glm::vec3 & min, const glm::vec3 & max){
+		auto d = max - min;
+		return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+	}
+
+	// zero components are replaced by a tiny one of the same sign, otherwise
+	// a ray starting on the plane of a box side computes 0 * inf = NaN and
+	// misses the box
+	inline glm::vec3 inverseDirection(const glm::vec3 & direction){
+		const float epsilon = 1e-20f;
+		glm::vec3 inv;
+		for(int i = 0; i < 3; i++){
+			float d = direction[i];
+			if(std::abs(d) < epsilon){
+				d = std::copysign(epsilon, d);
+			}
+			inv[i] = 1.f / d;
+		}
+		return inv;
+	}
+
+	inline bool intersectBox(const glm::vec3 & min, const glm::vec3 & max,
+							 const glm::vec3 & origin, const glm::vec3 & invDirection,
+							 float maxDistance, float & distance){
+		auto t0 = (min - origin) * invDirection;
+		auto t1 = (max - origin) * invDirection;
+		auto tmin = glm::min(t0, t1);
+		auto tmax = glm::max(t0, t1);
+		float tnear = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.f));
+		float tfar = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, maxDistance));
+		distance = tnear;
+		return tnear <= tfar;
+	}
+
+	// Möller–Trumbore, double sided
+	inline bool intersectTriangle(const glm::vec3 & v0, const glm::vec3 & v1, const glm::vec3 & v2,
+								  const glm::vec3 & origin, const glm::vec3 & direction,
+								  float maxDistance, float & distance, glm::vec2 & barycentric){
+		auto e1 = v1 - v0;
+		auto e2 = v2 - v0;
+		auto p = glm::cross(direction, e2);
+		float det = glm::dot(e1, p);
+		if(det == 0.f){
+			return false;
+		}
+		float invDet = 1.f / det;
+		auto s = origin - v0;
+		float u = glm::dot(s, p) * invDet;
+		if(u < 0.f || u > 1.f){
+			return false;
+		}
+		auto q = glm::cross(s, e1);
+		float v = glm::dot(direction, q) * invDet;
+		if(v < 0.f || u + v > 1.f){
+			return false;
+		}
+		float t = glm::dot(e2, q) * invDet;
+		if(t < 0.f || t > maxDistance){
+			return false;
+		}
+		distance = t;
+		barycentric = {u, v};
+		return true;
+	}
+
+	// Real-Time Collision Detection, Christer Ericson, 5.1.5
+	glm::vec3 closestPointOnTriangle(const glm::vec3 & p, const glm::vec3 & a, const glm::vec3 & b, const glm::vec3 & c){
+		auto ab = b - a;
+		auto ac = c - a;
+		auto ap = p - a;
+		float d1 = glm::dot(ab, ap);
+		float d2 = glm::dot(ac, ap);
+		if(d1 <= 0.f && d2 <= 0.f) return a;
+
+		auto bp = p - b;
+		float d3 = glm::dot(ab, bp);
+		float d4 = glm::dot(ac, bp);
+		if(d3 >= 0.f && d4 <= d3) return b;
+
+		float vc = d1 * d4 - d3 * d2;
+		if(vc <= 0.f && d1 >= 0.f && d3 <= 0.f){
+			float v = d1 / (d1 - d3);
+			return a + v * ab;
+		}
+
+		auto cp = p - c;
+		float d5 = glm::dot(ab, cp);
+		float d6 = glm::dot(ac, cp);
+		if(d6 >= 0.f && d5 <= d6) return c;
+
+		float vb = d5 * d2 - d1 * d6;
+		if(vb <= 0.f && d2 >= 0.f && d6 <= 0.f){
+			float w = d2 / (d2 - d6);
+			return a + w * ac;
+		}
+
+		float va = d3 * d6 - d5 * d4;
+		if(va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f){
+			float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return b + w * (c - b);
+		}
+
+		float denom = 1.f / (va + vb + vc);
+		float v = vb * denom;
+		float w = vc * denom;
+		return a + ab * v + ac * w;
+	}
+
+	inline float distanceSquaredToBox(const glm::vec3 & p, const glm::vec3 & min, const glm::vec3 & max){
+		auto d = glm::max(glm::max(min - p, glm::vec3(0.f)), p - max);
+		return glm::dot(d, d);
+	}
+
+	inline bool boxesOverlap(const glm::vec3 & min1, const glm::vec3 & max1, const glm::vec3 & min2, const glm::vec3 & max2){
+		return min1.x <= max2.x && max1.x >= min2.x &&
+			   min1.y <= max2.y && max1.y >= min2.y &&
+			   min1.z <= max2.z && max1.z >= min2.z;
+	}
+
+	// separating axis test between a triangle and a box centered at the origin
+	bool triangleOverlapsBox(const glm::vec3 & halfSize, const glm::vec3 & v0, const glm::vec3 & v1, const glm::vec3 & v2){
+		auto separated = [&](const glm::vec3 & axis){
+			float p0 = glm::dot(v0, axis);
+			float p1 = glm::dot(v1, axis);
+			float p2 = glm::dot(v2, axis);
+			float r = glm::dot(halfSize, glm::abs(axis));
+			return std::min(std::min(p0, p1), p2) > r || std::max(std::max(p0, p1), p2) < -r;
+		};
+
+		const glm::vec3 edges[] = {v1 - v0, v2 - v1, v0 - v2};
+		const glm::vec3 boxAxes[] = {{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}};
+		for(auto & boxAxis: boxAxes){
+			if(separated(boxAxis)){
+				return false;
+			}
+			for(auto & edge: edges){
+				if(separated(glm::cross(boxAxis, edge))){
+					return false;
+				}
+			}
+		}
+		return !separated(glm::cross(edges[0], edges[1]));
+	}
+}
+
+//--------------------------------------------------------------
+struct ofMeshBVH::Builder{
+	struct Bin{
+		glm::vec3 min{infinity};
+		glm::vec3 max{-infinity};
+		uint32_t count = 0;
+
+		void grow(const glm::vec3 & otherMin, const glm::vec3 & otherMax){
+			min = glm::min(min, otherMin);
+			max = glm::max(max, otherMax);
+		}
+	};
+
+	Builder(ofMeshBVH & bvh, const Settings & settings)
+	:bvh(bvh)
+	,maxLeafTriangles(std::max<std::size_t>(settings.maxLeafTriangles, 1))
+	,numBins(std::min<std::size_t>(std::max<std::size_t>(settings.numBins, 2), 256)){
+		auto numThreads = settings.numThreads;
+		if(numThreads == 0){
+			// the workers of the shared pool and the calling thread
+			numThreads = ofGetTaskPool().getNumThreads() + 1;
+		}
+		parallelDepth = 0;
+		while((std::size_t(1) << parallelDepth) < numThreads){
+			parallelDepth++;
+		}
+	}
+
+	void build(){
+		auto numTriangles = bvh.triangleIds.size();
+		triangleMin.resize(numTriangles);
+		triangleMax.resize(numTriangles);
+		centroids.resize(numTriangles);
+		for(std::size_t i = 0; i < numTriangles; i++){
+			auto tri = bvh.getTriangle(i);
+			triangleMin[i] = glm::min(glm::min(tri[0], tri[1]), tri[2]);
+			triangleMax[i] = glm::max(glm::max(tri[0], tri[1]), tri[2]);
+			centroids[i] = (triangleMin[i] + triangleMax[i]) * 0.5f;
+		}
+
+		// a binary tree with at least one triangle per leaf can't have
+		// more than 2n-1 nodes
+		bvh.nodes.resize(numTriangles * 2 - 1);
+		nodeCount = 1;
+		buildNode(0, 0, numTriangles, 0);
+		bvh.nodes.resize(nodeCount);
+		bvh.nodes.shrink_to_fit();
+	}
+
+	void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, std::size_t depth){
+		auto & node = bvh.nodes[nodeIndex];
+		glm::vec3 centroidMin{infinity};
+		glm::vec3 centroidMax{-infinity};
+		node.min = glm::vec3(infinity);
+		node.max = glm::vec3(-infinity);
+		for(auto i = first; i < first + count; i++){
+			auto triangle = bvh.triangleIds[i];
+			node.min = glm::min(node.min, triangleMin[triangle]);
+			node.max = glm::max(node.max, triangleMax[triangle]);
+			centroidMin = glm::min(centroidMin, centroids[triangle]);
+			centroidMax = glm::max(centroidMax, centroids[triangle]);
+		}
+
+		if(count <= 1){
+			makeLeaf(node, first, count);
+			return;
+		}
+
+		// evaluate the SAH for every bin boundary in the 3 axes
+		int bestAxis = -1;
+		std::size_t bestSplit = 0;
+		float bestCost = infinity;
+		std::vector<Bin> bins(numBins);
+		std::vector<float> rightCost(numBins);
+		for(int axis = 0; axis < 3; axis++){
+			float extent = centroidMax[axis] - centroidMin[axis];
+			if(extent <= 0.f){
+				continue;
+			}
+			std::fill(bins.begin(), bins.end(), Bin());
+			float scale = numBins / extent;
+			for(auto i = first; i < first + count; i++){
+				auto triangle = bvh.triangleIds[i];
+				auto & bin = bins[binIndex(centroids[triangle][axis], centroidMin[axis], scale)];
+				bin.grow(triangleMin[triangle], triangleMax[triangle]);
+				bin.count++;
+			}
+
+			Bin right;
+			for(std::size_t i = numBins - 1; i > 0; i--){
+				right.grow(bins[i].min, bins[i].max);
+				right.count += bins[i].count;
+				rightCost[i] = right.count ? right.count * surfaceArea(right.min, right.max) : 0.f;
+			}
+
+			Bin left;
+			for(std::size_t i = 0; i < numBins - 1; i++){
+				left.grow(bins[i].min, bins[i].max);
+				left.count += bins[i].count;
+				if(left.count == 0 || left.count == count){
+					continue;
+				}
+				float cost = left.count * surfaceArea(left.min, left.max) + rightCost[i + 1];
+				if(cost < bestCost){
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = i + 1;
+				}
+			}
+		}
+
+		// traversing a node costs about as much as intersecting a triangle
+		float leafCost = count;
+		float nodeArea = surfaceArea(node.min, node.max);
+		float splitCost = nodeArea > 0.f ? 1.f + bestCost / nodeArea : infinity;
+		if(count <= maxLeafTriangles && (bestAxis == -1 || leafCost <= splitCost)){
+			makeLeaf(node, first, count);
+			return;
+		}
+
+		auto begin = bvh.triangleIds.begin() + first;
+		auto end = begin + count;
+		auto middle = begin + count / 2;
+		if(bestAxis != -1){
+			float scale = numBins / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+			float min = centroidMin[bestAxis];
+			middle = std::partition(begin, end, [&](uint32_t triangle){
+				return binIndex(centroids[triangle][bestAxis], min, scale) < bestSplit;
+			});
+		}
+		if(middle == begin || middle == end){
+			// all the centroids are in the same spot, split by count
+			middle = begin + count / 2;
+		}
+		uint32_t leftCount = uint32_t(middle - begin);
+
+		uint32_t children = nodeCount.fetch_add(2);
+		node.first = children;
+		node.count = 0;
+
+		if(depth < parallelDepth && count > parallelThreshold){
+			auto leftTask = ofGetTaskPool().submit([=]{
+				buildNode(children, first, leftCount, depth + 1);
+			});
+			buildNode(children + 1, first + leftCount, count - leftCount, depth + 1);
+			leftTask.get();
+		}else{
+			buildNode(children, first, leftCount, depth + 1);
+			buildNode(children + 1, first + leftCount, count - leftCount, depth + 1);
+		}
+	}
+
+	std::size_t binIndex(float centroid, float min, float scale) const{
+		auto bin = std::size_t(std::max(0.f, (centroid - min) * scale));
+		return std::min(bin, numBins - 1);
+	}
+
+	void makeLeaf(Node & node, uint32_t first, uint32_t count){
+		node.first = first;
+		node.count = count;
+	}
+
+	ofMeshBVH & bvh;
+	std::size_t maxLeafTriangles;
+	std::size_t numBins;
+	std::size_t parallelDepth;
+	const uint32_t parallelThreshold = 4096;
+	std::atomic<uint32_t> nodeCount;
+	std::vector<glm::vec3> triangleMin;
+	std::vector<glm::vec3> triangleMax;
+	std::vector<glm::vec3> centroids;
+};
+
+//--------------------------------------------------------------
+ofMeshBVH::ofMeshBVH(){
+}
+
+//--------------------------------------------------------------
+void ofMeshBVH::build(std::vector<glm::vec3> positions, std::vector<ofIndexType> indices, const Settings & settings){
+	clear();
+	this->positions = std::move(positions);
+	this->indices = std::move(indices);
+	build(settings);
+}
+
+//--------------------------------------------------------------
+void ofMeshBVH::build(const Settings & settings){
+	auto numIndices = indices.empty() ? positions.size() : indices.size();
+	if(numIndices % 3 != 0){
+		ofLogWarning("ofMeshBVH") << "build(): number of indices is not a multiple of 3, ignoring the last "
+								  << numIndices % 3;
+	}
+	for(auto index: indices){
+		if(index >= positions.size()){
+			ofLogError("ofMeshBVH") << "build(): index " << index << " out of range, mesh has "
+									<< positions.size() << " vertices";
+			clear();
+			return;
+		}
+	}
+
+	auto numTriangles = numIndices / 3;
+	if(numTriangles == 0){
+		return;
+	}
+	triangleIds.resize(numTriangles);
+	for(std::size_t i = 0; i < numTriangles; i++){
+		triangleIds[i] = uint32_t(i);
+	}
+	Builder(*this, settings).build();
+}
+
+//--------------------------------------------------------------
+void ofMeshBVH::refit(const std::vector<glm::vec3> & positions){
+	if(positions.size() != this->positions.size()){
+		ofLogError("ofMeshBVH") << "refit(): number of vertices changed from " << this->positions.size()
+								<< " to " << positions.size() << ", the tree needs to be rebuilt";
+		return;
+	}
+	this->positions = positions;
+	refit();
+}
+
+//--------------------------------------------------------------
+void ofMeshBVH::refit(){
+	// children are always allocated after their parents so traversing
+	// the nodes backwards updates the tree bottom up
+	for(auto node = nodes.rbegin(); node != nodes.rend(); ++node){
+		if(node->count > 0){
+			node->min = glm::vec3(infinity);
+			node->max = glm::vec3(-infinity);
+			for(auto i = node->first; i < node->first + node->count; i++){
+				for(auto & v: getTriangle(triangleIds[i])){
+					node->min = glm::min(node->min, v);
+					node->max = glm::max(node->max, v);
+				}
+			}
+		}else{
+			auto & left = nodes[node->first];
+			auto & right = nodes[node->first + 1];
+			node->min = glm::min(left.min, right.min);
+			node->max = glm::max(left.max, right.max);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ofMeshBVH::clear(){
+	nodes.clear();
+	positions.clear();
+	indices.clear();
+	triangleIds.clear();
+}
+
+//--------------------------------------------------------------
+bool ofMeshBVH::empty() const{
+	return nodes.empty();
+}
+
+//--------------------------------------------------------------
+std::size_t ofMeshBVH::getNumTriangles() const{
+	return triangleIds.size();
+}
+
+//--------------------------------------------------------------
+std::size_t ofMeshBVH::getNumNodes() const{
+	return nodes.size();
+}
+
+//--------------------------------------------------------------
+std::array<glm::vec3,3> ofMeshBVH::getTriangle(std::size_t triangle) const{
+	auto i = triangle * 3;
+	if(indices.empty()){
+		return {{positions[i], positions[i + 1], positions[i + 2]}};
+	}else{
+		return {{positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]]}};
+	}
+}
+
+//--------------------------------------------------------------
+ofMeshBVH::RayHit ofMeshBVH::intersectRay(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance) const{
+	RayHit hit;
+	if(nodes.empty()){
+		return hit;
+	}
+
+	auto invDirection = inverseDirection(direction);
+	float closest = maxDistance;
+	float distance;
+	glm::vec2 barycentric;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	if(intersectBox(nodes[0].min, nodes[0].max, origin, invDirection, closest, distance)){
+		stack.push_back(0);
+	}
+	while(!stack.empty()){
+		auto & node = nodes[stack.back()];
+		stack.pop_back();
+		if(node.count > 0){
+			for(auto i = node.first; i < node.first + node.count; i++){
+				auto triangle = getTriangle(triangleIds[i]);
+				if(intersectTriangle(triangle[0], triangle[1], triangle[2], origin, direction, closest, distance, barycentric)){
+					closest = distance;
+					hit.hit = true;
+					hit.distance = distance;
+					hit.triangle = triangleIds[i];
+					hit.barycentric = barycentric;
+				}
+			}
+		}else{
+			float leftDistance, rightDistance;
+			auto left = node.first;
+			auto right = node.first + 1;
+			bool hitLeft = intersectBox(nodes[left].min, nodes[left].max, origin, invDirection, closest, leftDistance);
+			bool hitRight = intersectBox(nodes[right].min, nodes[right].max, origin, invDirection, closest, rightDistance);
+			// push the furthest child first so the closest one is visited first
+			if(hitLeft && hitRight){
+				if(leftDistance < rightDistance){
+					stack.push_back(right);
+					stack.push_back(left);
+				}else{
+					stack.push_back(left);
+					stack.push_back(right);
+				}
+			}else if(hitLeft){
+				stack.push_back(left);
+			}else if(hitRight){
+				stack.push_back(right);
+			}
+		}
+	}
+
+	if(hit.hit){
+		hit.position = origin + direction * hit.distance;
+	}
+	return hit;
+}
+
+//--------------------------------------------------------------
+bool ofMeshBVH::intersectsRay(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance) const{
+	if(nodes.empty()){
+		return false;
+	}
+
+	auto invDirection = inverseDirection(direction);
+	float distance;
+	glm::vec2 barycentric;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		auto & node = nodes[stack.back()];
+		stack.pop_back();
+		if(!intersectBox(node.min, node.max, origin, invDirection, maxDistance, distance)){
+			continue;
+		}
+		if(node.count > 0){
+			for(auto i = node.first; i < node.first + node.count; i++){
+				auto triangle = getTriangle(triangleIds[i]);
+				if(intersectTriangle(triangle[0], triangle[1], triangle[2], origin, direction, maxDistance, distance, barycentric)){
+					return true;
+				}
+			}
+		}else{
+			stack.push_back(node.first + 1);
+			stack.push_back(node.first);
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+ofMeshBVH::RayHit ofMeshBVH::pick(const ofCamera & camera, const glm::vec2 & screenPoint) const{
+	auto nearPoint = camera.screenToWorld(glm::vec3(screenPoint, -1.f));
+	auto farPoint = camera.screenToWorld(glm::vec3(screenPoint, 1.f));
+	auto length = glm::length(farPoint - nearPoint);
+	return intersectRay(nearPoint, (farPoint - nearPoint) / length, length);
+}
+
+//--------------------------------------------------------------
+ofMeshBVH::RayHit ofMeshBVH::pick(const ofCamera & camera, const glm::vec2 & screenPoint, const ofRectangle & viewport) const{
+	auto nearPoint = camera.screenToWorld(glm::vec3(screenPoint, -1.f), viewport);
+	auto farPoint = camera.screenToWorld(glm::vec3(screenPoint, 1.f), viewport);
+	auto length = glm::length(farPoint - nearPoint);
+	return intersectRay(nearPoint, (farPoint - nearPoint) / length, length);
+}
+
+//--------------------------------------------------------------
+ofMeshBVH::ClosestPoint ofMeshBVH::getClosestPoint(const glm::vec3 & point, float maxDistance) const{
+	ClosestPoint closest;
+	if(nodes.empty()){
+		return closest;
+	}
+
+	float bestDistance2 = maxDistance < std::sqrt(std::numeric_limits<float>::max()) ? maxDistance * maxDistance : infinity;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		auto & node = nodes[stack.back()];
+		stack.pop_back();
+		if(distanceSquaredToBox(point, node.min, node.max) > bestDistance2){
+			continue;
+		}
+		if(node.count > 0){
+			for(auto i = node.first; i < node.first + node.count; i++){
+				auto triangle = getTriangle(triangleIds[i]);
+				auto p = closestPointOnTriangle(point, triangle[0], triangle[1], triangle[2]);
+				auto d = p - point;
+				float distance2 = glm::dot(d, d);
+				if(distance2 <= bestDistance2){
+					bestDistance2 = distance2;
+					closest.found = true;
+					closest.triangle = triangleIds[i];
+					closest.position = p;
+				}
+			}
+		}else{
+			auto left = node.first;
+			auto right = node.first + 1;
+			if(distanceSquaredToBox(point, nodes[left].min, nodes[left].max) < distanceSquaredToBox(point, nodes[right].min, nodes[right].max)){
+				stack.push_back(right);
+				stack.push_back(left);
+			}else{
+				stack.push_back(left);
+				stack.push_back(right);
+			}
+		}
+	}
+
+	if(closest.found){
+		closest.distance = std::sqrt(bestDistance2);
+	}
+	return closest;
+}
+
+//--------------------------------------------------------------
+std::vector<std::size_t> ofMeshBVH::getTrianglesInBox(const glm::vec3 & min, const glm::vec3 & max) const{
+	std::vector<std::size_t> triangles;
+	if(nodes.empty()){
+		return triangles;
+	}
+
+	auto center = (min + max) * 0.5f;
+	auto halfSize = (max - min) * 0.5f;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		auto & node = nodes[stack.back()];
+		stack.pop_back();
+		if(!boxesOverlap(node.min, node.max, min, max)){
+			continue;
+		}
+		if(node.count > 0){
+			for(auto i = node.first; i < node.first + node.count; i++){
+				auto triangle = getTriangle(triangleIds[i]);
+				if(triangleOverlapsBox(halfSize, triangle[0] - center, triangle[1] - center, triangle[2] - center)){
+					triangles.push_back(triangleIds[i]);
+				}
+			}
+		}else{
+			stack.push_back(node.first + 1);
+			stack.push_back(node.first);
+		}
+	}
+	return triangles;
+}
+
+//--------------------------------------------------------------
+std::vector<std::size_t> ofMeshBVH::getTrianglesInSphere(const glm::vec3 & center, float radius) const{
+	std::vector<std::size_t> triangles;
+	if(nodes.empty()){
+		return triangles;
+	}
+
+	float radius2 = radius * radius;
+	std::vector<uint32_t> stack;
+	stack.reserve(64);
+	stack.push_back(0);
+	while(!stack.empty()){
+		auto & node = nodes[stack.back()];
+		stack.pop_back();
+		if(distanceSquaredToBox(center, node.min, node.max) > radius2){
+			continue;
+		}
+		if(node.count > 0){
+			for(auto i = node.first; i < node.first + node.count; i++){
+				auto triangle = getTriangle(triangleIds[i]);
+				auto d = closestPointOnTriangle(center, triangle[0], triangle[1], triangle[2]) - center;
+				if(glm::dot(d, d) <= radius2){
+					triangles.push_back(triangleIds[i]);
+				}
+			}
+		}else{
+			stack.push_back(node.first + 1);
+			stack.push_back(node.first);
+		}
+	}
+	return triangles;
+}
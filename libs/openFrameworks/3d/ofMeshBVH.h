@@ -0,0 +1,197 @@
+#pragma once
+
+#include "ofMesh.h"
+#include "ofLog.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include <array>
+#include <limits>
+
+class ofCamera;
+class ofRectangle;
+
+struct ofMeshBVHSettings{
+	/// Triangles per leaf below which a node is never split.
+	std::size_t maxLeafTriangles = 4;
+	/// Number of bins used to evaluate the SAH per axis.
+	std::size_t numBins = 16;
+	/// Number of threads used to build the tree, 0 uses all cores.
+	std::size_t numThreads = 0;
+};
+
+/// \brief A bounding volume hierarchy over the triangles of an ofMesh.
+///
+/// ofMeshBVH accelerates ray casts, closest point and overlap queries
+/// against a triangle mesh. Instead of testing every face returned by
+/// ofMesh::getUniqueFaces() each query only visits the triangles whose
+/// bounding boxes are close to the query, which makes picking on meshes
+/// with millions of triangles interactive.
+///
+/// The tree is built with a binned surface area heuristic and the upper
+/// levels of the tree are built in parallel. Only meshes using
+/// OF_PRIMITIVE_TRIANGLES are supported, indexed or not.
+///
+/// ~~~~{.cpp}
+/// ofMeshBVH bvh(mesh);
+/// auto hit = bvh.pick(cam, {ofGetMouseX(), ofGetMouseY()});
+/// if(hit){
+///     ofDrawSphere(hit.position, 2);
+/// }
+/// ~~~~
+///
+/// When the vertices of the mesh are animated but the triangles stay the
+/// same, call refit() instead of rebuilding the whole tree.
+class ofMeshBVH{
+public:
+	using Settings = ofMeshBVHSettings;
+
+	/// \brief Result of a ray cast, evaluates to true if something was hit.
+	struct RayHit{
+		bool hit = false;
+		/// Distance along the ray direction to the hit point.
+		float distance = std::numeric_limits<float>::max();
+		/// Index of the triangle in the mesh, its vertices are the ones
+		/// referenced by indices 3*triangle to 3*triangle+2.
+		std::size_t triangle = 0;
+		/// Barycentric coordinates of the hit for vertices 1 and 2.
+		glm::vec2 barycentric;
+		glm::vec3 position;
+
+		explicit operator bool() const{
+			return hit;
+		}
+	};
+
+	/// \brief Result of a closest point query, evaluates to true if a
+	/// triangle was found within the search distance.
+	struct ClosestPoint{
+		bool found = false;
+		float distance = std::numeric_limits<float>::max();
+		std::size_t triangle = 0;
+		glm::vec3 position;
+
+		explicit operator bool() const{
+			return found;
+		}
+	};
+
+	ofMeshBVH();
+
+	template<class V, class N, class C, class T>
+	ofMeshBVH(const ofMesh_<V,N,C,T> & mesh, const Settings & settings = Settings());
+
+	/// \brief Builds the tree from the vertices and indices of a mesh.
+	template<class V, class N, class C, class T>
+	void build(const ofMesh_<V,N,C,T> & mesh, const Settings & settings = Settings());
+
+	/// \brief Builds the tree from a list of positions and triangle indices,
+	/// if indices is empty every 3 consecutive positions form a triangle.
+	void build(std::vector<glm::vec3> positions, std::vector<ofIndexType> indices, const Settings & settings = Settings());
+
+	/// \brief Updates the bounds of the tree after the vertices of the
+	/// mesh have moved. The number of vertices and the indices have to be
+	/// the same as when the tree was built.
+	template<class V, class N, class C, class T>
+	void refit(const ofMesh_<V,N,C,T> & mesh);
+	void refit(const std::vector<glm::vec3> & positions);
+
+	void clear();
+	bool empty() const;
+
+	std::size_t getNumTriangles() const;
+	std::size_t getNumNodes() const;
+
+	/// \brief Finds the first triangle hit by a ray.
+	/// \param origin Origin of the ray.
+	/// \param direction Direction of the ray, doesn't need to be normalized
+	/// but distances are measured in units of its length.
+	/// \param maxDistance Hits further than this are ignored.
+	RayHit intersectRay(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	/// \brief Returns true as soon as any triangle is hit by the ray,
+	/// faster than intersectRay() for occlusion tests.
+	bool intersectsRay(const glm::vec3 & origin, const glm::vec3 & direction, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	/// \brief Casts a ray through a point on the screen as seen from a camera.
+	///
+	/// The ray goes from the near to the far plane, as returned by
+	/// ofCamera::screenToWorld(), so the mesh has to be in world
+	/// coordinates.
+	RayHit pick(const ofCamera & camera, const glm::vec2 & screenPoint) const;
+	RayHit pick(const ofCamera & camera, const glm::vec2 & screenPoint, const ofRectangle & viewport) const;
+
+	/// \brief Finds the closest point on the surface of the mesh.
+	/// \param maxDistance Triangles further than this are ignored.
+	ClosestPoint getClosestPoint(const glm::vec3 & point, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	/// \returns the indices of all the triangles overlapping an axis aligned box.
+	std::vector<std::size_t> getTrianglesInBox(const glm::vec3 & min, const glm::vec3 & max) const;
+
+	/// \returns the indices of all the triangles overlapping a sphere.
+	std::vector<std::size_t> getTrianglesInSphere(const glm::vec3 & center, float radius) const;
+
+	/// \returns the 3 vertices of a triangle as used by the tree.
+	std::array<glm::vec3,3> getTriangle(std::size_t triangle) const;
+
+private:
+	struct Node{
+		glm::vec3 min;
+		glm::vec3 max;
+		// for inner nodes the index of the first child, the second
+		// is always next to it. for leaves the first triangle in
+		// triangleIds
+		uint32_t first;
+		// number of triangles, 0 for inner nodes
+		uint32_t count;
+	};
+
+	struct Builder;
+
+	void build(const Settings & settings);
+	void refit();
+	template<class V>
+	void copyPositions(const std::vector<V> & vertices);
+
+	std::vector<Node> nodes;
+	std::vector<glm::vec3> positions;
+	std::vector<ofIndexType> indices;
+	std::vector<uint32_t> triangleIds;
+};
+
+template<class V, class N, class C, class T>
+ofMeshBVH::ofMeshBVH(const ofMesh_<V,N,C,T> & mesh, const Settings & settings){
+	build(mesh, settings);
+}
+
+template<class V>
+void ofMeshBVH::copyPositions(const std::vector<V> & vertices){
+	positions.resize(vertices.size());
+	for(std::size_t i = 0; i < vertices.size(); i++){
+		positions[i] = glm::vec3(vertices[i].x, vertices[i].y, vertices[i].z);
+	}
+}
+
+template<class V, class N, class C, class T>
+void ofMeshBVH::build(const ofMesh_<V,N,C,T> & mesh, const Settings & settings){
+	clear();
+	if(mesh.getMode() != OF_PRIMITIVE_TRIANGLES){
+		ofLogError("ofMeshBVH") << "build(): only meshes with mode OF_PRIMITIVE_TRIANGLES are supported";
+		return;
+	}
+	copyPositions(mesh.getVertices());
+	if(mesh.hasIndices()){
+		indices = mesh.getIndices();
+	}
+	build(settings);
+}
+
+template<class V, class N, class C, class T>
+void ofMeshBVH::refit(const ofMesh_<V,N,C,T> & mesh){
+	if(mesh.getNumVertices() != positions.size()){
+		ofLogError("ofMeshBVH") << "refit(): number of vertices changed from " << positions.size()
+								<< " to " << mesh.getNumVertices() << ", the tree needs to be rebuilt";
+		return;
+	}
+	copyPositions(mesh.getVertices());
+	refit();
+}
@@ -0,0 +1,692 @@
+#include "ofMeshLoaders.h"
+#include "ofParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+using namespace std;
+
+namespace{
+	// files smaller than this per thread are parsed in one thread
+	const std::size_t minChunkSize = 1 << 20;
+
+	struct Chunk{
+		const char * begin;
+		const char * end;
+	};
+
+	// splits the data in one chunk per thread, chunks always end at the
+	// end of a line
+	std::vector<Chunk> splitLines(const char * data, std::size_t size){
+		std::size_t numThreads = ofGetTaskPool().getNumThreads() + 1;
+		std::size_t numChunks = std::max<std::size_t>(1, std::min(numThreads, size / minChunkSize));
+		std::vector<Chunk> chunks;
+		const char * end = data + size;
+		const char * begin = data;
+		for(std::size_t i = 1; i <= numChunks && begin < end; i++){
+			const char * chunkEnd = std::max(begin, data + size * i / numChunks);
+			chunkEnd = std::find(chunkEnd, end, '\n');
+			if(chunkEnd != end){
+				++chunkEnd;
+			}
+			chunks.push_back({begin, chunkEnd});
+			begin = chunkEnd;
+		}
+		return chunks;
+	}
+
+	// runs f(i) for every chunk in the shared task pool
+	template<class F>
+	void forEachChunk(std::size_t numChunks, F f){
+		ofParallelFor(0, numChunks, 1, f);
+	}
+
+	inline bool isSpace(char c){
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline bool isDigit(char c){
+		return c >= '0' && c <= '9';
+	}
+
+	inline const char * skipSpaces(const char * p, const char * end){
+		while(p < end && isSpace(*p)){
+			++p;
+		}
+		return p;
+	}
+
+	inline const char * findLineEnd(const char * p, const char * end){
+		auto lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+		return lineEnd ? lineEnd : end;
+	}
+
+	inline bool startsWith(const char * p, const char * end, const char * word){
+		auto len = strlen(word);
+		return std::size_t(end - p) >= len && strncmp(p, word, len) == 0;
+	}
+
+	std::string lineString(const char * begin, const char * end){
+		while(end > begin && isSpace(end[-1])){
+			--end;
+		}
+		return std::string(begin, end);
+	}
+
+	// fallback for values the fast parser doesn't understand like nan or inf
+	const char * parseFloatSlow(const char * p, const char * end, float & value){
+		char token[64];
+		std::size_t len = 0;
+		while(p + len < end && len < sizeof(token) - 1 && !isSpace(p[len]) && p[len] != '\n' && p[len] != '/'){
+			token[len] = p[len];
+			len++;
+		}
+		token[len] = 0;
+		char * tokenEnd;
+		value = strtof(token, &tokenEnd);
+		if(tokenEnd == token){
+			return nullptr;
+		}
+		return p + (tokenEnd - token);
+	}
+
+	// parses a float in decimal or scientific notation. much faster than
+	// strtof or streams and doesn't depend on the current locale, the
+	// result is exact to float precision for the values found in mesh
+	// files. returns nullptr if no number was found.
+	const char * parseFloat(const char * p, const char * end, float & value){
+		static const double powersOf10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+		};
+
+		p = skipSpaces(p, end);
+		const char * start = p;
+		bool negative = false;
+		if(p < end && (*p == '-' || *p == '+')){
+			negative = *p == '-';
+			++p;
+		}
+
+		uint64_t mantissa = 0;
+		int exponent = 0;
+		int numDigits = 0;
+		while(p < end && isDigit(*p)){
+			if(mantissa < 100000000000000000ull){
+				mantissa = mantissa * 10 + (*p - '0');
+			}else{
+				exponent++;
+			}
+			++p;
+			++numDigits;
+		}
+		if(p < end && *p == '.'){
+			++p;
+			while(p < end && isDigit(*p)){
+				if(mantissa < 100000000000000000ull){
+					mantissa = mantissa * 10 + (*p - '0');
+					exponent--;
+				}
+				++p;
+				++numDigits;
+			}
+		}
+		if(numDigits == 0){
+			return parseFloatSlow(start, end, value);
+		}
+
+		if(p < end && (*p == 'e' || *p == 'E')){
+			++p;
+			bool negativeExponent = false;
+			if(p < end && (*p == '-' || *p == '+')){
+				negativeExponent = *p == '-';
+				++p;
+			}
+			if(p == end || !isDigit(*p)){
+				return nullptr;
+			}
+			int e = 0;
+			while(p < end && isDigit(*p)){
+				if(e < 10000){
+					e = e * 10 + (*p - '0');
+				}
+				++p;
+			}
+			exponent += negativeExponent ? -e : e;
+		}
+
+		double v = double(mantissa);
+		if(exponent < 0){
+			v = exponent >= -22 ? v / powersOf10[-exponent] : v * std::pow(10., exponent);
+		}else if(exponent > 0){
+			v = exponent <= 22 ? v * powersOf10[exponent] : v * std::pow(10., exponent);
+		}
+		value = float(negative ? -v : v);
+		return p;
+	}
+
+	const char * parseInt(const char * p, const char * end, int64_t & value){
+		bool negative = false;
+		if(p < end && (*p == '-' || *p == '+')){
+			negative = *p == '-';
+			++p;
+		}
+		if(p == end || !isDigit(*p)){
+			return nullptr;
+		}
+		int64_t v = 0;
+		while(p < end && isDigit(*p)){
+			if(v < (int64_t(1) << 40)){
+				v = v * 10 + (*p - '0');
+			}
+			++p;
+		}
+		value = negative ? -v : v;
+		return p;
+	}
+
+	template<std::size_t N>
+	const char * parseFloats(const char * p, const char * end, float (&values)[N]){
+		for(std::size_t i = 0; i < N && p; i++){
+			p = parseFloat(p, end, values[i]);
+		}
+		return p;
+	}
+
+	//--------------------------------------------------------------
+	// OBJ
+	enum ObjLineType{
+		OBJ_OTHER,
+		OBJ_VERTEX,
+		OBJ_TEXCOORD,
+		OBJ_NORMAL,
+		OBJ_FACE,
+	};
+
+	// advances p past the keyword of the line
+	ObjLineType objLineType(const char *& p, const char * end){
+		if(end - p < 2){
+			return OBJ_OTHER;
+		}
+		if(p[0] == 'v'){
+			if(isSpace(p[1])){
+				p += 1;
+				return OBJ_VERTEX;
+			}
+			if(end - p > 2 && isSpace(p[2])){
+				if(p[1] == 't'){
+					p += 2;
+					return OBJ_TEXCOORD;
+				}
+				if(p[1] == 'n'){
+					p += 2;
+					return OBJ_NORMAL;
+				}
+			}
+		}else if(p[0] == 'f' && isSpace(p[1])){
+			p += 1;
+			return OBJ_FACE;
+		}
+		return OBJ_OTHER;
+	}
+
+	struct ObjCounts{
+		std::size_t vertices = 0;
+		std::size_t texCoords = 0;
+		std::size_t normals = 0;
+		std::size_t triangles = 0;
+	};
+
+	const uint32_t noIndex = std::numeric_limits<uint32_t>::max();
+
+	struct ObjCorner{
+		uint32_t vertex;
+		uint32_t texCoord;
+		uint32_t normal;
+
+		bool operator==(const ObjCorner & other) const{
+			return vertex == other.vertex && texCoord == other.texCoord && normal == other.normal;
+		}
+	};
+
+	struct ObjCornerHash{
+		std::size_t operator()(const ObjCorner & c) const{
+			uint64_t h = c.vertex;
+			h = h * 0x9E3779B97F4A7C15ull ^ c.texCoord;
+			h = h * 0x9E3779B97F4A7C15ull ^ c.normal;
+			return std::size_t(h ^ (h >> 29));
+		}
+	};
+
+	struct ObjChunkResult{
+		ObjCounts counts;
+		ObjCounts offsets;
+		bool hasTexCoords = false;
+		bool hasNormals = false;
+		std::string error;
+	};
+
+	ObjCounts countObj(const Chunk & chunk){
+		ObjCounts counts;
+		for(const char * line = chunk.begin; line < chunk.end;){
+			const char * lineEnd = findLineEnd(line, chunk.end);
+			const char * p = skipSpaces(line, lineEnd);
+			switch(objLineType(p, lineEnd)){
+				case OBJ_VERTEX:
+					counts.vertices++;
+					break;
+				case OBJ_TEXCOORD:
+					counts.texCoords++;
+					break;
+				case OBJ_NORMAL:
+					counts.normals++;
+					break;
+				case OBJ_FACE:{
+					std::size_t numCorners = 0;
+					while(true){
+						p = skipSpaces(p, lineEnd);
+						if(p == lineEnd){
+							break;
+						}
+						numCorners++;
+						while(p < lineEnd && !isSpace(*p)){
+							++p;
+						}
+					}
+					if(numCorners > 2){
+						counts.triangles += numCorners - 2;
+					}
+					break;
+				}
+				default:
+					break;
+			}
+			line = lineEnd + 1;
+		}
+		return counts;
+	}
+
+	// resolves a 1 based or negative relative index into a 0 based one
+	bool resolveObjIndex(int64_t index, std::size_t numDefined, std::size_t total, uint32_t & resolved){
+		if(index < 0){
+			index += numDefined;
+		}else{
+			index -= 1;
+		}
+		if(index < 0 || std::size_t(index) >= total){
+			return false;
+		}
+		resolved = uint32_t(index);
+		return true;
+	}
+
+	void parseObj(const Chunk & chunk, ObjChunkResult & result, const ObjCounts & totals,
+				  std::vector<glm::vec3> & positions, std::vector<glm::vec3> & normals,
+				  std::vector<glm::vec2> & texCoords, std::vector<ObjCorner> & corners){
+		auto v = result.offsets.vertices;
+		auto t = result.offsets.texCoords;
+		auto n = result.offsets.normals;
+		auto c = result.offsets.triangles * 3;
+		std::vector<ObjCorner> face;
+		for(const char * line = chunk.begin; line < chunk.end;){
+			const char * lineEnd = findLineEnd(line, chunk.end);
+			const char * p = skipSpaces(line, lineEnd);
+			const char * error = nullptr;
+			switch(objLineType(p, lineEnd)){
+				case OBJ_VERTEX:{
+					float xyz[3];
+					if(!parseFloats(p, lineEnd, xyz)){
+						error = "wrong vertex";
+					}else{
+						positions[v++] = {xyz[0], xyz[1], xyz[2]};
+					}
+					break;
+				}
+				case OBJ_TEXCOORD:{
+					// v is optional and w is ignored
+					float uv[2] = {0, 0};
+					p = parseFloat(p, lineEnd, uv[0]);
+					if(!p){
+						error = "wrong texture coordinate";
+					}else{
+						if(skipSpaces(p, lineEnd) != lineEnd && !parseFloat(p, lineEnd, uv[1])){
+							error = "wrong texture coordinate";
+						}
+						texCoords[t++] = {uv[0], uv[1]};
+					}
+					break;
+				}
+				case OBJ_NORMAL:{
+					float xyz[3];
+					if(!parseFloats(p, lineEnd, xyz)){
+						error = "wrong normal";
+					}else{
+						normals[n++] = {xyz[0], xyz[1], xyz[2]};
+					}
+					break;
+				}
+				case OBJ_FACE:{
+					face.clear();
+					while(!error){
+						p = skipSpaces(p, lineEnd);
+						if(p == lineEnd){
+							break;
+						}
+						ObjCorner corner{noIndex, noIndex, noIndex};
+						int64_t index;
+						p = parseInt(p, lineEnd, index);
+						if(!p || !resolveObjIndex(index, v, totals.vertices, corner.vertex)){
+							error = "wrong vertex index in face";
+							break;
+						}
+						if(p < lineEnd && *p == '/'){
+							++p;
+							if(p < lineEnd && *p != '/'){
+								p = parseInt(p, lineEnd, index);
+								if(!p || !resolveObjIndex(index, t, totals.texCoords, corner.texCoord)){
+									error = "wrong texture coordinate index in face";
+									break;
+								}
+								result.hasTexCoords = true;
+							}
+							if(p < lineEnd && *p == '/'){
+								++p;
+								p = parseInt(p, lineEnd, index);
+								if(!p || !resolveObjIndex(index, n, totals.normals, corner.normal)){
+									error = "wrong normal index in face";
+									break;
+								}
+								result.hasNormals = true;
+							}
+						}
+						if(p < lineEnd && !isSpace(*p)){
+							error = "wrong face";
+							break;
+						}
+						face.push_back(corner);
+					}
+					if(!error && face.size() < 3){
+						error = "face with less than 3 vertices";
+					}
+					if(!error){
+						for(std::size_t i = 1; i + 1 < face.size(); i++){
+							corners[c++] = face[0];
+							corners[c++] = face[i];
+							corners[c++] = face[i + 1];
+						}
+					}
+					break;
+				}
+				default:
+					break;
+			}
+			if(error){
+				result.error = std::string(error) + ": \"" + lineString(line, lineEnd) + "\"";
+				return;
+			}
+			line = lineEnd + 1;
+		}
+	}
+
+	//--------------------------------------------------------------
+	// STL
+	struct StlChunkResult{
+		std::size_t numFacets = 0;
+		std::size_t numVertices = 0;
+		std::size_t facetOffset = 0;
+		std::size_t vertexOffset = 0;
+		std::string error;
+	};
+
+	glm::vec3 faceNormal(const glm::vec3 & normal, const glm::vec3 & v0, const glm::vec3 & v1, const glm::vec3 & v2){
+		// some exporters leave the normal as 0, calculate it from the
+		// vertices in that case
+		if(normal.x != 0 || normal.y != 0 || normal.z != 0){
+			return normal;
+		}
+		auto e1 = v1 - v0;
+		auto e2 = v2 - v0;
+		glm::vec3 n(e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x);
+		float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+		return length > 0 ? n / length : n;
+	}
+
+	void countStlAscii(const Chunk & chunk, StlChunkResult & result){
+		for(const char * line = chunk.begin; line < chunk.end;){
+			const char * lineEnd = findLineEnd(line, chunk.end);
+			const char * p = skipSpaces(line, lineEnd);
+			if(startsWith(p, lineEnd, "facet")){
+				result.numFacets++;
+			}else if(startsWith(p, lineEnd, "vertex")){
+				result.numVertices++;
+			}
+			line = lineEnd + 1;
+		}
+	}
+
+	void parseStlAscii(const Chunk & chunk, StlChunkResult & result, std::vector<glm::vec3> & facetNormals, std::vector<glm::vec3> & vertices){
+		auto f = result.facetOffset;
+		auto v = result.vertexOffset;
+		for(const char * line = chunk.begin; line < chunk.end;){
+			const char * lineEnd = findLineEnd(line, chunk.end);
+			const char * p = skipSpaces(line, lineEnd);
+			const char * error = nullptr;
+			if(startsWith(p, lineEnd, "facet")){
+				p = skipSpaces(p + 5, lineEnd);
+				float xyz[3];
+				if(!startsWith(p, lineEnd, "normal") || !parseFloats(p + 6, lineEnd, xyz)){
+					error = "wrong facet normal";
+				}else{
+					facetNormals[f++] = {xyz[0], xyz[1], xyz[2]};
+				}
+			}else if(startsWith(p, lineEnd, "vertex")){
+				float xyz[3];
+				if(!parseFloats(p + 6, lineEnd, xyz)){
+					error = "wrong vertex";
+				}else{
+					vertices[v++] = {xyz[0], xyz[1], xyz[2]};
+				}
+			}
+			if(error){
+				result.error = std::string(error) + ": \"" + lineString(line, lineEnd) + "\"";
+				return;
+			}
+			line = lineEnd + 1;
+		}
+	}
+
+	bool loadStlAscii(const char * data, std::size_t size, of::priv::ofMeshLoaderData & mesh, std::string & error){
+		auto chunks = splitLines(data, size);
+		std::vector<StlChunkResult> results(chunks.size());
+		forEachChunk(chunks.size(), [&](std::size_t i){
+			countStlAscii(chunks[i], results[i]);
+		});
+
+		std::size_t numFacets = 0;
+		std::size_t numVertices = 0;
+		for(auto & result: results){
+			result.facetOffset = numFacets;
+			result.vertexOffset = numVertices;
+			numFacets += result.numFacets;
+			numVertices += result.numVertices;
+		}
+		if(numVertices != numFacets * 3){
+			error = "found " + std::to_string(numVertices) + " vertices for " + std::to_string(numFacets) + " facets, expecting 3 vertices per facet";
+			return false;
+		}
+
+		std::vector<glm::vec3> facetNormals(numFacets);
+		mesh.vertices.resize(numVertices);
+		forEachChunk(chunks.size(), [&](std::size_t i){
+			parseStlAscii(chunks[i], results[i], facetNormals, mesh.vertices);
+		});
+		for(auto & result: results){
+			if(!result.error.empty()){
+				error = result.error;
+				return false;
+			}
+		}
+
+		mesh.normals.resize(numVertices);
+		for(std::size_t i = 0; i < numFacets; i++){
+			auto normal = faceNormal(facetNormals[i], mesh.vertices[i * 3], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2]);
+			mesh.normals[i * 3] = normal;
+			mesh.normals[i * 3 + 1] = normal;
+			mesh.normals[i * 3 + 2] = normal;
+		}
+		return true;
+	}
+
+	bool loadStlBinary(const char * data, std::size_t numFacets, of::priv::ofMeshLoaderData & mesh){
+		const std::size_t headerSize = 84;
+		const std::size_t facetSize = 50;
+		mesh.vertices.resize(numFacets * 3);
+		mesh.normals.resize(numFacets * 3);
+
+		std::size_t numThreads = ofGetTaskPool().getNumThreads() + 1;
+		std::size_t numChunks = std::max<std::size_t>(1, std::min(numThreads, numFacets * facetSize / minChunkSize));
+		forEachChunk(numChunks, [&](std::size_t chunk){
+			auto first = numFacets * chunk / numChunks;
+			auto last = numFacets * (chunk + 1) / numChunks;
+			for(auto i = first; i < last; i++){
+				// facets are 12 floats followed by a 2 bytes attribute
+				// count so they aren't aligned, copy them to read them
+				float facet[12];
+				memcpy(facet, data + headerSize + i * facetSize, sizeof(facet));
+				glm::vec3 v0(facet[3], facet[4], facet[5]);
+				glm::vec3 v1(facet[6], facet[7], facet[8]);
+				glm::vec3 v2(facet[9], facet[10], facet[11]);
+				auto normal = faceNormal({facet[0], facet[1], facet[2]}, v0, v1, v2);
+				mesh.vertices[i * 3] = v0;
+				mesh.vertices[i * 3 + 1] = v1;
+				mesh.vertices[i * 3 + 2] = v2;
+				mesh.normals[i * 3] = normal;
+				mesh.normals[i * 3 + 1] = normal;
+				mesh.normals[i * 3 + 2] = normal;
+			}
+		});
+		return true;
+	}
+}
+
+//--------------------------------------------------------------
+bool of::priv::loadOBJ(const char * data, std::size_t size, ofMeshLoaderData & mesh, std::string & error){
+	// first pass counts the elements in each chunk so every chunk knows
+	// where to write its elements and the memory is allocated only once
+	auto chunks = splitLines(data, size);
+	std::vector<ObjChunkResult> results(chunks.size());
+	forEachChunk(chunks.size(), [&](std::size_t i){
+		results[i].counts = countObj(chunks[i]);
+	});
+
+	ObjCounts totals;
+	for(auto & result: results){
+		result.offsets = totals;
+		totals.vertices += result.counts.vertices;
+		totals.texCoords += result.counts.texCoords;
+		totals.normals += result.counts.normals;
+		totals.triangles += result.counts.triangles;
+	}
+	if(totals.vertices > std::numeric_limits<uint32_t>::max() - 1){
+		error = "too many vertices";
+		return false;
+	}
+
+	std::vector<glm::vec3> positions(totals.vertices);
+	std::vector<glm::vec3> normals(totals.normals);
+	std::vector<glm::vec2> texCoords(totals.texCoords);
+	std::vector<ObjCorner> corners(totals.triangles * 3);
+	forEachChunk(chunks.size(), [&](std::size_t i){
+		parseObj(chunks[i], results[i], totals, positions, normals, texCoords, corners);
+	});
+
+	bool hasTexCoords = false;
+	bool hasNormals = false;
+	for(auto & result: results){
+		if(!result.error.empty()){
+			error = result.error;
+			return false;
+		}
+		hasTexCoords |= result.hasTexCoords;
+		hasNormals |= result.hasNormals;
+	}
+
+	mesh = ofMeshLoaderData();
+	mesh.indices.resize(corners.size());
+	if(!hasTexCoords && !hasNormals){
+		// faces only reference positions, they can be used directly
+		if(totals.vertices > std::numeric_limits<ofIndexType>::max()){
+			error = "too many vertices for ofIndexType";
+			return false;
+		}
+		for(std::size_t i = 0; i < corners.size(); i++){
+			mesh.indices[i] = ofIndexType(corners[i].vertex);
+		}
+		mesh.vertices = std::move(positions);
+		return true;
+	}
+
+	// each different combination of position, texture coordinate and
+	// normal becomes a vertex in the mesh
+	std::unordered_map<ObjCorner, ofIndexType, ObjCornerHash> vertexIds;
+	vertexIds.reserve(totals.vertices);
+	mesh.vertices.reserve(totals.vertices);
+	if(hasNormals){
+		mesh.normals.reserve(totals.vertices);
+	}
+	if(hasTexCoords){
+		mesh.texCoords.reserve(totals.vertices);
+	}
+	for(std::size_t i = 0; i < corners.size(); i++){
+		auto & corner = corners[i];
+		auto inserted = vertexIds.emplace(corner, ofIndexType(mesh.vertices.size()));
+		if(inserted.second){
+			if(mesh.vertices.size() >= std::size_t(std::numeric_limits<ofIndexType>::max())){
+				error = "too many vertices for ofIndexType";
+				return false;
+			}
+			mesh.vertices.push_back(positions[corner.vertex]);
+			if(hasNormals){
+				mesh.normals.push_back(corner.normal == noIndex ? glm::vec3(0, 0, 0) : normals[corner.normal]);
+			}
+			if(hasTexCoords){
+				mesh.texCoords.push_back(corner.texCoord == noIndex ? glm::vec2(0, 0) : texCoords[corner.texCoord]);
+			}
+		}
+		mesh.indices[i] = inserted.first->second;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool of::priv::loadSTL(const char * data, std::size_t size, ofMeshLoaderData & mesh, std::string & error){
+	mesh = ofMeshLoaderData();
+
+	// binary files have an 80 bytes header followed by the number of
+	// facets. some binary files start with "solid" too so check if the
+	// size matches before trying to parse it as ascii
+	const std::size_t headerSize = 84;
+	const std::size_t facetSize = 50;
+	uint32_t numFacets = 0;
+	bool sizeMatchesBinary = false;
+	if(size >= headerSize){
+		memcpy(&numFacets, data + 80, sizeof(numFacets));
+		sizeMatchesBinary = headerSize + std::size_t(numFacets) * facetSize <= size;
+		if(headerSize + std::size_t(numFacets) * facetSize == size){
+			return loadStlBinary(data, numFacets, mesh);
+		}
+	}
+
+	auto p = skipSpaces(data, data + size);
+	if(startsWith(p, data + size, "solid")){
+		return loadStlAscii(data, size, mesh, error);
+	}
+	if(sizeMatchesBinary){
+		return loadStlBinary(data, numFacets, mesh);
+	}
+	error = "not a valid ascii or binary STL file";
+	return false;
+}
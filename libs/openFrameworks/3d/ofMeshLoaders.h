@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include <string>
+#include <vector>
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	/// Triangle mesh as read by the OBJ and STL loaders used by
+	/// ofMesh_::load(), normals and texCoords are either empty or have one
+	/// element per vertex. indices can be empty for non indexed meshes.
+	struct ofMeshLoaderData{
+		std::vector<glm::vec3> vertices;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> texCoords;
+		std::vector<ofIndexType> indices;
+	};
+
+	/// Loads positions, normals, texture coordinates and faces from a
+	/// Wavefront OBJ file. Polygons are triangulated as fans and vertices
+	/// with the same position, normal and texture coordinate indices are
+	/// merged.
+	bool loadOBJ(const char * data, std::size_t size, ofMeshLoaderData & mesh, std::string & error);
+
+	/// Loads a binary or ASCII STL file as non indexed triangles with flat
+	/// normals.
+	bool loadSTL(const char * data, std::size_t size, ofMeshLoaderData & mesh, std::string & error);
+
+	template<class V>
+	void assignMeshAttribute(std::vector<V> & dst, std::vector<glm::vec3> && src){
+		dst.resize(src.size());
+		for(std::size_t i = 0; i < src.size(); i++){
+			dst[i] = V(src[i].x, src[i].y, src[i].z);
+		}
+	}
+
+	template<class T>
+	void assignMeshAttribute(std::vector<T> & dst, std::vector<glm::vec2> && src){
+		dst.resize(src.size());
+		for(std::size_t i = 0; i < src.size(); i++){
+			dst[i] = T(src[i].x, src[i].y);
+		}
+	}
+
+	inline void assignMeshAttribute(std::vector<glm::vec3> & dst, std::vector<glm::vec3> && src){
+		dst = std::move(src);
+	}
+
+	inline void assignMeshAttribute(std::vector<glm::vec2> & dst, std::vector<glm::vec2> && src){
+		dst = std::move(src);
+	}
+}
+}
+/*! \endcond */
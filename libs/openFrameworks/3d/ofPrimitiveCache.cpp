@@ -0,0 +1,208 @@
+#include "ofPrimitiveCache.h"
+#include "ofVboMesh.h"
+#include "ofUtils.h"
+#include <array>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+namespace{
+	enum PrimitiveType{
+		PLANE,
+		SPHERE,
+		ICOSPHERE,
+		CYLINDER,
+		CONE,
+		BOX,
+	};
+
+	struct Key{
+		PrimitiveType type;
+		std::array<float,7> params;
+
+		bool operator<(const Key & other) const{
+			if(type != other.type){
+				return type < other.type;
+			}
+			return params < other.params;
+		}
+	};
+
+	struct Entry{
+		std::weak_ptr<const ofVboMesh> mesh;
+		std::size_t bytes;
+		uint64_t generationTime;
+	};
+
+	struct Cache{
+		std::mutex mutex;
+		std::map<Key, Entry> entries;
+		bool enabled = true;
+		std::size_t numHits = 0;
+		std::size_t numMisses = 0;
+		uint64_t generationTime = 0;
+		uint64_t generationTimeSaved = 0;
+	};
+
+	Cache & getCache(){
+		static Cache cache;
+		return cache;
+	}
+
+	std::size_t memoryUsage(const ofMesh & mesh){
+		return mesh.getNumVertices() * sizeof(ofDefaultVertexType) +
+			mesh.getNumNormals() * sizeof(ofDefaultNormalType) +
+			mesh.getNumColors() * sizeof(ofDefaultColorType) +
+			mesh.getNumTexCoords() * sizeof(ofDefaultTexCoordType) +
+			mesh.getNumIndices() * sizeof(ofIndexType);
+	}
+
+	template<class Generator>
+	std::shared_ptr<const ofVboMesh> getOrGenerate(const Key & key, Generator generator){
+		auto & c = getCache();
+		std::unique_lock<std::mutex> lock(c.mutex);
+		if(!c.enabled){
+			lock.unlock();
+			return std::make_shared<ofVboMesh>(generator());
+		}
+
+		auto it = c.entries.find(key);
+		if(it != c.entries.end()){
+			auto mesh = it->second.mesh.lock();
+			if(mesh){
+				c.numHits += 1;
+				c.generationTimeSaved += it->second.generationTime;
+				return mesh;
+			}
+		}
+
+		// generating the mesh while holding the lock avoids generating
+		// the same mesh twice when requested from several threads
+		auto then = ofGetElapsedTimeMicros();
+		std::shared_ptr<const ofVboMesh> mesh = std::make_shared<ofVboMesh>(generator());
+		auto generationTime = ofGetElapsedTimeMicros() - then;
+		c.numMisses += 1;
+		c.generationTime += generationTime;
+
+		// drop the entries of meshes no longer in use
+		for(auto entry = c.entries.begin(); entry != c.entries.end();){
+			if(entry->second.mesh.expired()){
+				entry = c.entries.erase(entry);
+			}else{
+				++entry;
+			}
+		}
+
+		c.entries[key] = {mesh, memoryUsage(*mesh), generationTime};
+		return mesh;
+	}
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::plane(float width, float height, int columns, int rows, ofPrimitiveMode mode){
+	Key key{PLANE, {{width, height, float(columns), float(rows), float(mode), 0.f, 0.f}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::plane(width, height, columns, rows, mode);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::sphere(float radius, int res, ofPrimitiveMode mode){
+	Key key{SPHERE, {{radius, float(res), float(mode), 0.f, 0.f, 0.f, 0.f}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::sphere(radius, res, mode);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::icosphere(float radius, std::size_t iterations){
+	Key key{ICOSPHERE, {{radius, float(iterations), 0.f, 0.f, 0.f, 0.f, 0.f}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::icosphere(radius, iterations);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::cylinder(float radius, float height, int radiusSegments, int heightSegments, int numCapSegments, bool bCapped, ofPrimitiveMode mode){
+	Key key{CYLINDER, {{radius, height, float(radiusSegments), float(heightSegments), float(numCapSegments), float(bCapped), float(mode)}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::cylinder(radius, height, radiusSegments, heightSegments, numCapSegments, bCapped, mode);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::cone(float radius, float height, int radiusSegments, int heightSegments, int capSegments, ofPrimitiveMode mode){
+	Key key{CONE, {{radius, height, float(radiusSegments), float(heightSegments), float(capSegments), float(mode), 0.f}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::cone(radius, height, radiusSegments, heightSegments, capSegments, mode);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofVboMesh> ofPrimitiveCache::box(float width, float height, float depth, int resX, int resY, int resZ){
+	Key key{BOX, {{width, height, depth, float(resX), float(resY), float(resZ), 0.f}}};
+	return getOrGenerate(key, [&]{
+		return ofMesh::box(width, height, depth, resX, resY, resZ);
+	});
+}
+
+//--------------------------------------------------------------
+void ofPrimitiveCache::setEnabled(bool enabled){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	c.enabled = enabled;
+	if(!enabled){
+		c.entries.clear();
+	}
+}
+
+//--------------------------------------------------------------
+bool ofPrimitiveCache::isEnabled(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	return c.enabled;
+}
+
+//--------------------------------------------------------------
+void ofPrimitiveCache::clear(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	c.entries.clear();
+	c.numHits = 0;
+	c.numMisses = 0;
+	c.generationTime = 0;
+	c.generationTimeSaved = 0;
+}
+
+//--------------------------------------------------------------
+ofPrimitiveCache::Stats ofPrimitiveCache::getStats(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	Stats stats;
+	stats.numHits = c.numHits;
+	stats.numMisses = c.numMisses;
+	stats.generationTime = c.generationTime;
+	stats.generationTimeSaved = c.generationTimeSaved;
+	for(auto & entry: c.entries){
+		auto users = entry.second.mesh.use_count();
+		if(users > 0){
+			stats.numMeshes += 1;
+			stats.bytesUsed += entry.second.bytes;
+			stats.bytesSaved += (users - 1) * entry.second.bytes;
+		}
+	}
+	return stats;
+}
+
+//--------------------------------------------------------------
+std::ostream & operator<<(std::ostream & os, const ofPrimitiveCache::Stats & stats){
+	os << stats.numMeshes << " meshes, "
+	   << stats.numHits << " hits, "
+	   << stats.numMisses << " misses, "
+	   << stats.bytesUsed / 1024 << "KB used, "
+	   << stats.bytesSaved / 1024 << "KB saved, "
+	   << stats.generationTime / 1000. << "ms generating, "
+	   << stats.generationTimeSaved / 1000. << "ms saved";
+	return os;
+}
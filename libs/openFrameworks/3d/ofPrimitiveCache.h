@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ofMesh.h"
+#include <memory>
+
+class ofVboMesh;
+
+/// \brief Shares the geometry of procedural primitives.
+///
+/// Generating the mesh of a primitive like a sphere or a cylinder is
+/// relatively expensive and a scene with hundreds of ofSpherePrimitive at
+/// the same resolution would otherwise hold hundreds of identical meshes.
+/// ofPrimitiveCache keeps the meshes it generates keyed by the type of
+/// primitive and its parameters, so every request with the same parameters
+/// returns the same mesh and, since they are ofVboMesh, the same GPU
+/// buffers.
+///
+/// The returned meshes are immutable. of3dPrimitive uses this cache and
+/// only makes its own copy of the mesh the first time it's modified through
+/// of3dPrimitive::getMesh().
+///
+/// The cache doesn't keep the meshes alive, a mesh is released once no
+/// primitive uses it anymore.
+///
+/// ~~~~{.cpp}
+/// std::vector<ofSpherePrimitive> spheres(500);
+/// auto stats = ofPrimitiveCache::getStats();
+/// ofLogNotice() << stats.bytesSaved / 1024 << "KB saved";
+/// ~~~~
+class ofPrimitiveCache{
+public:
+	struct Stats{
+		/// Number of different meshes currently in use.
+		std::size_t numMeshes = 0;
+		/// Number of requests served from the cache.
+		std::size_t numHits = 0;
+		/// Number of requests that had to generate a new mesh.
+		std::size_t numMisses = 0;
+		/// Memory used by the vertex data of the cached meshes.
+		std::size_t bytesUsed = 0;
+		/// Memory that the copies of the meshes currently shared
+		/// would use if they weren't shared.
+		std::size_t bytesSaved = 0;
+		/// Total time spent generating meshes in microseconds.
+		uint64_t generationTime = 0;
+		/// Time in microseconds that would have been spent generating
+		/// the meshes served from the cache.
+		uint64_t generationTimeSaved = 0;
+	};
+
+	static std::shared_ptr<const ofVboMesh> plane(float width, float height, int columns, int rows, ofPrimitiveMode mode);
+	static std::shared_ptr<const ofVboMesh> sphere(float radius, int res, ofPrimitiveMode mode);
+	static std::shared_ptr<const ofVboMesh> icosphere(float radius, std::size_t iterations);
+	static std::shared_ptr<const ofVboMesh> cylinder(float radius, float height, int radiusSegments, int heightSegments, int numCapSegments, bool bCapped, ofPrimitiveMode mode);
+	static std::shared_ptr<const ofVboMesh> cone(float radius, float height, int radiusSegments, int heightSegments, int capSegments, ofPrimitiveMode mode);
+	static std::shared_ptr<const ofVboMesh> box(float width, float height, float depth, int resX, int resY, int resZ);
+
+	/// \brief Enables or disables the cache, enabled by default. When
+	/// disabled every call generates a new mesh.
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	/// \brief Forgets all the cached meshes and resets the stats. Meshes
+	/// already in use are not affected.
+	static void clear();
+
+	static Stats getStats();
+};
+
+std::ostream & operator<<(std::ostream & os, const ofPrimitiveCache::Stats & stats);
@@ -133,6 +133,7 @@ int ofMainLoop::loop(){
 
 void ofMainLoop::loopOnce(){
 	if(bShouldClose) return;
+	ofGetMainEventQueue().flush();
 	for(auto i = windowsApps.begin(); !windowsApps.empty() && i != windowsApps.end();){
 		if(i->first->getWindowShouldClose()){
 			auto window = i->first;
@@ -10,6 +10,13 @@
 #include <stddef.h>
 #include <functional>
 #include <deque>
+#include <type_traits>
+#include <unordered_map>
+#include <string>
+#ifdef OF_EVENT_PROFILING
+#include <chrono>
+#include <typeinfo>
+#endif
 
 
 /*! \cond PRIVATE */
@@ -17,6 +24,43 @@ namespace of{
 namespace priv{
 	// Helper classes and methods, only for internal use of ofEvent
 
+#ifdef OF_EVENT_PROFILING
+	// -------------------------------------
+	// counters of a listener kept by ofEventProfiler, shared by every
+	// registration of the same listener to the same event
+	struct ListenerTiming{
+		std::string event;
+		std::string listener;
+		std::atomic<uint64_t> calls{0};
+		std::atomic<uint64_t> totalTime{0};
+		std::atomic<uint64_t> maxTime{0};
+	};
+
+	std::shared_ptr<ListenerTiming> getListenerTiming(const std::string & event, const std::string & listener);
+	void addListenerSample(ListenerTiming & timing, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+	std::string getTypeName(const std::type_info & type);
+	std::string getAddressName(const void * address);
+
+	// -------------------------------------
+	// times a listener call from its construction to its destruction
+	class ListenerTimer{
+	public:
+		ListenerTimer(ListenerTiming * timing)
+		:timing(timing)
+		,start(std::chrono::steady_clock::now()){}
+
+		~ListenerTimer(){
+			if(timing){
+				addListenerSample(*timing, start, std::chrono::steady_clock::now());
+			}
+		}
+
+	private:
+		ListenerTiming * timing;
+		std::chrono::steady_clock::time_point start;
+	};
+#endif
+
 	// -------------------------------------
 	class NoopMutex{
 	public:
@@ -87,6 +131,9 @@ namespace priv{
 
 		inline bool notify(const void*s,T&t){
 			std::unique_lock<Mutex> lck(mtx);
+#ifdef OF_EVENT_PROFILING
+			ListenerTimer timer(timing.get());
+#endif
 			try{
 				return function(s,t);
 			}catch(std::bad_function_call &){
@@ -101,6 +148,10 @@ namespace priv{
 
 		int priority;
 		std::unique_ptr<BaseFunctionId> id;
+#ifdef OF_EVENT_PROFILING
+		std::string name;
+		std::shared_ptr<ListenerTiming> timing;
+#endif
 
 	private:
 		std::function<bool(const void*,T&)> function;
@@ -122,6 +173,9 @@ namespace priv{
 
 		inline bool notify(const void*s){
 			std::unique_lock<Mutex> lck(mtx);
+#ifdef OF_EVENT_PROFILING
+			ListenerTimer timer(timing.get());
+#endif
 			try{
 				return function(s);
 			}catch(std::bad_function_call &){
@@ -136,12 +190,86 @@ namespace priv{
 
 		int priority;
 		std::unique_ptr<BaseFunctionId> id;
+#ifdef OF_EVENT_PROFILING
+		std::string name;
+		std::shared_ptr<ListenerTiming> timing;
+#endif
 	private:
 		std::function<bool(const void*)> function;
 		Mutex mtx;
 	};
 
 
+	// -------------------------------------
+	// Calls a listener function or lambda with the arguments ofEvent
+	// passes to its listeners. Storing it directly in the std::function
+	// of Function, instead of first converting it to a std::function
+	// with its own signature, saves one indirect call per notification
+	template<typename TFunction, bool ReturnsVoid, std::size_t NumArgs>
+	struct ListenerAdapter;
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,false,0>{
+		TFunction function;
+		bool operator()(const void*){
+			return function();
+		}
+	};
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,true,0>{
+		TFunction function;
+		bool operator()(const void*){
+			function();
+			return false;
+		}
+	};
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,false,1>{
+		TFunction function;
+		template<typename T>
+		bool operator()(const void*, T & t){
+			return function(t);
+		}
+		bool operator()(const void* sender){
+			return function(sender);
+		}
+	};
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,true,1>{
+		TFunction function;
+		template<typename T>
+		bool operator()(const void*, T & t){
+			function(t);
+			return false;
+		}
+		bool operator()(const void* sender){
+			function(sender);
+			return false;
+		}
+	};
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,false,2>{
+		TFunction function;
+		template<typename T>
+		bool operator()(const void* sender, T & t){
+			return function(sender, t);
+		}
+	};
+
+	template<typename TFunction>
+	struct ListenerAdapter<TFunction,true,2>{
+		TFunction function;
+		template<typename T>
+		bool operator()(const void* sender, T & t){
+			function(sender, t);
+			return false;
+		}
+	};
+
 	// -------------------------------------
 	template<typename Function, typename Mutex=std::recursive_mutex>
 	class BaseEvent{
@@ -150,7 +278,7 @@ namespace priv{
 
 		BaseEvent(const BaseEvent & mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 		}
 
 		BaseEvent & operator=(const BaseEvent & mom){
@@ -159,15 +287,16 @@ namespace priv{
 			}
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			std::unique_lock<Mutex> lck2(self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 			self->enabled = mom.self->enabled;
 			return *this;
 		}
 
 		BaseEvent(BaseEvent && mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
-			self->functions = std::move(mom.self->functions);
+			self->setFunctions(mom.self->getFunctions());
 			self->enabled = std::move(mom.self->enabled);
+			mom.self->setFunctions(std::make_shared<Functions>());
 		}
 
 		BaseEvent & operator=(BaseEvent && mom){
@@ -176,7 +305,7 @@ namespace priv{
 			}
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			std::unique_lock<Mutex> lck2(self->mtx);
-			self->functions = mom.self->functions;
+			self->setFunctions(mom.self->getFunctions());
 			self->enabled = mom.self->enabled;
 			return *this;
 		}
@@ -194,24 +323,86 @@ namespace priv{
 		}
 
 		std::size_t size() const {
-			return self->functions.size();
+			return self->getFunctions()->size();
+		}
+
+		/// \brief Name used to report the listeners of this event when
+		/// OF_EVENT_PROFILING is defined, does nothing otherwise.
+		///
+		/// Only affects listeners added after calling it.
+		void setName(const std::string & name){
+#ifdef OF_EVENT_PROFILING
+			std::unique_lock<Mutex> lck(self->mtx);
+			self->name = name;
+#endif
 		}
 
 	protected:
+		typedef std::vector<std::shared_ptr<Function>> Functions;
 
 		struct Data{
+			// the mutex only serializes adding and removing listeners.
+			// the list of listeners is never modified once published,
+			// instead a modified copy replaces it, so notifying only
+			// needs to get the current list which stays valid while
+			// it's iterated even if listeners change in the meantime
 			Mutex mtx;
-			std::vector<std::shared_ptr<Function>> functions;
+			std::shared_ptr<const Functions> functions{std::make_shared<Functions>()};
 			bool enabled = true;
+#ifdef OF_EVENT_PROFILING
+			std::string name;
+#endif
+
+			std::shared_ptr<const Functions> getFunctions() const{
+				return std::atomic_load(&functions);
+			}
+
+			void setFunctions(std::shared_ptr<const Functions> newFunctions){
+				std::atomic_store(&functions, std::move(newFunctions));
+			}
+
+			template<typename... Args>
+			bool notify(const void * sender, Args & ... args) const{
+				if(enabled){
+					auto functions = getFunctions();
+					for(auto & f: *functions){
+						if(f->notify(sender, args...)){
+							return true;
+						}
+					}
+				}
+				return false;
+			}
+
+			void add(const std::shared_ptr<Function> & f){
+				std::unique_lock<Mutex> lck(mtx);
+#ifdef OF_EVENT_PROFILING
+				f->timing = getListenerTiming(name.empty() ? "ofEvent " + getAddressName(this) : name, f->name);
+#endif
+				auto newFunctions = std::make_shared<Functions>();
+				newFunctions->reserve(functions->size() + 1);
+				auto it = functions->begin();
+				for(; it!=functions->end(); ++it){
+					if((*it)->priority>f->priority) break;
+				}
+				newFunctions->insert(newFunctions->end(), functions->begin(), it);
+				newFunctions->push_back(f);
+				newFunctions->insert(newFunctions->end(), it, functions->end());
+				setFunctions(std::move(newFunctions));
+			}
 
 			void remove(const BaseFunctionId & id){
 				std::unique_lock<Mutex> lck(mtx);
-				auto it = functions.begin();
-				for(; it!=functions.end(); ++it){
+				auto it = functions->begin();
+				for(; it!=functions->end(); ++it){
 					auto f = *it;
 					if(*f->id == id){
 						f->disable();
-						functions.erase(it);
+						auto newFunctions = std::make_shared<Functions>();
+						newFunctions->reserve(functions->size() - 1);
+						newFunctions->insert(newFunctions->end(), functions->begin(), it);
+						newFunctions->insert(newFunctions->end(), it + 1, functions->end());
+						setFunctions(std::move(newFunctions));
 						break;
 					}
 				}
@@ -245,24 +436,12 @@ namespace priv{
 			return std::make_unique<EventToken>(self,*f.id);
 		}
 
-		template<typename TFunction>
-		void addNoToken(TFunction && f){
-			std::unique_lock<Mutex> lck(self->mtx);
-			auto it = self->functions.begin();
-			for(; it!=self->functions.end(); ++it){
-				if((*it)->priority>f->priority) break;
-			}
-			self->functions.emplace(it, f);
+		void addNoToken(const std::shared_ptr<Function> & f){
+			self->add(f);
 		}
 
-		template<typename TFunction>
-		std::unique_ptr<EventToken> addFunction(TFunction && f){
-			std::unique_lock<Mutex> lck(self->mtx);
-			auto it = self->functions.begin();
-			for(; it!=self->functions.end(); ++it){
-				if((*it)->priority>f->priority) break;
-			}
-			self->functions.emplace(it, f);
+		std::unique_ptr<EventToken> addFunction(const std::shared_ptr<Function> & f){
+			self->add(f);
 			return make_token(*f);
 		}
 	};
@@ -313,14 +492,14 @@ namespace priv{
 		typedef Ret (*function_ptr)(Args...);
 		typedef Ret function_type(Args...);
 		typedef Ret return_type;
-		static const size_t argc;
+		static const size_t argc = tva_count<Args...>::value;
 
 		template<size_t N>
 		using argument_type = typename tva_n<N, Args...>::type;
 	};
 
 	template<typename Ret, typename... Args>
-	const size_t callable_traits_fn<Ret (Args...)>::argc = tva_count<Args...>::value;
+	const size_t callable_traits_fn<Ret (Args...)>::argc;
 
 
 	/** Define traits for a operator() member function pointer type */
@@ -375,6 +554,86 @@ enum ofEventOrder{
 	OF_EVENT_ORDER_AFTER_APP=200
 };
 
+// -------------------------------------
+/// \brief What ofEvent::post() does when the same event is already waiting
+/// in the queue.
+enum ofEventPostMode{
+	/// \brief Every post is delivered, in the order they were posted.
+	OF_EVENT_POST_ALL,
+	/// \brief Replaces the value of the waiting post so only the latest one
+	/// is delivered, in the position of the first one.
+	OF_EVENT_POST_LATEST
+};
+
+// -------------------------------------
+/// \brief Queue of notifications posted from any thread and delivered in
+/// batches from the thread that calls flush().
+///
+/// ofEvent::post() adds notifications to the main event queue by default,
+/// which is flushed once per frame by ofMainLoop before updating the
+/// windows, so listeners of posted events run in the main thread. Other
+/// threads running their own loop can own an ofEventQueue and flush it
+/// themselves.
+///
+/// ~~~~{.cpp}
+/// // in a worker thread
+/// loadedEvent.post(result);
+///
+/// // progress only needs the last value posted during a frame
+/// progressEvent.post(progress, OF_EVENT_POST_LATEST);
+/// ~~~~
+class ofEventQueue{
+public:
+	/// \brief Counters since the queue was created or resetStats() called.
+	struct Stats{
+		/// Notifications waiting to be delivered.
+		std::size_t depth = 0;
+		/// Maximum number of notifications that were waiting at once.
+		std::size_t maxDepth = 0;
+		std::size_t numPosted = 0;
+		/// Posts that replaced a waiting one with OF_EVENT_POST_LATEST.
+		std::size_t numCoalesced = 0;
+		std::size_t numDelivered = 0;
+		std::size_t numFlushes = 0;
+	};
+
+	/// \brief Adds a notification to the queue, can be called from any
+	/// thread.
+	///
+	/// Usually called through ofEvent::post(). If mode is
+	/// OF_EVENT_POST_LATEST and a notification with the same key is
+	/// already waiting, deliver replaces it.
+	void post(const void * key, std::function<void()> deliver, ofEventPostMode mode = OF_EVENT_POST_ALL);
+
+	/// \brief Delivers all the notifications waiting in the queue.
+	///
+	/// Notifications posted while flushing, for example from a listener,
+	/// wait until the next flush.
+	///
+	/// \returns The number of notifications delivered.
+	std::size_t flush();
+
+	/// \brief Number of notifications waiting to be delivered.
+	std::size_t size() const;
+
+	Stats getStats() const;
+	void resetStats();
+
+private:
+	struct Notification{
+		const void * key;
+		std::function<void()> deliver;
+	};
+	mutable std::mutex mutex;
+	std::vector<Notification> queue;
+	std::unordered_map<const void*, std::size_t> latest;
+	Stats stats;
+};
+
+/// \brief Queue flushed by the main loop where ofEvent::post() adds
+/// notifications by default.
+ofEventQueue & ofGetMainEventQueue();
+
 // -------------------------------------
 class ofEventListener{
 public:
@@ -470,7 +729,9 @@ protected:
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, bool (TObj::*method)(T&), int priority){
-		return std::make_shared<Function>(priority, std::bind(method,listener,std::placeholders::_2), make_function_id(listener,method));
+		return std::make_shared<Function>(priority, [listener, method](const void*, T&t){
+			return ((listener)->*(method))(t);
+		}, make_function_id(listener,method));
 	}
 
 	template<class TObj>
@@ -483,13 +744,15 @@ protected:
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, bool (TObj::*method)(const void*, T&), int priority){
-		return std::make_shared<Function>(priority, std::bind(method,listener,std::placeholders::_1,std::placeholders::_2), make_function_id(listener,method));
+		return std::make_shared<Function>(priority, [listener, method](const void*s, T&t){
+			return ((listener)->*(method))(s,t);
+		}, make_function_id(listener,method));
 	}
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, void (TObj::*method)(const void*, T&), int priority){
 		return std::make_shared<Function>(priority, [listener, method](const void*s, T&t){
-			std::bind(method,listener,std::placeholders::_1,std::placeholders::_2)(s,t);
+			((listener)->*(method))(s,t);
 			return false;
 		}, make_function_id(listener,method));
 	}
@@ -504,20 +767,30 @@ protected:
 		}
 	}
 
-	FunctionPtr make_function(std::function<bool(T&)> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*, T&t) {return f(t); }, make_std_function_id(f));
-	}
-
-	FunctionPtr make_function(std::function<bool(const void*, T&)> f, int priority) {
-		return std::make_shared<Function>(priority, f, make_std_function_id(f));
+	template<typename TFunction>
+	std::unique_ptr<of::priv::BaseFunctionId> make_callable_id(const TFunction & function){
+		return make_std_function_id(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function));
 	}
 
-	FunctionPtr make_function(std::function<void(T&)> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*, T&t) {f(t); return false; }, make_std_function_id(f));
+	template<typename TFunction>
+	FunctionPtr make_callable(TFunction function, int priority) {
+		typedef of::priv::callable_traits<TFunction> traits;
+		typedef of::priv::ListenerAdapter<TFunction, std::is_void<typename traits::return_type>::value, traits::argc> Adapter;
+		auto id = make_callable_id(function);
+		auto f = std::make_shared<Function>(priority, Adapter{std::move(function)}, std::move(id));
+#ifdef OF_EVENT_PROFILING
+		f->name = of::priv::getTypeName(typeid(TFunction));
+#endif
+		return f;
 	}
 
-	FunctionPtr make_function(std::function<void(const void*, T&)> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*s, T&t) {f(s, t); return false; }, make_std_function_id(f));
+	template<class TObj, typename TMethod>
+	FunctionPtr make_member_function(TObj * listener, TMethod method, int priority){
+		auto f = make_function(listener, method, priority);
+#ifdef OF_EVENT_PROFILING
+		f->name = of::priv::getTypeName(typeid(TObj)) + " " + of::priv::getAddressName(listener) + " " + of::priv::getTypeName(typeid(TMethod));
+#endif
+		return f;
 	}
 
 
@@ -527,12 +800,12 @@ protected:
 public:
 	template<class TObj, typename TMethod>
 	std::unique_ptr<of::priv::AbstractEventToken> newListener(TObj * listener, TMethod method, int priority = OF_EVENT_ORDER_AFTER_APP){
-		return addFunction(make_function(listener,method,priority));
+		return addFunction(make_member_function(listener,method,priority));
 	}
 
 	template<class TObj, typename TMethod>
 	void add(TObj * listener, TMethod method, int priority){
-		addNoToken(make_function(listener,method,priority));
+		addNoToken(make_member_function(listener,method,priority));
 	}
 
 	template<class TObj, typename TMethod>
@@ -542,45 +815,53 @@ public:
 
 	template<typename TFunction>
 	std::unique_ptr<of::priv::AbstractEventToken> newListener(TFunction function, int priority = OF_EVENT_ORDER_AFTER_APP) {
-		return addFunction(make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function), priority));
+		return addFunction(make_callable(function, priority));
 	}
 
 	template<typename TFunction>
 	void add(TFunction function, int priority){
-		addNoToken(make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function),priority));
+		addNoToken(make_callable(function, priority));
 	}
 
 	template<typename TFunction>
 	void remove(TFunction function, int priority){
-		 ofEvent<T,Mutex>::self->remove(*make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function), priority)->id);
+		 ofEvent<T,Mutex>::self->remove(*make_callable_id(function));
 	}
 
 	inline bool notify(const void* sender, T & param){
-		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<T,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-                if(f->notify(sender,param)){
-					return true;
-                }
-			}
-		}
-		return false;
+		return ofEvent<T,Mutex>::self->notify(sender, param);
 	}
 
 	inline bool notify(T & param){
-		if(ofEvent<T,Mutex>::self->enabled && !ofEvent<T,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<T,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(nullptr,param)){
-					return true;
-				}
+		return ofEvent<T,Mutex>::self->notify(nullptr, param);
+	}
+
+	/// \brief Notifies the listeners with a copy of param from the thread
+	/// that flushes queue, usually the main thread. Can be called from
+	/// any thread.
+	///
+	/// Nothing is delivered if the event is destroyed before that.
+	void post(ofEventQueue & queue, const void* sender, const T & param, ofEventPostMode mode = OF_EVENT_POST_ALL){
+		std::weak_ptr<typename ofEvent<T,Mutex>::Data> event = ofEvent<T,Mutex>::self;
+		typename std::remove_const<T>::type value = param;
+		queue.post(ofEvent<T,Mutex>::self.get(), [event, sender, value]() mutable{
+			auto self = event.lock();
+			if(self){
+				self->notify(sender, value);
 			}
-		}
-		return false;
+		}, mode);
+	}
+
+	/// \brief Notifies the listeners with a copy of param from the main
+	/// thread during the next frame. Can be called from any thread.
+	void post(const void* sender, const T & param, ofEventPostMode mode = OF_EVENT_POST_ALL){
+		post(ofGetMainEventQueue(), sender, param, mode);
+	}
+
+	/// \brief Notifies the listeners with a copy of param from the main
+	/// thread during the next frame. Can be called from any thread.
+	void post(const T & param, ofEventPostMode mode = OF_EVENT_POST_ALL){
+		post(ofGetMainEventQueue(), nullptr, param, mode);
 	}
 };
 
@@ -629,26 +910,30 @@ protected:
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, bool (TObj::*method)(), int priority){
-		return std::make_shared<Function>(priority, std::bind(method,listener), make_function_id(listener,method));
+		return std::make_shared<Function>(priority,[listener, method](const void*){
+			return ((listener)->*(method))();
+		}, make_function_id(listener,method));
 	}
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, void (TObj::*method)(), int priority){
 		return std::make_shared<Function>(priority,[listener, method](const void*){
-			std::bind(method,listener)();
+			((listener)->*(method))();
 			return false;
 		}, make_function_id(listener,method));
 	}
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, bool (TObj::*method)(const void*), int priority){
-		return std::make_shared<Function>(priority,std::bind(method,listener,std::placeholders::_1), make_function_id(listener,method));
+		return std::make_shared<Function>(priority,[listener, method](const void* sender){
+			return ((listener)->*(method))(sender);
+		}, make_function_id(listener,method));
 	}
 
 	template<class TObj>
 	FunctionPtr make_function(TObj * listener, void (TObj::*method)(const void*), int priority){
 		return std::make_shared<Function>(priority,[listener, method](const void* sender){
-			std::bind(method,listener,std::placeholders::_1)(sender);
+			((listener)->*(method))(sender);
 			return false;
 		}, make_function_id(listener,method));
 	}
@@ -663,20 +948,30 @@ protected:
 		}
 	}
 
-	FunctionPtr make_function(std::function<bool()> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*) {return f(); }, make_std_function_id(f));
-	}
-
-	FunctionPtr make_function(std::function<bool(const void*)> f, int priority) {
-		return std::make_shared<Function>(priority, f, make_std_function_id(f));
+	template<typename TFunction>
+	std::unique_ptr<of::priv::BaseFunctionId> make_callable_id(const TFunction & function){
+		return make_std_function_id(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function));
 	}
 
-	FunctionPtr make_function(std::function<void()> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*) {f(); return false; }, make_std_function_id(f));
+	template<typename TFunction>
+	FunctionPtr make_callable(TFunction function, int priority) {
+		typedef of::priv::callable_traits<TFunction> traits;
+		typedef of::priv::ListenerAdapter<TFunction, std::is_void<typename traits::return_type>::value, traits::argc> Adapter;
+		auto id = make_callable_id(function);
+		auto f = std::make_shared<Function>(priority, Adapter{std::move(function)}, std::move(id));
+#ifdef OF_EVENT_PROFILING
+		f->name = of::priv::getTypeName(typeid(TFunction));
+#endif
+		return f;
 	}
 
-	FunctionPtr make_function(std::function<void(const void*)> f, int priority) {
-		return std::make_shared<Function>(priority, [f](const void*s) {f(s); return false; }, make_std_function_id(f));
+	template<class TObj, typename TMethod>
+	FunctionPtr make_member_function(TObj * listener, TMethod method, int priority){
+		auto f = make_function(listener, method, priority);
+#ifdef OF_EVENT_PROFILING
+		f->name = of::priv::getTypeName(typeid(TObj)) + " " + of::priv::getAddressName(listener) + " " + of::priv::getTypeName(typeid(TMethod));
+#endif
+		return f;
 	}
 
 	using of::priv::BaseEvent<of::priv::Function<void,Mutex>,Mutex>::addFunction;
@@ -685,12 +980,12 @@ protected:
 public:
 	template<class TObj, typename TMethod>
 	void add(TObj * listener, TMethod method, int priority){
-		addNoToken(make_function(listener,method,priority));
+		addNoToken(make_member_function(listener,method,priority));
 	}
 
 	template<class TObj, typename TMethod>
 	std::unique_ptr<of::priv::AbstractEventToken> newListener(TObj * listener, TMethod method, int priority = OF_EVENT_ORDER_AFTER_APP){
-		return addFunction(make_function(listener,method,priority));
+		return addFunction(make_member_function(listener,method,priority));
 	}
 
 	template<class TObj, typename TMethod>
@@ -700,57 +995,67 @@ public:
 
 	template<typename TFunction>
 	void add(TFunction function, int priority){
-		addNoToken(make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function),priority));
+		addNoToken(make_callable(function, priority));
 	}
 
 	template<typename TFunction>
 	std::unique_ptr<of::priv::AbstractEventToken> newListener(TFunction function, int priority = OF_EVENT_ORDER_AFTER_APP) {
-		return addFunction(make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function), priority));
+		return addFunction(make_callable(function, priority));
 	}
 
 	template<typename TFunction>
 	void remove(TFunction function, int priority){
-		 ofEvent<void,Mutex>::self->remove(*make_function(std::function<typename of::priv::callable_traits<TFunction>::function_type>(function),priority)->id);
+		 ofEvent<void,Mutex>::self->remove(*make_callable_id(function));
 	}
 
 	bool notify(const void* sender){
-		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<void,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(sender)){
-					return true;
-				}
-			}
-		}
-		return false;
+		return ofEvent<void,Mutex>::self->notify(sender);
 	}
 
 	bool notify(){
-		if(ofEvent<void,Mutex>::self->enabled && !ofEvent<void,Mutex>::self->functions.empty()){
-			std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-			auto functions_copy = ofEvent<void,Mutex>::self->functions;
-			lck.unlock();
-			for(auto & f: functions_copy){
-				if(f->notify(nullptr)){
-					return true;
-				}
+		return notify(nullptr);
+	}
+
+	/// \brief Notifies the listeners from the thread that flushes queue,
+	/// usually the main thread. Can be called from any thread.
+	///
+	/// Nothing is delivered if the event is destroyed before that.
+	void post(ofEventQueue & queue, const void* sender, ofEventPostMode mode = OF_EVENT_POST_ALL){
+		std::weak_ptr<typename ofEvent<void,Mutex>::Data> event = ofEvent<void,Mutex>::self;
+		queue.post(ofEvent<void,Mutex>::self.get(), [event, sender]{
+			auto self = event.lock();
+			if(self){
+				self->notify(sender);
 			}
-		}
-		return false;
+		}, mode);
+	}
+
+	/// \brief Notifies the listeners from the main thread during the next
+	/// frame. Can be called from any thread.
+	void post(const void* sender, ofEventPostMode mode = OF_EVENT_POST_ALL){
+		post(ofGetMainEventQueue(), sender, mode);
+	}
+
+	/// \brief Notifies the listeners from the main thread during the next
+	/// frame. Can be called from any thread.
+	void post(ofEventPostMode mode = OF_EVENT_POST_ALL){
+		post(ofGetMainEventQueue(), nullptr, mode);
 	}
 };
 
 // -------------------------------------
-/// Non thread safe event that avoids locks and copies of the listeners
-/// making it faster than a plain ofEvent
+/// Non thread safe event that doesn't lock when getting the listeners
+/// making it faster than a plain ofEvent. Notifying still copies the
+/// shared_ptr to the listeners snapshot, one atomic increment, so that a
+/// listener can remove itself while being called
 template<typename T>
 class ofFastEvent: public ofEvent<T,of::priv::NoopMutex>{
 public:
 	inline bool notify(const void* sender, T & param){
 		if(this->isEnabled()){
-			for(auto & f: ofFastEvent<T>::self->functions){
+			// keep the list alive in case a listener removes itself
+			auto functions = ofFastEvent<T>::self->functions;
+			for(auto & f: *functions){
 				if(f->notify(sender, param)){
 					return true;
 				}
@@ -2,6 +2,16 @@
 #include "ofAppRunner.h"
 #include "ofAppBaseWindow.h"
 #include "ofLog.h"
+#include "ofUtils.h"
+#include "ofFileUtils.h"
+#ifdef OF_EVENT_PROFILING
+#include <fstream>
+#include <map>
+#include <sstream>
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
+#endif
 
 using namespace std;
 
@@ -127,7 +137,29 @@ ofCoreEvents::ofCoreEvents()
 ,previousMouseX(0)
 ,previousMouseY(0)
 ,bPreMouseNotSet(false){
-
+	setup.setName("setup");
+	update.setName("update");
+	draw.setName("draw");
+	exit.setName("exit");
+	windowResized.setName("windowResized");
+	windowMoved.setName("windowMoved");
+	keyPressed.setName("keyPressed");
+	keyReleased.setName("keyReleased");
+	mouseMoved.setName("mouseMoved");
+	mouseDragged.setName("mouseDragged");
+	mousePressed.setName("mousePressed");
+	mouseReleased.setName("mouseReleased");
+	mouseScrolled.setName("mouseScrolled");
+	mouseEntered.setName("mouseEntered");
+	mouseExited.setName("mouseExited");
+	touchDown.setName("touchDown");
+	touchUp.setName("touchUp");
+	touchMoved.setName("touchMoved");
+	touchDoubleTap.setName("touchDoubleTap");
+	touchCancelled.setName("touchCancelled");
+	messageEvent.setName("messageEvent");
+	fileDragEvent.setName("fileDragEvent");
+	charEvent.setName("charEvent");
 }
 
 //------------------------------------------
@@ -623,6 +655,296 @@ bool ofSendMessage(string messageString){
 	return ofSendMessage(msg);
 }
 
+//------------------------------------------
+void ofEventQueue::post(const void * key, std::function<void()> deliver, ofEventPostMode mode){
+	std::unique_lock<std::mutex> lck(mutex);
+	stats.numPosted++;
+	if(mode == OF_EVENT_POST_LATEST){
+		auto it = latest.find(key);
+		if(it != latest.end()){
+			queue[it->second].deliver = std::move(deliver);
+			stats.numCoalesced++;
+			return;
+		}
+		latest[key] = queue.size();
+	}
+	queue.push_back({key, std::move(deliver)});
+	stats.maxDepth = std::max(stats.maxDepth, queue.size());
+}
+
+//------------------------------------------
+std::size_t ofEventQueue::flush(){
+	std::vector<Notification> batch;
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		if(queue.empty()){
+			return 0;
+		}
+		std::swap(batch, queue);
+		latest.clear();
+		stats.numFlushes++;
+	}
+
+	for(auto & notification: batch){
+		notification.deliver();
+	}
+
+	auto delivered = batch.size();
+	batch.clear();
+	std::unique_lock<std::mutex> lck(mutex);
+	stats.numDelivered += delivered;
+	// give the memory back so posting doesn't need to allocate every frame
+	if(queue.empty()){
+		std::swap(batch, queue);
+	}
+	return delivered;
+}
+
+//------------------------------------------
+std::size_t ofEventQueue::size() const{
+	std::unique_lock<std::mutex> lck(mutex);
+	return queue.size();
+}
+
+//------------------------------------------
+ofEventQueue::Stats ofEventQueue::getStats() const{
+	std::unique_lock<std::mutex> lck(mutex);
+	auto currentStats = stats;
+	currentStats.depth = queue.size();
+	return currentStats;
+}
+
+//------------------------------------------
+void ofEventQueue::resetStats(){
+	std::unique_lock<std::mutex> lck(mutex);
+	stats = Stats();
+}
+
+//------------------------------------------
+ofEventQueue & ofGetMainEventQueue(){
+	static ofEventQueue * queue = new ofEventQueue;
+	return *queue;
+}
+
+#ifdef OF_EVENT_PROFILING
+namespace{
+	struct Profiler{
+		std::mutex mutex;
+		std::map<std::pair<std::string,std::string>, std::shared_ptr<of::priv::ListenerTiming>> listeners;
+		std::atomic<bool> tracing{false};
+		std::mutex traceMutex;
+		std::ofstream trace;
+		std::map<std::thread::id, std::size_t> traceThreads;
+		std::chrono::steady_clock::time_point traceStart;
+		bool firstSample = true;
+	};
+
+	Profiler & getProfiler(){
+		static Profiler * profiler = new Profiler;
+		return *profiler;
+	}
+
+	std::string escapeJson(const std::string & str){
+		std::string escaped;
+		for(auto c: str){
+			if(c == '"' || c == '\\'){
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+}
+
+namespace of{
+	namespace priv{
+		//------------------------------------------
+		std::shared_ptr<ListenerTiming> getListenerTiming(const std::string & event, const std::string & listener){
+			auto & profiler = getProfiler();
+			std::unique_lock<std::mutex> lck(profiler.mutex);
+			auto & timing = profiler.listeners[std::make_pair(event, listener)];
+			if(!timing){
+				timing = std::make_shared<ListenerTiming>();
+				timing->event = event;
+				timing->listener = listener;
+			}
+			return timing;
+		}
+
+		//------------------------------------------
+		void addListenerSample(ListenerTiming & timing, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end){
+			uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+			timing.calls++;
+			timing.totalTime += time;
+			auto maxTime = timing.maxTime.load();
+			while(time > maxTime && !timing.maxTime.compare_exchange_weak(maxTime, time));
+
+			auto & profiler = getProfiler();
+			if(profiler.tracing){
+				std::unique_lock<std::mutex> lck(profiler.traceMutex);
+				if(profiler.trace.is_open()){
+					auto ts = std::chrono::duration<double, std::micro>(start - profiler.traceStart).count();
+					auto dur = std::chrono::duration<double, std::micro>(end - start).count();
+					profiler.trace << (profiler.firstSample ? "" : ",\n")
+						<< "{\"name\":\"" << escapeJson(timing.listener) << "\""
+						<< ",\"cat\":\"" << escapeJson(timing.event) << "\""
+						<< ",\"ph\":\"X\",\"pid\":0"
+						<< ",\"tid\":" << profiler.traceThreads.emplace(std::this_thread::get_id(), profiler.traceThreads.size()).first->second
+						<< ",\"ts\":" << ts
+						<< ",\"dur\":" << dur << "}";
+					profiler.firstSample = false;
+				}
+			}
+		}
+
+		//------------------------------------------
+		std::string getTypeName(const std::type_info & type){
+#if defined(__GNUC__) || defined(__clang__)
+			int status = 0;
+			char * demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+			if(status == 0 && demangled){
+				std::string name(demangled);
+				free(demangled);
+				return name;
+			}
+#endif
+			return type.name();
+		}
+
+		//------------------------------------------
+		std::string getAddressName(const void * address){
+			std::ostringstream name;
+			name << address;
+			return name.str();
+		}
+	}
+}
+#endif
+
+//------------------------------------------
+bool ofEventProfiler::isEnabled(){
+#ifdef OF_EVENT_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+//------------------------------------------
+vector<ofEventProfiler::ListenerStats> ofEventProfiler::getStats(SortOrder sortOrder){
+	vector<ListenerStats> stats;
+#ifdef OF_EVENT_PROFILING
+	auto & profiler = getProfiler();
+	std::unique_lock<std::mutex> lck(profiler.mutex);
+	for(auto & listener: profiler.listeners){
+		auto & timing = *listener.second;
+		if(timing.calls == 0){
+			continue;
+		}
+		ListenerStats listenerStats;
+		listenerStats.event = timing.event;
+		listenerStats.listener = timing.listener;
+		listenerStats.calls = timing.calls;
+		listenerStats.totalTime = timing.totalTime;
+		listenerStats.maxTime = timing.maxTime;
+		stats.push_back(listenerStats);
+	}
+	lck.unlock();
+
+	std::sort(stats.begin(), stats.end(), [sortOrder](const ListenerStats & a, const ListenerStats & b){
+		switch(sortOrder){
+		case MaxTime:
+			return a.maxTime > b.maxTime;
+		case Calls:
+			return a.calls > b.calls;
+		case TotalTime:
+		default:
+			return a.totalTime > b.totalTime;
+		}
+	});
+#endif
+	return stats;
+}
+
+//------------------------------------------
+void ofEventProfiler::dump(std::ostream & out, SortOrder sortOrder, std::size_t maxRows){
+	auto stats = getStats(sortOrder);
+	if(maxRows > 0 && stats.size() > maxRows){
+		stats.resize(maxRows);
+	}
+	std::size_t eventWidth = 5;
+	for(auto & listener: stats){
+		eventWidth = std::max(eventWidth, listener.event.size());
+	}
+	out << ofToString("event", eventWidth, ' ') << " "
+		<< ofToString("calls", 10, ' ') << " "
+		<< ofToString("total ms", 12, ' ') << " "
+		<< ofToString("avg us", 12, ' ') << " "
+		<< ofToString("max us", 12, ' ') << "  listener" << std::endl;
+	for(auto & listener: stats){
+		out << ofToString(listener.event, eventWidth, ' ') << " "
+			<< ofToString(listener.calls, 10, ' ') << " "
+			<< ofToString(listener.totalTime / 1000000., 3, 12, ' ') << " "
+			<< ofToString(listener.totalTime / 1000. / listener.calls, 3, 12, ' ') << " "
+			<< ofToString(listener.maxTime / 1000., 3, 12, ' ') << "  "
+			<< listener.listener << std::endl;
+	}
+}
+
+//------------------------------------------
+void ofEventProfiler::reset(){
+#ifdef OF_EVENT_PROFILING
+	auto & profiler = getProfiler();
+	std::unique_lock<std::mutex> lck(profiler.mutex);
+	for(auto it = profiler.listeners.begin(); it != profiler.listeners.end();){
+		if(it->second.use_count() == 1){
+			it = profiler.listeners.erase(it);
+		}else{
+			it->second->calls = 0;
+			it->second->totalTime = 0;
+			it->second->maxTime = 0;
+			++it;
+		}
+	}
+#endif
+}
+
+//------------------------------------------
+bool ofEventProfiler::startTrace(const std::string & path){
+#ifdef OF_EVENT_PROFILING
+	auto & profiler = getProfiler();
+	stopTrace();
+	std::unique_lock<std::mutex> lck(profiler.traceMutex);
+	profiler.trace.open(ofToDataPath(path, true), std::ios::out | std::ios::trunc);
+	if(!profiler.trace.is_open()){
+		ofLogError("ofEventProfiler") << "startTrace(): couldn't open trace file \"" << path << "\"";
+		return false;
+	}
+	profiler.trace << "[\n";
+	profiler.firstSample = true;
+	profiler.traceThreads.clear();
+	profiler.traceStart = std::chrono::steady_clock::now();
+	profiler.tracing = true;
+	return true;
+#else
+	ofLogWarning("ofEventProfiler") << "startTrace(): event profiling is disabled, build with OF_EVENT_PROFILING defined";
+	return false;
+#endif
+}
+
+//------------------------------------------
+void ofEventProfiler::stopTrace(){
+#ifdef OF_EVENT_PROFILING
+	auto & profiler = getProfiler();
+	profiler.tracing = false;
+	std::unique_lock<std::mutex> lck(profiler.traceMutex);
+	if(profiler.trace.is_open()){
+		profiler.trace << "\n]\n";
+		profiler.trace.close();
+	}
+#endif
+}
+
 //------------------------------------------
 namespace of{
 	namespace priv{
@@ -433,6 +433,68 @@ bool ofSendMessage(std::string messageString);
 
 ofCoreEvents & ofEvents();
 
+/// \brief Time spent in each event listener.
+///
+/// Finds which update, draw or addon listener is responsible for a
+/// dropped frame. Profiling is only compiled in when openFrameworks and the
+/// application are built with OF_EVENT_PROFILING defined, otherwise
+/// notifying an event doesn't measure anything and these functions do
+/// nothing.
+///
+/// Listeners are reported by the name of the event, set with
+/// ofEvent::setName(), and by the class, address and method signature of
+/// the object that registered them or the type of the function or lambda.
+/// The events of ofCoreEvents are named after their members.
+///
+/// ~~~~{.cpp}
+/// void ofApp::keyPressed(int key){
+/// 	if(key == 'p'){
+/// 		ofEventProfiler::dump(std::cout, ofEventProfiler::MaxTime, 10);
+/// 	}
+/// }
+/// ~~~~
+///
+/// startTrace() additionally writes every listener call to a file in the
+/// trace event format that chrome://tracing and https://ui.perfetto.dev
+/// can load.
+class ofEventProfiler{
+public:
+	struct ListenerStats{
+		std::string event;
+		std::string listener;
+		uint64_t calls = 0;
+		/// Total time spent in the listener in nanoseconds.
+		uint64_t totalTime = 0;
+		/// Longest call to the listener in nanoseconds.
+		uint64_t maxTime = 0;
+	};
+
+	enum SortOrder{
+		TotalTime,
+		MaxTime,
+		Calls,
+	};
+
+	/// \brief Whether profiling was compiled in with OF_EVENT_PROFILING.
+	static bool isEnabled();
+
+	/// \brief Counters of every listener that was called since it was
+	/// added or reset() was called, sorted in descending order.
+	static std::vector<ListenerStats> getStats(SortOrder sortOrder = TotalTime);
+
+	/// \brief Prints a table with the first maxRows listeners, or all of
+	/// them if maxRows is 0.
+	static void dump(std::ostream & out, SortOrder sortOrder = TotalTime, std::size_t maxRows = 0);
+
+	/// \brief Sets all the counters to 0 and forgets removed listeners.
+	static void reset();
+
+	/// \brief Writes every listener call to path, relative to the data
+	/// folder, until stopTrace() is called.
+	static bool startTrace(const std::string & path);
+	static void stopTrace();
+};
+
 template<class ListenerClass>
 void ofRegisterMouseEvents(ListenerClass * listener, int prio=OF_EVENT_ORDER_AFTER_APP){
 	ofAddListener(ofEvents().mouseDragged,listener,&ListenerClass::mouseDragged,prio);
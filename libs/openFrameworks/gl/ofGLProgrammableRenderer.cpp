@@ -341,11 +341,16 @@ void ofGLProgrammableRenderer::draw(const ofPath & shape) const{
 		if(shape.getUseShapeColor()){
 			mut_this->setColor( shape.getStrokeColor(), shape.getStrokeColor().a);
 		}
-		mut_this->setLineWidth( shape.getStrokeWidth() );
-		const vector<ofPolyline> & outlines = shape.getOutline();
-		for(int i=0; i<(int)outlines.size(); i++)
-			draw(outlines[i]);
-		mut_this->setLineWidth(lineWidth);
+		if(shape.getStrokeWidth()>1){
+			// wide lines aren't supported by core profile opengl
+			draw(shape.getStrokeMesh(),OF_MESH_FILL);
+		}else{
+			mut_this->setLineWidth( shape.getStrokeWidth() );
+			const vector<ofPolyline> & outlines = shape.getOutline();
+			for(int i=0; i<(int)outlines.size(); i++)
+				draw(outlines[i]);
+			mut_this->setLineWidth(lineWidth);
+		}
 	}
 	if(shape.getUseShapeColor()){
 		mut_this->setColor(prevColor);
@@ -0,0 +1,375 @@
+#pragma once
+
+#include "ofMesh.h"
+#include "ofVbo.h"
+#include "ofGLUtils.h"
+#include "ofColor.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include <cstddef>
+#include <type_traits>
+
+/// \name Interleaved vertex formats
+/// \{
+///
+/// Vertex structs usable with ofInterleavedMesh_. Any standard layout struct
+/// with a `position` member (glm::vec2 or glm::vec3) and optionally
+/// `normal` (glm::vec3), `color` (ofFloatColor) and `texCoord` (glm::vec2)
+/// members can be used as a vertex format, the available attributes are
+/// detected at compile time.
+
+struct ofVertexP{
+	glm::vec3 position;
+};
+
+struct ofVertexPC{
+	glm::vec3 position;
+	ofFloatColor color;
+};
+
+struct ofVertexPN{
+	glm::vec3 position;
+	glm::vec3 normal;
+};
+
+struct ofVertexPT{
+	glm::vec3 position;
+	glm::vec2 texCoord;
+};
+
+struct ofVertexPNT{
+	glm::vec3 position;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+struct ofVertexPNC{
+	glm::vec3 position;
+	glm::vec3 normal;
+	ofFloatColor color;
+};
+
+struct ofVertexPNCT{
+	glm::vec3 position;
+	glm::vec3 normal;
+	ofFloatColor color;
+	glm::vec2 texCoord;
+};
+
+/// \}
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	template<class Vertex, class = void>
+	struct hasNormal: std::false_type{};
+	template<class Vertex>
+	struct hasNormal<Vertex, decltype(void(std::declval<Vertex>().normal))>: std::true_type{};
+
+	template<class Vertex, class = void>
+	struct hasColor: std::false_type{};
+	template<class Vertex>
+	struct hasColor<Vertex, decltype(void(std::declval<Vertex>().color))>: std::true_type{};
+
+	template<class Vertex, class = void>
+	struct hasTexCoord: std::false_type{};
+	template<class Vertex>
+	struct hasTexCoord<Vertex, decltype(void(std::declval<Vertex>().texCoord))>: std::true_type{};
+
+	template<class Vertex> int normalOffset(std::true_type){ return offsetof(Vertex, normal); }
+	template<class Vertex> int normalOffset(std::false_type){ return -1; }
+	template<class Vertex> int colorOffset(std::true_type){ return offsetof(Vertex, color); }
+	template<class Vertex> int colorOffset(std::false_type){ return -1; }
+	template<class Vertex> int texCoordOffset(std::true_type){ return offsetof(Vertex, texCoord); }
+	template<class Vertex> int texCoordOffset(std::false_type){ return -1; }
+
+	template<class Vertex, class N> void setNormal(Vertex & v, const N & n, std::true_type){ v.normal = glm::vec3(n.x, n.y, n.z); }
+	template<class Vertex, class N> void setNormal(Vertex &, const N &, std::false_type){}
+	template<class Vertex, class C> void setColor(Vertex & v, const C & c, std::true_type){ v.color = c; }
+	template<class Vertex, class C> void setColor(Vertex &, const C &, std::false_type){}
+	template<class Vertex, class T> void setTexCoord(Vertex & v, const T & t, std::true_type){ v.texCoord = glm::vec2(t.x, t.y); }
+	template<class Vertex, class T> void setTexCoord(Vertex &, const T &, std::false_type){}
+
+	template<class Vertex, class N> void getNormal(const Vertex & v, N & n, std::true_type){ n = N(v.normal.x, v.normal.y, v.normal.z); }
+	template<class Vertex, class N> void getNormal(const Vertex &, N &, std::false_type){}
+	template<class Vertex, class C> void getColor(const Vertex & v, C & c, std::true_type){ c = v.color; }
+	template<class Vertex, class C> void getColor(const Vertex &, C &, std::false_type){}
+	template<class Vertex, class T> void getTexCoord(const Vertex & v, T & t, std::true_type){ t = T(v.texCoord.x, v.texCoord.y); }
+	template<class Vertex, class T> void getTexCoord(const Vertex &, T &, std::false_type){}
+}
+}
+/*! \endcond */
+
+/// \brief Compile time description of an interleaved vertex format.
+///
+/// Tells which attributes a vertex struct has and where they are, this is
+/// what ofInterleavedMesh_ uses to upload its vertices to the GPU.
+template<class Vertex>
+struct ofVertexFormat{
+	static_assert(std::is_standard_layout<Vertex>::value, "interleaved vertex formats need to be standard layout structs");
+
+	static constexpr bool hasNormals = of::priv::hasNormal<Vertex>::value;
+	static constexpr bool hasColors = of::priv::hasColor<Vertex>::value;
+	static constexpr bool hasTexCoords = of::priv::hasTexCoord<Vertex>::value;
+	static constexpr int numPositionCoords = sizeof(Vertex::position) / sizeof(float);
+	static constexpr int stride = sizeof(Vertex);
+
+	/// \returns the offset in bytes of the normal in each vertex or -1.
+	static int normalOffset(){ return of::priv::normalOffset<Vertex>(of::priv::hasNormal<Vertex>()); }
+
+	/// \returns the offset in bytes of the color in each vertex or -1.
+	static int colorOffset(){ return of::priv::colorOffset<Vertex>(of::priv::hasColor<Vertex>()); }
+
+	/// \returns the offset in bytes of the texture coordinate in each vertex or -1.
+	static int texCoordOffset(){ return of::priv::texCoordOffset<Vertex>(of::priv::hasTexCoord<Vertex>()); }
+};
+
+/// \brief A mesh that stores all the attributes of a vertex next to each
+/// other in memory.
+///
+/// ofMesh keeps vertices, normals, colors and texture coordinates in
+/// separate vectors and uploads each one to its own buffer. An
+/// ofInterleavedMesh_ stores a single vector of vertex structs, which is
+/// uploaded to the GPU with one buffer write and is more cache friendly
+/// when deforming the vertices every frame.
+///
+/// ~~~~{.cpp}
+/// ofInterleavedMesh_<ofVertexPN> mesh(ofMesh::sphere(100));
+/// for(auto & v: mesh.getVertices()){
+///     v.position += v.normal * ofSignedNoise(v.position * 0.01f);
+/// }
+/// mesh.draw();
+/// ~~~~
+///
+/// The GL buffer is kept by the mesh and only updated when the vertices or
+/// indices have been accessed through a non const getter.
+template<class Vertex>
+class ofInterleavedMesh_{
+public:
+	typedef ofVertexFormat<Vertex> Format;
+
+	ofInterleavedMesh_()
+	:mode(OF_PRIMITIVE_TRIANGLES)
+	,usage(GL_STATIC_DRAW)
+	,bVertsChanged(false)
+	,bIndicesChanged(false)
+	,vboNumVerts(0)
+	,vboNumIndices(0){}
+
+	/// \brief Creates an interleaved mesh from an ofMesh, attributes not
+	/// present in the vertex format are ignored.
+	template<class V, class N, class C, class T>
+	ofInterleavedMesh_(const ofMesh_<V,N,C,T> & mesh)
+	:ofInterleavedMesh_(){
+		setFromMesh(mesh);
+	}
+
+	template<class V, class N, class C, class T>
+	void setFromMesh(const ofMesh_<V,N,C,T> & mesh){
+		mode = mesh.getMode();
+		auto & positions = mesh.getVertices();
+		vertices.resize(positions.size());
+		bool useNormals = mesh.getNumNormals() == positions.size();
+		bool useColors = mesh.getNumColors() == positions.size();
+		bool useTexCoords = mesh.getNumTexCoords() == positions.size();
+		for(std::size_t i = 0; i < positions.size(); i++){
+			auto & v = vertices[i];
+			v = Vertex();
+			setPosition(v, positions[i]);
+			if(useNormals) of::priv::setNormal(v, mesh.getNormals()[i], of::priv::hasNormal<Vertex>());
+			if(useColors) of::priv::setColor(v, mesh.getColors()[i], of::priv::hasColor<Vertex>());
+			if(useTexCoords) of::priv::setTexCoord(v, mesh.getTexCoords()[i], of::priv::hasTexCoord<Vertex>());
+		}
+		indices = mesh.getIndices();
+		bVertsChanged = true;
+		bIndicesChanged = true;
+	}
+
+	/// \returns an ofMesh with the same geometry, only with the attributes
+	/// present in the vertex format.
+	template<class V = ofDefaultVertexType, class N = ofDefaultNormalType, class C = ofDefaultColorType, class T = ofDefaultTexCoordType>
+	ofMesh_<V,N,C,T> getMesh() const{
+		ofMesh_<V,N,C,T> mesh;
+		mesh.setMode(mode);
+		auto & positions = mesh.getVertices();
+		positions.resize(vertices.size());
+		if(Format::hasNormals) mesh.getNormals().resize(vertices.size());
+		if(Format::hasColors) mesh.getColors().resize(vertices.size());
+		if(Format::hasTexCoords) mesh.getTexCoords().resize(vertices.size());
+		for(std::size_t i = 0; i < vertices.size(); i++){
+			auto & v = vertices[i];
+			getPosition(v, positions[i]);
+			if(Format::hasNormals) of::priv::getNormal(v, mesh.getNormals()[i], of::priv::hasNormal<Vertex>());
+			if(Format::hasColors) of::priv::getColor(v, mesh.getColors()[i], of::priv::hasColor<Vertex>());
+			if(Format::hasTexCoords) of::priv::getTexCoord(v, mesh.getTexCoords()[i], of::priv::hasTexCoord<Vertex>());
+		}
+		mesh.getIndices() = indices;
+		return mesh;
+	}
+
+	void setMode(ofPrimitiveMode mode){
+		this->mode = mode;
+	}
+
+	ofPrimitiveMode getMode() const{
+		return mode;
+	}
+
+	/// \brief Sets the GL usage hint of the vertex buffer,
+	/// GL_STATIC_DRAW by default. Use GL_DYNAMIC_DRAW or GL_STREAM_DRAW
+	/// when the vertices change every frame.
+	void setUsage(int usage){
+		if(this->usage != usage){
+			this->usage = usage;
+			vboNumVerts = 0;
+			vboNumIndices = 0;
+			bVertsChanged = true;
+			bIndicesChanged = true;
+		}
+	}
+
+	void addVertex(const Vertex & v){
+		vertices.push_back(v);
+		bVertsChanged = true;
+	}
+
+	void addVertices(const std::vector<Vertex> & verts){
+		vertices.insert(vertices.end(), verts.begin(), verts.end());
+		bVertsChanged = true;
+	}
+
+	void addIndex(ofIndexType i){
+		indices.push_back(i);
+		bIndicesChanged = true;
+	}
+
+	void addTriangle(ofIndexType index1, ofIndexType index2, ofIndexType index3){
+		indices.push_back(index1);
+		indices.push_back(index2);
+		indices.push_back(index3);
+		bIndicesChanged = true;
+	}
+
+	/// \brief Use this to modify the vertices, marks the GL buffer to be
+	/// updated on the next draw.
+	std::vector<Vertex> & getVertices(){
+		bVertsChanged = true;
+		return vertices;
+	}
+
+	const std::vector<Vertex> & getVertices() const{
+		return vertices;
+	}
+
+	/// \brief Use this to modify the indices, marks the GL buffer to be
+	/// updated on the next draw.
+	std::vector<ofIndexType> & getIndices(){
+		bIndicesChanged = true;
+		return indices;
+	}
+
+	const std::vector<ofIndexType> & getIndices() const{
+		return indices;
+	}
+
+	std::size_t getNumVertices() const{
+		return vertices.size();
+	}
+
+	std::size_t getNumIndices() const{
+		return indices.size();
+	}
+
+	bool hasIndices() const{
+		return !indices.empty();
+	}
+
+	void clear(){
+		vertices.clear();
+		indices.clear();
+		bVertsChanged = true;
+		bIndicesChanged = true;
+	}
+
+	/// \brief Uploads any changes to the GL buffer and draws the mesh.
+	void draw() const{
+		if(vertices.empty()){
+			return;
+		}
+		updateVbo();
+		auto glMode = ofGetGLPrimitiveMode(mode);
+		if(indices.empty()){
+			vbo.draw(glMode, 0, vertices.size());
+		}else{
+			vbo.drawElements(glMode, indices.size());
+		}
+	}
+
+	/// \returns the vbo holding the interleaved vertices, after uploading
+	/// any pending changes.
+	const ofVbo & getVbo() const{
+		updateVbo();
+		return vbo;
+	}
+
+private:
+	template<class V>
+	static void setPosition(Vertex & v, const V & p){
+		setPosition(v.position, p);
+	}
+
+	static void setPosition(glm::vec3 & position, const glm::vec3 & p){ position = p; }
+	static void setPosition(glm::vec3 & position, const glm::vec2 & p){ position = glm::vec3(p, 0.f); }
+	static void setPosition(glm::vec2 & position, const glm::vec3 & p){ position = glm::vec2(p); }
+	static void setPosition(glm::vec2 & position, const glm::vec2 & p){ position = p; }
+
+	template<class V>
+	static void getPosition(const Vertex & v, V & p){
+		getPosition(v.position, p);
+	}
+
+	static void getPosition(const glm::vec3 & position, glm::vec3 & p){ p = position; }
+	static void getPosition(const glm::vec3 & position, glm::vec2 & p){ p = glm::vec2(position); }
+	static void getPosition(const glm::vec2 & position, glm::vec3 & p){ p = glm::vec3(position, 0.f); }
+	static void getPosition(const glm::vec2 & position, glm::vec2 & p){ p = position; }
+
+	void updateVbo() const{
+		if(bVertsChanged && !vertices.empty()){
+			auto data = reinterpret_cast<const float*>(vertices.data());
+			if(vboNumVerts == vertices.size()){
+				vbo.updateInterleavedData(data, vertices.size());
+			}else{
+				vbo.setInterleavedData(data, vertices.size(), Format::stride, usage,
+									   Format::numPositionCoords, Format::colorOffset(),
+									   Format::normalOffset(), Format::texCoordOffset());
+				vboNumVerts = vertices.size();
+			}
+			bVertsChanged = false;
+		}
+		if(bIndicesChanged){
+			if(indices.empty()){
+				vbo.disableIndices();
+			}else if(vboNumIndices == indices.size()){
+				vbo.updateIndexData(indices.data(), indices.size());
+			}else{
+				vbo.setIndexData(indices.data(), indices.size(), usage);
+				vbo.enableIndices();
+			}
+			vboNumIndices = indices.size();
+			bIndicesChanged = false;
+		}
+	}
+
+	std::vector<Vertex> vertices;
+	std::vector<ofIndexType> indices;
+	ofPrimitiveMode mode;
+	int usage;
+
+	mutable ofVbo vbo;
+	mutable bool bVertsChanged;
+	mutable bool bIndicesChanged;
+	mutable std::size_t vboNumVerts;
+	mutable std::size_t vboNumIndices;
+};
+
+using ofInterleavedMesh = ofInterleavedMesh_<ofVertexPNCT>;
@@ -394,6 +394,33 @@ void ofVbo::setTexCoordData(const float * texCoord0x, int total, int usage, int
 }
 
 
+//--------------------------------------------------------------
+void ofVbo::setInterleavedData(const float * vertex0, int total, int stride, int usage, int numPositionCoords, int colorOffset, int normalOffset, int texCoordOffset){
+	positionAttribute.setData(vertex0, numPositionCoords, total, usage, stride);
+	bUsingVerts = true;
+	totalVerts = total;
+	vaoChanged = true;
+
+	if(colorOffset >= 0){
+		colorAttribute.setBuffer(positionAttribute.buffer, 4, stride, colorOffset);
+		enableColors();
+	}else{
+		disableColors();
+	}
+	if(normalOffset >= 0){
+		normalAttribute.setBuffer(positionAttribute.buffer, 3, stride, normalOffset);
+		enableNormals();
+	}else{
+		disableNormals();
+	}
+	if(texCoordOffset >= 0){
+		texCoordAttribute.setBuffer(positionAttribute.buffer, 2, stride, texCoordOffset);
+		enableTexCoords();
+	}else{
+		disableTexCoords();
+	}
+}
+
 //--------------------------------------------------------------
 void ofVbo::setIndexData(const ofIndexType * indices, int total, int usage){
 	if(!indexAttribute.isAllocated()){
@@ -540,6 +567,11 @@ void ofVbo::updateIndexData(const ofIndexType * indices, int total) {
 	}
 }
 
+//--------------------------------------------------------------
+void ofVbo::updateInterleavedData(const float * vertex0, int total) {
+	positionAttribute.updateData(0, total * positionAttribute.stride, vertex0);
+}
+
 void ofVbo::updateAttributeData(int location, const float * attr0x, int total){
 	VertexAttribute * attr = nullptr;
 	if (ofIsGLProgrammableRenderer()) {
@@ -47,6 +47,19 @@ public:
 
 	void setAttributeData(int location, const float * vert0x, int numCoords, int total, int usage, int stride=0);
 
+	/// \brief Uploads interleaved vertex data in a single buffer write.
+	///
+	/// All the attributes present in the data are pointed to the same GL
+	/// buffer, so a mesh with positions, normals, colors and texture
+	/// coordinates is uploaded with one call instead of four.
+	/// Offsets are the byte offset of each attribute from the start of a
+	/// vertex, pass -1 for attributes not present in the data. This is used
+	/// by ofInterleavedMesh.
+	///
+	/// Since the attributes share one buffer, call clear() before switching
+	/// back to the per attribute setters.
+	void setInterleavedData(const float * vertex0, int total, int stride, int usage, int numPositionCoords, int colorOffset, int normalOffset, int texCoordOffset);
+
 #ifndef TARGET_OPENGLES
 	/// used to send an attribute per instance(s) instead of per vertex.
 	/// will send per vertex if set to 0 or to the number of instances if >0
@@ -99,6 +112,10 @@ public:
 
 	void updateAttributeData(int location, const float * vert0x, int total);
 
+	/// \brief Updates data previously uploaded with setInterleavedData(),
+	/// total can't be bigger than the number of vertices allocated then.
+	void updateInterleavedData(const float * vertex0, int total);
+
 	void enableColors();
 	void enableNormals();
 	void enableTexCoords();
@@ -109,6 +109,46 @@ enum ofPolyWindingMode{
 	OF_POLY_WINDING_ABS_GEQ_TWO
 };
 
+/// \brief Boolean operations between the areas of two sets of polygons.
+///
+/// \sa ofTessellator::clipToPolylines()
+/// \sa ofPath::clip()
+enum ofPolyClipType{
+	/// \brief Area covered by any of both sets.
+	OF_POLY_CLIP_UNION,
+	/// \brief Area covered by both sets.
+	OF_POLY_CLIP_INTERSECTION,
+	/// \brief Area of the first set not covered by the second one.
+	OF_POLY_CLIP_DIFFERENCE,
+	/// \brief Area covered by only one of both sets.
+	OF_POLY_CLIP_XOR
+};
+
+/// \brief Shape used to join the segments of a thick line.
+///
+/// \sa ofStrokeStyle
+enum ofLineJoin{
+	/// \brief Extends the outer edges until they meet, falls back to a
+	/// bevel when the miter is longer than the miter limit.
+	OF_LINE_JOIN_MITER,
+	/// \brief Rounds the outer corner with a circle.
+	OF_LINE_JOIN_ROUND,
+	/// \brief Cuts the outer corner with a straight line.
+	OF_LINE_JOIN_BEVEL
+};
+
+/// \brief Shape used at the ends of an open thick line.
+///
+/// \sa ofStrokeStyle
+enum ofLineCap{
+	/// \brief Ends the line exactly at its end points.
+	OF_LINE_CAP_BUTT,
+	/// \brief Adds half a circle at each end.
+	OF_LINE_CAP_ROUND,
+	/// \brief Extends the line by half its width at each end.
+	OF_LINE_CAP_SQUARE
+};
+
 /// \brief represents the available matrix coordinate system handednesses.
 ///
 /// \sa ofMatrixStack
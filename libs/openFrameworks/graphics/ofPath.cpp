@@ -1,4 +1,7 @@
 #include "ofPath.h"
+#include "ofTessellationCache.h"
+#include "ofTaskPool.h"
+#include <atomic>
 
 using namespace std;
 
@@ -41,17 +44,21 @@ ofPath::Command::Command(Type type , const glm::vec3 & centre, float radiusX, fl
 
 //----------------------------------------------------------
 ofPath::ofPath(){
-	strokeWidth = 0;
+	strokeStyle.width = 0;
 	bFill = true;
 	windingMode = OF_POLY_WINDING_ODD;
 	prevCurveRes = 20;
 	curveResolution = 20;
 	circleResolution = 20;
+	curveTolerance = 0;
+	curveScale = 1;
+	prevCurveScale = 1;
 	mode = COMMANDS;
 	bNeedsTessellation = false;
 	bHasChanged = false;
 	bUseShapeColor = true;
 	bNeedsPolylinesGeneration = false;
+	bNeedsStroke = false;
 	clear();
 }
 
@@ -63,6 +70,8 @@ void ofPath::clear(){
 	polylines.resize(1);
 	polylines[0].clear();
 	cachedTessellation.clear();
+	sharedTessellation.reset();
+	cachedStroke.clear();
 	flagShapeChanged();
 }
 
@@ -71,6 +80,7 @@ void ofPath::newSubPath(){
 	if(mode==COMMANDS){
 	}else{
 		polylines.push_back(ofPolyline());
+		polylines.back().setCurveTolerance(getPolylineCurveTolerance());
 	}
 }
 
@@ -498,6 +508,7 @@ void ofPath::setPolyWindingMode(ofPolyWindingMode newMode){
 	if(windingMode != newMode){
 		windingMode = newMode;
 		bNeedsTessellation = true;
+		bNeedsStroke = true;
 	}
 }
 
@@ -511,13 +522,28 @@ void ofPath::setFilled(bool hasFill){
 
 //----------------------------------------------------------
 void ofPath::setStrokeWidth(float width){
-	strokeWidth = width;
+	if(strokeStyle.width != width){
+		strokeStyle.width = width;
+		bNeedsStroke = true;
+	}
+}
+
+//----------------------------------------------------------
+void ofPath::setStrokeStyle(const ofStrokeStyle & style){
+	strokeStyle = style;
+	bNeedsStroke = true;
+}
+
+//----------------------------------------------------------
+const ofStrokeStyle & ofPath::getStrokeStyle() const{
+	return strokeStyle;
 }
 
 //----------------------------------------------------------
 ofPolyline & ofPath::lastPolyline(){
 	if(polylines.empty() || polylines.back().isClosed()){
 		polylines.push_back(ofPolyline());
+		polylines.back().setCurveTolerance(getPolylineCurveTolerance());
 	}
 	return polylines.back();
 }
@@ -562,14 +588,17 @@ ofColor ofPath::getStrokeColor() const{
 
 //----------------------------------------------------------
 float ofPath::getStrokeWidth() const{
-	return strokeWidth;
+	return strokeStyle.width;
 }
 
 //----------------------------------------------------------
 void ofPath::generatePolylinesFromCommands(){
 	if(mode==POLYLINES || commands.empty()) return;
-	if(bNeedsPolylinesGeneration || curveResolution!=prevCurveRes){
+	bool scaleChanged = curveTolerance>0 && curveScale!=prevCurveScale;
+	if(bNeedsPolylinesGeneration || curveResolution!=prevCurveRes || scaleChanged){
 		prevCurveRes = curveResolution;
+		prevCurveScale = curveScale;
+		float polylineCurveTolerance = getPolylineCurveTolerance();
 
 		polylines.clear();
 		int j=-1;
@@ -579,6 +608,7 @@ void ofPath::generatePolylinesFromCommands(){
 			case Command::moveTo:
 				polylines.push_back(ofPolyline());
 				j++;
+				polylines[j].setCurveTolerance(polylineCurveTolerance);
 				polylines[j].addVertex(commands[i].to);
 				break;
 			case Command::lineTo:
@@ -607,6 +637,7 @@ void ofPath::generatePolylinesFromCommands(){
 
 		bNeedsPolylinesGeneration = false;
 		bNeedsTessellation = true;
+		bNeedsStroke = true;
 	}
 }
 
@@ -615,7 +646,15 @@ void ofPath::tessellate(){
 	generatePolylinesFromCommands();
 	if(!bNeedsTessellation || polylines.empty() || std::all_of(polylines.begin(), polylines.end(), [](const ofPolyline & p) {return p.getVertices().empty();})) return;
 	if(bFill){
-		tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
+		if(ofTessellationCache::isEnabled()){
+			sharedTessellation = ofTessellationCache::get(polylines, windingMode, [this](ofMesh & mesh){
+				tessellator.tessellateToMesh( polylines, windingMode, mesh);
+			});
+			cachedTessellation.clear();
+		}else{
+			sharedTessellation.reset();
+			tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
+		}
 	}
 	if(hasOutline() && windingMode!=OF_POLY_WINDING_ODD){
 		tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
@@ -637,16 +676,53 @@ const vector<ofPolyline> & ofPath::getOutline() const{
 //----------------------------------------------------------
 const ofMesh & ofPath::getTessellation() const{
 	const_cast<ofPath*>(this)->tessellate();
+	if(sharedTessellation){
+		return *sharedTessellation;
+	}
 	return cachedTessellation;
 }
 
+//----------------------------------------------------------
+void ofPath::generateStroke(){
+	// the outline might regenerate the polylines and flag the stroke
+	auto & outline = getOutline();
+	if(!bNeedsStroke) return;
+	if(hasOutline()){
+		ofStroker stroker;
+		stroker.strokeToMesh(outline, strokeStyle, cachedStroke);
+	}else{
+		cachedStroke.clear();
+	}
+	bNeedsStroke = false;
+}
+
+//----------------------------------------------------------
+const ofMesh & ofPath::getStrokeMesh() const{
+	const_cast<ofPath*>(this)->generateStroke();
+	return cachedStroke;
+}
+
+//----------------------------------------------------------
+// scale of the model view matrix, for 2d drawing with the default
+// screen setup that's the number of pixels per path unit
+static float getCurrentCurveScale(){
+	auto modelView = ofGetCurrentRenderer()->getCurrentMatrix(OF_MATRIX_MODELVIEW);
+	return std::max(glm::length(glm::vec3(modelView[0])), glm::length(glm::vec3(modelView[1])));
+}
+
 //----------------------------------------------------------
 void ofPath::draw(float x, float y) const{
+	if(curveTolerance>0){
+		const_cast<ofPath*>(this)->setCurveScale(getCurrentCurveScale());
+	}
 	ofGetCurrentRenderer()->draw(*this,x,y);
 }
 
 //----------------------------------------------------------
 void ofPath::draw() const{
+	if(curveTolerance>0){
+		const_cast<ofPath*>(this)->setCurveScale(getCurrentCurveScale());
+	}
 	ofGetCurrentRenderer()->draw(*this);
 }
 
@@ -657,6 +733,7 @@ void ofPath::flagShapeChanged(){
 		bNeedsPolylinesGeneration = true;
 	}else{
 		bNeedsTessellation = true;
+		bNeedsStroke = true;
 	}
 }
 
@@ -700,6 +777,53 @@ int ofPath::getCircleResolution() const {
 	return circleResolution;
 }
 
+//----------------------------------------------------------
+void ofPath::setCurveTolerance(float tolerance){
+	if(curveTolerance != tolerance){
+		curveTolerance = tolerance;
+		if(mode==POLYLINES){
+			for(auto & polyline: polylines){
+				polyline.setCurveTolerance(getPolylineCurveTolerance());
+			}
+		}
+		flagShapeChanged();
+	}
+}
+
+//----------------------------------------------------------
+float ofPath::getCurveTolerance() const {
+	return curveTolerance;
+}
+
+//----------------------------------------------------------
+void ofPath::setCurveScale(float scale){
+	if(scale <= 0){
+		return;
+	}
+	// keep the current scale until the new one is more than half an octave
+	// away so small changes in scale don't regenerate the polylines
+	float ratio = scale / curveScale;
+	if(ratio >= 1.f / sqrt(2.f) && ratio <= sqrt(2.f)){
+		return;
+	}
+	curveScale = scale;
+	if(mode==POLYLINES){
+		for(auto & polyline: polylines){
+			polyline.setCurveTolerance(getPolylineCurveTolerance());
+		}
+	}
+}
+
+//----------------------------------------------------------
+float ofPath::getCurveScale() const {
+	return curveScale;
+}
+
+//----------------------------------------------------------
+float ofPath::getPolylineCurveTolerance() const {
+	return curveTolerance>0 ? curveTolerance / curveScale : 0;
+}
+
 //----------------------------------------------------------
 void ofPath::setArcResolution(int res){
 	circleResolution = res;
@@ -761,6 +885,36 @@ void ofPath::simplify(float tolerance){
 	}
 }
 
+//----------------------------------------------------------
+void ofPath::clip(const ofPath & path, ofPolyClipType clipType){
+	generatePolylinesFromCommands();
+	const_cast<ofPath&>(path).generatePolylinesFromCommands();
+	vector<ofPolyline> contours;
+	tessellator.clipToPolylines(polylines, windingMode, path.polylines, path.windingMode, clipType, contours);
+	setClippedPolylines(contours);
+}
+
+//----------------------------------------------------------
+void ofPath::offset(float delta, ofLineJoin join, float miterLimit){
+	generatePolylinesFromCommands();
+	float roundTolerance = curveTolerance>0 ? getPolylineCurveTolerance() : 0.25f;
+	vector<ofPolyline> contours;
+	tessellator.offsetToPolylines(polylines, windingMode, delta, contours, join, miterLimit, roundTolerance);
+	setClippedPolylines(contours);
+}
+
+//----------------------------------------------------------
+void ofPath::setClippedPolylines(vector<ofPolyline> & contours){
+	commands.clear();
+	mode = POLYLINES;
+	windingMode = OF_POLY_WINDING_ODD;
+	polylines.swap(contours);
+	if(polylines.empty()){
+		polylines.resize(1);
+	}
+	flagShapeChanged();
+}
+
 //----------------------------------------------------------
 void ofPath::translate(const glm::vec3 & p){
 	if(mode==COMMANDS){
@@ -884,3 +1038,56 @@ void ofPath::addCommand(const ofPath::Command & command){
 	}
 	commands.push_back(command);
 }
+
+//----------------------------------------------------------
+void ofTessellateAll(const vector<ofPath*> & paths, function<void(size_t, size_t)> progress){
+	size_t total = paths.size();
+#if defined(TARGET_EMSCRIPTEN)
+	// the tessellator is shared by all paths without threads
+	size_t numThreads = 1;
+#else
+	size_t numThreads = std::min<size_t>(ofGetTaskPool().getNumThreads() + 1, total);
+#endif
+
+	// paths are handed out one by one since their complexity varies a lot,
+	// the calling thread works too and reports the progress as it goes
+	atomic<size_t> next(0);
+	atomic<size_t> done(0);
+	size_t reported = 0;
+	auto work = [&](bool reportProgress){
+		size_t i;
+		while((i = next++) < total){
+			if(paths[i]){
+				paths[i]->tessellate();
+			}
+			size_t numDone = ++done;
+			if(reportProgress && progress){
+				progress(numDone, total);
+				reported = numDone;
+			}
+		}
+	};
+
+	ofTaskGroup workers;
+	for(size_t i = 1; i < numThreads; i++){
+		workers.run([&work]{
+			work(false);
+		});
+	}
+	work(true);
+	workers.wait();
+	if(progress && reported < total){
+		progress(total, total);
+	}
+}
+
+//----------------------------------------------------------
+void ofTessellateAll(vector<ofPath> & paths, function<void(size_t, size_t)> progress){
+	vector<ofPath*> pointers;
+	pointers.reserve(paths.size());
+	for(auto & path: paths){
+		pointers.push_back(&path);
+	}
+	ofTessellateAll(pointers, progress);
+}
+
@@ -5,6 +5,7 @@
 #include "ofPolyline.h"
 #include "ofVboMesh.h"
 #include "ofTessellator.h"
+#include "ofStroker.h"
 
 /// \class
 
@@ -286,7 +287,14 @@ public:
 	/// The default value is `0
 	float getStrokeWidth() const;
 
-	bool hasOutline() const { return strokeWidth>0; }
+	bool hasOutline() const { return strokeStyle.width>0; }
+
+	/// \brief Sets the joins, caps, miter limit and dashes used to stroke
+	/// the outline, including its width.
+	///
+	/// \sa ofStroker
+	void setStrokeStyle(const ofStrokeStyle & style);
+	const ofStrokeStyle & getStrokeStyle() const;
 
 	void setCurveResolution(int curveResolution);
 	int getCurveResolution() const;
@@ -297,6 +305,30 @@ public:
 	OF_DEPRECATED_MSG("Use setCircleResolution instead.", void setArcResolution(int res));
 	OF_DEPRECATED_MSG("Use getCircleResolution instead.", int getArcResolution() const);
 
+	/// \brief Flattens curves and arcs adaptively so the outline is never
+	/// further than `tolerance` pixels from the exact shape.
+	///
+	/// Small curves get a few vertices and big ones enough to stay smooth,
+	/// instead of the same curve and circle resolution for all. The
+	/// tolerance is converted to path units with the curve scale, which
+	/// draw() estimates from the current model view matrix. The polylines
+	/// are only regenerated when the scale changes by more than half an
+	/// octave so animating a zoom doesn't flatten the path every frame.
+	///
+	/// The default of 0 uses the curve and circle resolutions.
+	///
+	/// \sa ofPolyline::setCurveTolerance()
+	void setCurveTolerance(float tolerance);
+	float getCurveTolerance() const;
+
+	/// \brief Sets the scale from path units to pixels used to convert the
+	/// curve tolerance, for paths that are used through getOutline() or
+	/// getTessellation() instead of draw(). The current scale is kept until
+	/// the new one differs from it by more than half an octave, so the
+	/// deviation on screen stays within sqrt(2) times the tolerance.
+	void setCurveScale(float scale);
+	float getCurveScale() const;
+
 	void setUseShapeColor(bool useColor);
 	bool getUseShapeColor() const;
 
@@ -319,10 +351,40 @@ public:
 
 	void tessellate();
 
+	/// \brief Get the filled shape as triangles.
+	///
+	/// Paths with the same geometry share the same mesh through
+	/// ofTessellationCache.
 	const ofMesh & getTessellation() const;
 
+	/// \brief Get the outline stroked into a triangle strip mesh with the
+	/// stroke style of the path.
+	///
+	/// The mesh is cached and only regenerated when the shape or its stroke
+	/// style change. ofGLProgrammableRenderer uses it to draw outlines wider
+	/// than 1 since core profile OpenGL doesn't support wide lines.
+	const ofMesh & getStrokeMesh() const;
+
 	void simplify(float tolerance=0.3f);
 
+	/// \brief Replaces the path with the result of a boolean operation
+	/// between its filled area and the one of another path.
+	///
+	/// The path changes to POLYLINES mode with OF_POLY_WINDING_ODD, the
+	/// resulting contours don't intersect each other so the outline can be
+	/// drawn without tessellating it first.
+	///
+	/// \sa ofTessellator::clipToPolylines()
+	void clip(const ofPath & path, ofPolyClipType clipType);
+
+	/// \brief Grows the filled area of the path by delta, or shrinks it if
+	/// delta is negative, replacing the path like clip().
+	///
+	/// Round joins use the curve tolerance if set or a quarter of a unit.
+	///
+	/// \sa ofTessellator::offsetToPolylines()
+	void offset(float delta, ofLineJoin join=OF_LINE_JOIN_MITER, float miterLimit=4);
+
 	void translate(const glm::vec3 & p);
 
 	void rotateDeg(float degrees, const glm::vec3& axis);
@@ -399,18 +461,24 @@ private:
 	ofPolyline & lastPolyline();
 	void addCommand(const Command & command);
 	void generatePolylinesFromCommands();
+	void generateStroke();
+	void setClippedPolylines(std::vector<ofPolyline> & contours);
 
 	// only needs to be called when path is modified externally
 	void flagShapeChanged();
 	bool hasChanged();
 
+	// tolerance in path units for the polylines generated at the
+	// current curve scale
+	float getPolylineCurveTolerance() const;
+
 	// path description
 	//vector<ofSubPath>		paths;
 	std::vector<Command> 	commands;
 	ofPolyWindingMode 	windingMode;
 	ofColor 			fillColor;
 	ofColor				strokeColor;
-	float				strokeWidth;
+	ofStrokeStyle		strokeStyle;
 	bool				bFill;
 	bool				bUseShapeColor;
 
@@ -420,9 +488,14 @@ private:
 
 #ifdef TARGET_OPENGLES
 	ofMesh				cachedTessellation;
+	ofMesh				cachedStroke;
 #else
 	ofVboMesh			cachedTessellation;
+	ofVboMesh			cachedStroke;
 #endif
+	// shared with other paths with the same geometry through
+	// ofTessellationCache, used instead of cachedTessellation when set
+	std::shared_ptr<const ofMesh> sharedTessellation;
 #if defined(TARGET_EMSCRIPTEN)
 	static ofTessellator tessellator;
 #elif HAS_TLS
@@ -434,8 +507,31 @@ private:
 	int					prevCurveRes;
 	int					curveResolution;
 	int					circleResolution;
+	float				curveTolerance;
+	float				curveScale;
+	float				prevCurveScale;
 	bool 				bNeedsTessellation;
 	bool				bNeedsPolylinesGeneration;
+	bool				bNeedsStroke;
 
 	Mode				mode;
 };
+
+/// \brief Tessellates many paths at once, spreading them over all the
+/// available cores.
+///
+/// Each worker uses its own thread local ofTessellator and stores the
+/// result in the path, so drawing them or calling getTessellation() later
+/// doesn't need to tessellate again. This is useful to prepare big vector
+/// assets, like an svg with thousands of paths, before they are first drawn
+/// or from a thread other than the one drawing them. The paths can't be
+/// used from other threads until it returns.
+///
+/// progress, if set, is called from the calling thread with the number of
+/// paths already tessellated and the total.
+void ofTessellateAll(const std::vector<ofPath*> & paths, std::function<void(std::size_t done, std::size_t total)> progress = nullptr);
+
+/// \brief Tessellates a vector of paths at once.
+///
+/// \sa ofTessellateAll(const std::vector<ofPath*> &, std::function<void(std::size_t, std::size_t)>)
+void ofTessellateAll(std::vector<ofPath> & paths, std::function<void(std::size_t done, std::size_t total)> progress = nullptr);
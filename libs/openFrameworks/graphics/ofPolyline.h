@@ -4,8 +4,10 @@
 #define OF_POLYLINE_H
 
 #include "ofConstants.h"
+#include "ofPolylineIndex.h"
 #include "glm/fwd.hpp"
 #include <deque>
+#include <memory>
 
 /// \file
 /// ofPolyLine allows you to combine multiple points into a single vector data
@@ -55,6 +57,8 @@ class ofRectangle;
 template<class T>
 class ofPolyline_ {
 public:
+	using Intersection = typename ofPolylineIndex_<T>::Intersection;
+
 	/// \name Constructors
 	/// \{
 
@@ -313,6 +317,21 @@ public:
 		quadBezierTo(cx1,cy1,0,cx2,cy2,0,x,y,0,curveResolution);
 	}
 
+	/// \brief Flattens curves and arcs adaptively instead of using a fixed
+	/// resolution.
+	///
+	/// When the tolerance is bigger than 0, bezierTo(), quadBezierTo() and
+	/// curveTo() subdivide each curve where it bends the most until the
+	/// line is never further than `tolerance` from the exact curve, and
+	/// arc() uses the smallest number of segments that keeps the same
+	/// error. The curveResolution and circleResolution arguments are
+	/// ignored in that case. Small curves get just a few vertices while big
+	/// ones stay smooth.
+	///
+	/// The default of 0 uses the fixed resolutions.
+	void setCurveTolerance(float tolerance);
+	float getCurveTolerance() const;
+
 	/// \}
 	/// \name Smoothing and Resampling
 	/// \{
@@ -403,6 +422,20 @@ public:
 	/// \brief Tests whether the T is within a closed ofPolyline.
 	bool inside(const T & p) const;
 
+	/// \brief Tests whether the T is within a closed ofPolyline using a
+	/// winding rule, OF_POLY_WINDING_ODD is the same as inside(p).
+	bool inside(const T & p, ofPolyWindingMode mode) const;
+
+	/// \brief Tests a batch of points, in parallel for big batches.
+	///
+	/// Always uses the spatial index, even if setUseSpatialIndex() wasn't
+	/// called.
+	std::vector<bool> inside(const std::vector<T> & points, ofPolyWindingMode mode = OF_POLY_WINDING_ODD) const;
+
+	/// \brief Gets the winding number of the polyline around the x,y
+	/// coordinates of p, treating it as closed.
+	int getWindingNumber(const T & p) const;
+
 	/// \brief Get the bounding box of the polyline , taking into account
 	/// all the points to determine the extents of the polyline.
 	ofRectangle getBoundingBox() const;
@@ -423,6 +456,39 @@ public:
 	/// index of the closest vertex
 	T getClosestPoint(const T& target, unsigned int* nearestIndex = nullptr) const;
 
+	/// \brief Gets the closest point on the line for every target, in
+	/// parallel for big batches.
+	///
+	/// Always uses the spatial index, even if setUseSpatialIndex() wasn't
+	/// called.
+	std::vector<T> getClosestPoints(const std::vector<T>& targets, std::vector<unsigned int>* nearestIndices = nullptr) const;
+
+	/// \brief Gets the points where the segment from p0 to p1 crosses the
+	/// line on the xy plane, sorted from p0 to p1.
+	///
+	/// Always uses the spatial index, even if setUseSpatialIndex() wasn't
+	/// called.
+	std::vector<Intersection> getIntersections(const T& p0, const T& p1) const;
+
+	/// \}
+	/// \name Spatial Index
+	/// \{
+
+	/// \brief Accelerates getClosestPoint() and inside() with a tree over
+	/// the segments of the line.
+	///
+	/// Queries become logarithmic instead of linear in the number of
+	/// vertices, which pays off when testing many points against lines
+	/// with thousands of vertices. The index is built the first time it's
+	/// needed and rebuilt after the line changes so it's not worth it for
+	/// lines that change between every query.
+	void setUseSpatialIndex(bool useSpatialIndex);
+	bool isUsingSpatialIndex() const;
+
+	/// \brief Gets the spatial index for the current vertices, building
+	/// it if needed.
+	const ofPolylineIndex_<T> & getSpatialIndex() const;
+
 
 	/// \}
 	/// \name Other Functions
@@ -537,11 +603,17 @@ private:
 
 	std::deque<T> curveVertices;
 	std::vector<T> circlePoints;
+	float curveTolerance;
 
 	bool bClosed;
 	bool bHasChanged;   // public API has access to this
 	mutable bool bCacheIsDirty;   // used only internally, no public API to read
 
+	bool bUseSpatialIndex;
+	// shared between copies since it's never modified once built,
+	// flagHasChanged() drops it
+	mutable std::shared_ptr<ofPolylineIndex_<T>> spatialIndex;
+
 	void updateCache(bool bForceUpdate = false) const;
 
 	// given an interpolated index (e.g. 5.75) return neighboring indices and interolation factor (e.g. 5, 6, 0.75)
@@ -13,6 +13,8 @@
 //----------------------------------------------------------
 template<class T>
 ofPolyline_<T>::ofPolyline_(){
+    bUseSpatialIndex = false;
+    curveTolerance = 0;
     setRightVector();
 	clear();
 }
@@ -20,6 +22,8 @@ ofPolyline_<T>::ofPolyline_(){
 //----------------------------------------------------------
 template<class T>
 ofPolyline_<T>::ofPolyline_(const std::vector<T>& verts){
+    bUseSpatialIndex = false;
+    curveTolerance = 0;
     setRightVector();
 	clear();
 	addVertices(verts);
@@ -154,6 +158,7 @@ template<class T>
 void ofPolyline_<T>::flagHasChanged() {
     bHasChanged = true;
     bCacheIsDirty = true;
+    spatialIndex.reset();
 }
 
 //----------------------------------------------------------
@@ -197,6 +202,63 @@ float ofPolyline_<T>::wrapAngle(float angleRadians) {
 	return ofWrap(angleRadians, 0.0f, TWO_PI);
 }
 
+//----------------------------------------------------------
+namespace of{
+	namespace priv{
+		// maximum number of times a curve is halved when flattening with a
+		// tolerance, 2^16 segments at most
+		const int maxCurveSubdivisions = 16;
+
+		// Flattens a cubic bezier adding every point but the first one.
+		// The curve is halved until it's flat enough: its distance to the
+		// chord is at most 3/4 of the distance from the inner control points
+		// to their position on a straight line, so segments are only split
+		// where the curve bends.
+		template<class T>
+		void flattenBezier(std::vector<T> & points, const glm::vec3 & p0, const glm::vec3 & p1, const glm::vec3 & p2, const glm::vec3 & p3, float tolerance){
+			struct Bezier{
+				glm::vec3 p0, p1, p2, p3;
+				int depth;
+			};
+			float maxDeviation2 = (tolerance / 0.75f) * (tolerance / 0.75f);
+			std::vector<Bezier> stack;
+			stack.push_back({p0, p1, p2, p3, 0});
+			while(!stack.empty()){
+				auto b = stack.back();
+				stack.pop_back();
+				auto d1 = b.p1 - (2.f * b.p0 + b.p3) / 3.f;
+				auto d2 = b.p2 - (b.p0 + 2.f * b.p3) / 3.f;
+				if(b.depth >= maxCurveSubdivisions || std::max(glm::length2(d1), glm::length2(d2)) <= maxDeviation2){
+					points.emplace_back(b.p3.x, b.p3.y, b.p3.z);
+					continue;
+				}
+				// split in half with de Casteljau, the first half goes on top
+				// of the stack so points are added in order
+				auto p01 = (b.p0 + b.p1) * 0.5f;
+				auto p12 = (b.p1 + b.p2) * 0.5f;
+				auto p23 = (b.p2 + b.p3) * 0.5f;
+				auto p012 = (p01 + p12) * 0.5f;
+				auto p123 = (p12 + p23) * 0.5f;
+				auto mid = (p012 + p123) * 0.5f;
+				stack.push_back({mid, p123, p23, b.p3, b.depth + 1});
+				stack.push_back({b.p0, p01, p012, mid, b.depth + 1});
+			}
+		}
+
+		// circle resolution for which the chords of an arc are never further
+		// than tolerance from it, from the sagitta r * (1 - cos(angle / 2))
+		inline int getCircleResolutionForTolerance(float radius, float tolerance){
+			const int minResolution = 8;
+			const int maxResolution = 1 << maxCurveSubdivisions;
+			if(radius <= tolerance){
+				return minResolution;
+			}
+			float maxSegmentAngle = 2.f * acos(1.f - tolerance / radius);
+			return ofClamp(ceil(M_TWO_PI / maxSegmentAngle), minResolution, maxResolution);
+		}
+	}
+}
+
 //----------------------------------------------------------
 template<class T>
 void ofPolyline_<T>::bezierTo( const T & cp1, const T & cp2, const T & to, int curveResolution ){
@@ -205,9 +267,12 @@ void ofPolyline_<T>::bezierTo( const T & cp1, const T & cp2, const T & to, int c
 	curveVertices.clear();
     
 	// the resolultion with which we computer this bezier
-	// is arbitrary, can we possibly make it dynamic?
+	// is arbitrary unless a curve tolerance is set
     
-	if (size() > 0){
+	if (size() > 0 && curveTolerance > 0){
+		glm::vec3 from = toGlm(points.back());
+		of::priv::flattenBezier(points, from, toGlm(cp1), toGlm(cp2), toGlm(to), curveTolerance);
+	}else if (size() > 0){
 		float x0 = points[size()-1].x;
 		float y0 = points[size()-1].y;
 		float z0 = points[size()-1].z;
@@ -248,6 +313,17 @@ void ofPolyline_<T>::bezierTo( const T & cp1, const T & cp2, const T & to, int c
 template<class T>
 void ofPolyline_<T>::quadBezierTo(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, int curveResolution){
 	curveVertices.clear();
+	if(curveTolerance > 0){
+		// same curve as a cubic bezier with control points 2/3 of the way
+		// to the quadratic one
+		glm::vec3 p0(x1, y1, z1);
+		glm::vec3 p1(x2, y2, z2);
+		glm::vec3 p2(x3, y3, z3);
+		points.emplace_back(x1, y1, z1);
+		of::priv::flattenBezier(points, p0, p0 + (p1 - p0) * (2.f / 3.f), p2 + (p1 - p2) * (2.f / 3.f), p2, curveTolerance);
+		flagHasChanged();
+		return;
+	}
 	for(int i=0; i <= curveResolution; i++){
 		double t = (double)i / (double)(curveResolution);
 		double a = (1.0 - t)*(1.0 - t);
@@ -267,7 +343,15 @@ void ofPolyline_<T>::curveTo( const T & to, int curveResolution ){
     
 	curveVertices.push_back(to);
     
-	if (curveVertices.size() == 4){
+	if (curveVertices.size() == 4 && curveTolerance > 0){
+		// a catmull rom segment is a bezier between the 2 inner points
+		auto & p0 = toGlm(curveVertices[0]);
+		auto & p1 = toGlm(curveVertices[1]);
+		auto & p2 = toGlm(curveVertices[2]);
+		auto & p3 = toGlm(curveVertices[3]);
+		of::priv::flattenBezier(points, p1, p1 + (p2 - p0) / 6.f, p2 - (p3 - p1) / 6.f, p2, curveTolerance);
+		curveVertices.pop_front();
+	}else if (curveVertices.size() == 4){
         
 		float x0 = curveVertices[0].x;
 		float y0 = curveVertices[0].y;
@@ -317,6 +401,11 @@ void ofPolyline_<T>::curveTo( const T & to, int curveResolution ){
 template<class T>
 void ofPolyline_<T>::arc(const T & center, float radiusX, float radiusY, float angleBegin, float angleEnd, bool clockwise, int circleResolution){
     
+    if(curveTolerance > 0){
+        // the ellipse is a circle of the biggest radius squashed along
+        // one axis which can only make the error smaller
+        circleResolution = of::priv::getCircleResolutionForTolerance(std::max(std::abs(radiusX), std::abs(radiusY)), curveTolerance);
+    }
     if(circleResolution<=1) circleResolution=2;
     setCircleResolution(circleResolution);
     points.reserve(points.size()+circleResolution);
@@ -412,6 +501,18 @@ void ofPolyline_<T>::arc(const T & center, float radiusX, float radiusY, float a
     flagHasChanged();
 }
 
+//----------------------------------------------------------
+template<class T>
+void ofPolyline_<T>::setCurveTolerance(float tolerance){
+	curveTolerance = tolerance;
+}
+
+//----------------------------------------------------------
+template<class T>
+float ofPolyline_<T>::getCurveTolerance() const{
+	return curveTolerance;
+}
+
 //----------------------------------------------------------
 template<class T>
 float ofPolyline_<T>::getPerimeter() const {
@@ -565,6 +666,10 @@ template<class T>
 // a much faster but less accurate version would check distances to vertices first,
 // which assumes vertices are evenly spaced
 T ofPolyline_<T>::getClosestPoint(const T& target, unsigned int* nearestIndex) const {
+	if(bUseSpatialIndex) {
+		return getSpatialIndex().getClosestPoint(target, nearestIndex);
+	}
+
 	const ofPolyline_ & polyline = *this;
     
 	if(polyline.size() < 2) {
@@ -621,6 +726,10 @@ bool ofPolyline_<T>::inside(const T & p, const ofPolyline_ & polyline){
 //--------------------------------------------------
 template<class T>
 bool ofPolyline_<T>::inside(float x, float y, const ofPolyline_ & polyline){
+	if(polyline.bUseSpatialIndex) {
+		return polyline.getSpatialIndex().inside(x, y);
+	}
+
 	int counter = 0;
 	int i;
 	double xinters;
@@ -662,6 +771,68 @@ bool ofPolyline_<T>::inside(const T & p) const {
 	return ofPolyline_<T>::inside(p, *this);
 }
 
+//--------------------------------------------------
+template<class T>
+bool ofPolyline_<T>::inside(const T & p, ofPolyWindingMode mode) const {
+	return of::priv::isInsideWinding(getWindingNumber(p), mode);
+}
+
+//--------------------------------------------------
+template<class T>
+std::vector<bool> ofPolyline_<T>::inside(const std::vector<T> & points, ofPolyWindingMode mode) const {
+	return getSpatialIndex().inside(points, mode);
+}
+
+//--------------------------------------------------
+template<class T>
+int ofPolyline_<T>::getWindingNumber(const T & p) const {
+	if(bUseSpatialIndex) {
+		return getSpatialIndex().getWindingNumber(p.x, p.y);
+	}
+
+	int winding = 0;
+	for(size_t i = 0; i < points.size(); i++) {
+		winding += of::priv::getWindingCrossing(toGlm(points[i]), toGlm(points[(i + 1) % points.size()]), p.x, p.y);
+	}
+	return winding;
+}
+
+//--------------------------------------------------
+template<class T>
+std::vector<T> ofPolyline_<T>::getClosestPoints(const std::vector<T>& targets, std::vector<unsigned int>* nearestIndices) const {
+	return getSpatialIndex().getClosestPoints(targets, nearestIndices);
+}
+
+//--------------------------------------------------
+template<class T>
+std::vector<typename ofPolyline_<T>::Intersection> ofPolyline_<T>::getIntersections(const T& p0, const T& p1) const {
+	return getSpatialIndex().getIntersections(p0, p1);
+}
+
+//--------------------------------------------------
+template<class T>
+void ofPolyline_<T>::setUseSpatialIndex(bool useSpatialIndex) {
+	bUseSpatialIndex = useSpatialIndex;
+	if(!bUseSpatialIndex) {
+		spatialIndex.reset();
+	}
+}
+
+//--------------------------------------------------
+template<class T>
+bool ofPolyline_<T>::isUsingSpatialIndex() const {
+	return bUseSpatialIndex;
+}
+
+//--------------------------------------------------
+template<class T>
+const ofPolylineIndex_<T> & ofPolyline_<T>::getSpatialIndex() const {
+	if(!spatialIndex) {
+		spatialIndex = std::make_shared<ofPolylineIndex_<T>>(points, bClosed);
+	}
+	return *spatialIndex;
+}
+
 
 
 //--------------------------------------------------
@@ -0,0 +1,496 @@
+#pragma once
+
+#include "ofGraphicsConstants.h"
+#include "ofVectorMath.h"
+#include "ofParallel.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	/// Returns +1 or -1 if a ray from (x,y) towards +x crosses the segment
+	/// going up or down, 0 otherwise. Uses the same half open rules as
+	/// ofPolyline_::inside() so even-odd results match it exactly.
+	inline int getWindingCrossing(const glm::vec3 & p1, const glm::vec3 & p2, float x, float y){
+		if(y > std::min(p1.y, p2.y) && y <= std::max(p1.y, p2.y) && x <= std::max(p1.x, p2.x) && p1.y != p2.y){
+			float xinters = (y - p1.y) * (p2.x - p1.x) / (p2.y - p1.y) + p1.x;
+			if(p1.x == p2.x || x <= xinters){
+				return p2.y > p1.y ? 1 : -1;
+			}
+		}
+		return 0;
+	}
+
+	inline bool isInsideWinding(int winding, ofPolyWindingMode mode){
+		switch(mode){
+		case OF_POLY_WINDING_ODD:
+			return winding % 2 != 0;
+		case OF_POLY_WINDING_NONZERO:
+			return winding != 0;
+		case OF_POLY_WINDING_POSITIVE:
+			return winding > 0;
+		case OF_POLY_WINDING_NEGATIVE:
+			return winding < 0;
+		case OF_POLY_WINDING_ABS_GEQ_TWO:
+			return winding >= 2 || winding <= -2;
+		}
+		return false;
+	}
+
+	template<class F>
+	void parallelForPolylineQueries(std::size_t size, F f){
+		const std::size_t minRangeSize = 1 << 10;
+		ofParallelForRange(0, size, minRangeSize, f);
+	}
+}
+}
+/*! \endcond */
+
+/// \brief A bounding volume hierarchy over the segments of a polyline.
+///
+/// ofPolylineIndex_ accelerates closest point, point in polygon and
+/// segment intersection queries against polylines with many vertices.
+/// Instead of testing every segment each query only visits the segments
+/// whose bounding boxes are close to the query point or line.
+///
+/// Usually there's no need to use this class directly, calling
+/// ofPolyline::setUseSpatialIndex(true) builds one lazily the first
+/// time it's needed and rebuilds it whenever the polyline changes.
+///
+/// ~~~~{.cpp}
+/// contour.setUseSpatialIndex(true);
+/// auto closest = contour.getClosestPoints(trackedPoints);
+/// auto inside = contour.inside(trackedPoints);
+/// ~~~~
+///
+/// The index is immutable once built, so it can be queried from several
+/// threads at the same time.
+template<class T>
+class ofPolylineIndex_{
+public:
+	/// \brief Crossing between a line segment and the polyline.
+	struct Intersection{
+		T position;
+		/// Interpolated index of the crossing along the polyline, e.g. 5.75
+		/// is 75% along the segment between the 5th and 6th points.
+		float index;
+		/// Position of the crossing along the query segment from 0 to 1.
+		float t;
+	};
+
+	ofPolylineIndex_(){}
+	ofPolylineIndex_(const std::vector<T> & points, bool closed){
+		build(points, closed);
+	}
+
+	/// \brief Builds the tree from the vertices of a polyline.
+	void build(const std::vector<T> & points, bool closed);
+
+	void clear();
+	bool empty() const;
+
+	/// \returns the number of segments used for closest point and
+	/// intersection queries, the closing segment only counts if the
+	/// polyline is closed.
+	std::size_t getNumSegments() const;
+	std::size_t getNumNodes() const;
+
+	/// \brief Gets the point on the polyline closest to the target.
+	///
+	/// Works like ofPolyline_::getClosestPoint(), nearestIndex gets the
+	/// index of the closest vertex of the closest segment.
+	T getClosestPoint(const T & target, unsigned int * nearestIndex = nullptr) const;
+
+	/// \brief Gets the closest point for every target, running in parallel
+	/// for big batches.
+	std::vector<T> getClosestPoints(const std::vector<T> & targets, std::vector<unsigned int> * nearestIndices = nullptr) const;
+
+	/// \brief Sum of the signed crossings of the polyline around (x,y).
+	///
+	/// The polyline is always treated as closed as in
+	/// ofPolyline_::inside(), the sign depends on its orientation.
+	int getWindingNumber(float x, float y) const;
+
+	/// \brief Tests whether (x,y) is inside the polyline under a winding
+	/// rule, OF_POLY_WINDING_ODD gives the same results as
+	/// ofPolyline_::inside().
+	bool inside(float x, float y, ofPolyWindingMode mode = OF_POLY_WINDING_ODD) const;
+
+	/// \brief Tests every point, running in parallel for big batches.
+	std::vector<bool> inside(const std::vector<T> & points, ofPolyWindingMode mode = OF_POLY_WINDING_ODD) const;
+
+	/// \brief Finds where the segment from p0 to p1 crosses the polyline
+	/// on the xy plane, sorted along the query segment. Collinear
+	/// overlaps are not reported.
+	std::vector<Intersection> getIntersections(const T & p0, const T & p1) const;
+
+	/// \brief Returns true as soon as the segment from p0 to p1 crosses
+	/// the polyline on the xy plane.
+	bool intersects(const T & p0, const T & p1) const;
+
+private:
+	struct Node{
+		glm::vec3 min;
+		glm::vec3 max;
+		// for inner nodes the index of the first child, the second
+		// is always next to it. for leaves the first segment in
+		// segmentIds
+		uint32_t first;
+		// number of segments, 0 for inner nodes
+		uint32_t count;
+	};
+
+	static const std::size_t maxLeafSegments = 4;
+	static const std::size_t maxDepth = 64;
+
+	void buildNode(std::size_t nodeIndex, std::size_t begin, std::size_t end);
+	const glm::vec3 & getStart(uint32_t segment) const;
+	const glm::vec3 & getEnd(uint32_t segment) const;
+	// the closing segment is always in the tree since point in polygon
+	// tests need it, the other queries skip it for open polylines
+	bool isActive(uint32_t segment) const;
+	template<class F>
+	bool intersectSegment(const glm::vec3 & p0, const glm::vec3 & p1, F f) const;
+
+	std::vector<Node> nodes;
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> segmentIds;
+	bool bClosed = false;
+};
+
+using ofPolylineIndex = ofPolylineIndex_<ofDefaultVertexType>;
+
+//----------------------------------------------------------
+template<class T>
+void ofPolylineIndex_<T>::build(const std::vector<T> & points, bool closed){
+	clear();
+	bClosed = closed;
+	if(points.size() < 2){
+		return;
+	}
+	positions.resize(points.size());
+	for(std::size_t i = 0; i < points.size(); i++){
+		positions[i] = toGlm(points[i]);
+	}
+	segmentIds.resize(points.size());
+	for(std::size_t i = 0; i < segmentIds.size(); i++){
+		segmentIds[i] = i;
+	}
+	nodes.reserve(segmentIds.size());
+	nodes.emplace_back();
+	buildNode(0, 0, segmentIds.size());
+}
+
+//----------------------------------------------------------
+template<class T>
+void ofPolylineIndex_<T>::buildNode(std::size_t nodeIndex, std::size_t begin, std::size_t end){
+	glm::vec3 min(std::numeric_limits<float>::max());
+	glm::vec3 max(std::numeric_limits<float>::lowest());
+	glm::vec3 centroidMin = min;
+	glm::vec3 centroidMax = max;
+	for(std::size_t i = begin; i < end; i++){
+		auto & p0 = getStart(segmentIds[i]);
+		auto & p1 = getEnd(segmentIds[i]);
+		min = glm::min(min, glm::min(p0, p1));
+		max = glm::max(max, glm::max(p0, p1));
+		auto centroid = (p0 + p1) * 0.5f;
+		centroidMin = glm::min(centroidMin, centroid);
+		centroidMax = glm::max(centroidMax, centroid);
+	}
+	nodes[nodeIndex].min = min;
+	nodes[nodeIndex].max = max;
+
+	if(end - begin <= maxLeafSegments){
+		nodes[nodeIndex].first = begin;
+		nodes[nodeIndex].count = end - begin;
+		return;
+	}
+
+	// median split along the longest axis keeps the tree balanced so
+	// the traversal stacks can have a fixed size
+	auto extent = centroidMax - centroidMin;
+	int axis = 0;
+	if(extent.y > extent[axis]) axis = 1;
+	if(extent.z > extent[axis]) axis = 2;
+	std::size_t mid = (begin + end) / 2;
+	std::nth_element(segmentIds.begin() + begin, segmentIds.begin() + mid, segmentIds.begin() + end, [&](uint32_t a, uint32_t b){
+		return getStart(a)[axis] + getEnd(a)[axis] < getStart(b)[axis] + getEnd(b)[axis];
+	});
+
+	std::size_t children = nodes.size();
+	nodes[nodeIndex].first = children;
+	nodes[nodeIndex].count = 0;
+	nodes.emplace_back();
+	nodes.emplace_back();
+	buildNode(children, begin, mid);
+	buildNode(children + 1, mid, end);
+}
+
+//----------------------------------------------------------
+template<class T>
+void ofPolylineIndex_<T>::clear(){
+	nodes.clear();
+	positions.clear();
+	segmentIds.clear();
+}
+
+//----------------------------------------------------------
+template<class T>
+bool ofPolylineIndex_<T>::empty() const{
+	return nodes.empty();
+}
+
+//----------------------------------------------------------
+template<class T>
+std::size_t ofPolylineIndex_<T>::getNumSegments() const{
+	if(positions.size() < 2){
+		return 0;
+	}
+	return bClosed ? positions.size() : positions.size() - 1;
+}
+
+//----------------------------------------------------------
+template<class T>
+std::size_t ofPolylineIndex_<T>::getNumNodes() const{
+	return nodes.size();
+}
+
+//----------------------------------------------------------
+template<class T>
+const glm::vec3 & ofPolylineIndex_<T>::getStart(uint32_t segment) const{
+	return positions[segment];
+}
+
+//----------------------------------------------------------
+template<class T>
+const glm::vec3 & ofPolylineIndex_<T>::getEnd(uint32_t segment) const{
+	return segment + 1 == positions.size() ? positions[0] : positions[segment + 1];
+}
+
+//----------------------------------------------------------
+template<class T>
+bool ofPolylineIndex_<T>::isActive(uint32_t segment) const{
+	return bClosed || segment + 1 < positions.size();
+}
+
+//----------------------------------------------------------
+template<class T>
+T ofPolylineIndex_<T>::getClosestPoint(const T & target, unsigned int * nearestIndex) const{
+	if(empty()){
+		if(nearestIndex != nullptr){
+			*nearestIndex = 0;
+		}
+		return target;
+	}
+
+	auto p = toGlm(target);
+	auto boxDistance2 = [&p](const Node & node){
+		return glm::length2(p - glm::clamp(p, node.min, node.max));
+	};
+
+	float bestDistance2 = std::numeric_limits<float>::max();
+	uint32_t bestSegment = 0;
+	float bestU = 0;
+	glm::vec3 bestPoint = p;
+
+	std::array<uint32_t, maxDepth> stack;
+	std::size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while(stackSize > 0){
+		auto & node = nodes[stack[--stackSize]];
+		if(boxDistance2(node) > bestDistance2){
+			continue;
+		}
+		if(node.count > 0){
+			for(uint32_t i = node.first; i < node.first + node.count; i++){
+				auto segment = segmentIds[i];
+				if(!isActive(segment)){
+					continue;
+				}
+				auto & p0 = getStart(segment);
+				auto d = getEnd(segment) - p0;
+				float len2 = glm::length2(d);
+				float u = len2 > 0 ? glm::clamp(glm::dot(p - p0, d) / len2, 0.f, 1.f) : 0.f;
+				auto closest = p0 + d * u;
+				float distance2 = glm::length2(closest - p);
+				// ties go to the first segment as in the linear search
+				if(distance2 < bestDistance2 || (distance2 == bestDistance2 && segment < bestSegment)){
+					bestDistance2 = distance2;
+					bestSegment = segment;
+					bestU = u;
+					bestPoint = closest;
+				}
+			}
+		}else{
+			// visit the closest child first so the second one is more
+			// likely to be culled
+			uint32_t near = node.first;
+			uint32_t far = node.first + 1;
+			if(boxDistance2(nodes[far]) < boxDistance2(nodes[near])){
+				std::swap(near, far);
+			}
+			stack[stackSize++] = far;
+			stack[stackSize++] = near;
+		}
+	}
+
+	if(nearestIndex != nullptr){
+		unsigned int nearest = bestSegment;
+		if(bestU > .5){
+			nearest++;
+			if(nearest == positions.size()){
+				nearest = 0;
+			}
+		}
+		*nearestIndex = nearest;
+	}
+	return bestPoint;
+}
+
+//----------------------------------------------------------
+template<class T>
+std::vector<T> ofPolylineIndex_<T>::getClosestPoints(const std::vector<T> & targets, std::vector<unsigned int> * nearestIndices) const{
+	std::vector<T> closest(targets.size());
+	if(nearestIndices != nullptr){
+		nearestIndices->resize(targets.size());
+	}
+	of::priv::parallelForPolylineQueries(targets.size(), [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			closest[i] = getClosestPoint(targets[i], nearestIndices != nullptr ? &(*nearestIndices)[i] : nullptr);
+		}
+	});
+	return closest;
+}
+
+//----------------------------------------------------------
+template<class T>
+int ofPolylineIndex_<T>::getWindingNumber(float x, float y) const{
+	if(empty()){
+		return 0;
+	}
+
+	// only nodes crossed by a horizontal ray from (x,y) towards +x can
+	// contribute to the winding number
+	int winding = 0;
+	std::array<uint32_t, maxDepth> stack;
+	std::size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while(stackSize > 0){
+		auto & node = nodes[stack[--stackSize]];
+		if(y <= node.min.y || y > node.max.y || x > node.max.x){
+			continue;
+		}
+		if(node.count > 0){
+			for(uint32_t i = node.first; i < node.first + node.count; i++){
+				auto segment = segmentIds[i];
+				winding += of::priv::getWindingCrossing(getStart(segment), getEnd(segment), x, y);
+			}
+		}else{
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = node.first + 1;
+		}
+	}
+	return winding;
+}
+
+//----------------------------------------------------------
+template<class T>
+bool ofPolylineIndex_<T>::inside(float x, float y, ofPolyWindingMode mode) const{
+	return of::priv::isInsideWinding(getWindingNumber(x, y), mode);
+}
+
+//----------------------------------------------------------
+template<class T>
+std::vector<bool> ofPolylineIndex_<T>::inside(const std::vector<T> & points, ofPolyWindingMode mode) const{
+	// vector<bool> packs bits so threads can't write to it concurrently
+	std::vector<char> insideChars(points.size());
+	of::priv::parallelForPolylineQueries(points.size(), [&](std::size_t begin, std::size_t end){
+		for(std::size_t i = begin; i < end; i++){
+			insideChars[i] = inside(points[i].x, points[i].y, mode);
+		}
+	});
+	return std::vector<bool>(insideChars.begin(), insideChars.end());
+}
+
+//----------------------------------------------------------
+template<class T>
+template<class F>
+bool ofPolylineIndex_<T>::intersectSegment(const glm::vec3 & p0, const glm::vec3 & p1, F f) const{
+	if(empty()){
+		return false;
+	}
+
+	auto queryMin = glm::min(p0, p1);
+	auto queryMax = glm::max(p0, p1);
+	glm::vec2 r(p1 - p0);
+
+	std::array<uint32_t, maxDepth> stack;
+	std::size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while(stackSize > 0){
+		auto & node = nodes[stack[--stackSize]];
+		if(node.min.x > queryMax.x || node.max.x < queryMin.x || node.min.y > queryMax.y || node.max.y < queryMin.y){
+			continue;
+		}
+		if(node.count > 0){
+			for(uint32_t i = node.first; i < node.first + node.count; i++){
+				auto segment = segmentIds[i];
+				if(!isActive(segment)){
+					continue;
+				}
+				auto & a = getStart(segment);
+				auto & b = getEnd(segment);
+				glm::vec2 s(b - a);
+				float denom = r.x * s.y - r.y * s.x;
+				if(denom == 0){
+					continue;
+				}
+				glm::vec2 ap(a - p0);
+				float t = (ap.x * s.y - ap.y * s.x) / denom;
+				float u = (ap.x * r.y - ap.y * r.x) / denom;
+				// a crossing through a vertex is only reported once, by the
+				// segment starting there, except at the end of open polylines
+				bool lastSegment = !bClosed && segment + 2 == positions.size();
+				if(t < 0 || t > 1 || u < 0 || u > 1 || (u == 1 && !lastSegment)){
+					continue;
+				}
+				Intersection intersection;
+				intersection.position = glm::mix(a, b, u);
+				intersection.index = segment + u;
+				intersection.t = t;
+				if(f(intersection)){
+					return true;
+				}
+			}
+		}else{
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = node.first + 1;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------
+template<class T>
+std::vector<typename ofPolylineIndex_<T>::Intersection> ofPolylineIndex_<T>::getIntersections(const T & p0, const T & p1) const{
+	std::vector<Intersection> intersections;
+	intersectSegment(toGlm(p0), toGlm(p1), [&](const Intersection & intersection){
+		intersections.push_back(intersection);
+		return false;
+	});
+	std::sort(intersections.begin(), intersections.end(), [](const Intersection & a, const Intersection & b){
+		return a.t < b.t;
+	});
+	return intersections;
+}
+
+//----------------------------------------------------------
+template<class T>
+bool ofPolylineIndex_<T>::intersects(const T & p0, const T & p1) const{
+	return intersectSegment(toGlm(p0), toGlm(p1), [](const Intersection &){
+		return true;
+	});
+}
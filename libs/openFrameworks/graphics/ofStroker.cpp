@@ -0,0 +1,322 @@
+#include "ofStroker.h"
+#include "ofPolyline.h"
+#include "ofMesh.h"
+#include "ofLog.h"
+
+using namespace std;
+
+//----------------------------------------------------------
+// unit direction from a to b on the xy plane
+static glm::vec3 getDirection(const glm::vec3 & a, const glm::vec3 & b){
+	return glm::normalize(glm::vec3(b.x - a.x, b.y - a.y, 0));
+}
+
+//----------------------------------------------------------
+// left side of a direction on the xy plane
+static glm::vec3 getPerpendicular(const glm::vec3 & direction){
+	return glm::vec3(-direction.y, direction.x, 0);
+}
+
+//----------------------------------------------------------
+static glm::vec3 rotate(const glm::vec3 & v, float angle){
+	float c = cos(angle);
+	float s = sin(angle);
+	return glm::vec3(v.x * c - v.y * s, v.x * s + v.y * c, 0);
+}
+
+//----------------------------------------------------------
+// number of segments for a round join or cap of the given angle
+static int getRoundSegments(float angle, float radius, const ofStrokeStyle & style){
+	int circleResolution = of::priv::getCircleResolutionForTolerance(radius, style.roundTolerance);
+	return std::max(1, (int)ceil(angle * circleResolution / TWO_PI));
+}
+
+//----------------------------------------------------------
+void ofStroker::strokeToMesh(const vector<ofPolyline> & src, const ofStrokeStyle & style, ofMesh & dstmesh){
+	dstmesh.clear();
+	dstmesh.setMode(OF_PRIMITIVE_TRIANGLE_STRIP);
+	for(auto & polyline: src){
+		addStroke(polyline, style, dstmesh);
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::strokeToMesh(const ofPolyline & src, const ofStrokeStyle & style, ofMesh & dstmesh){
+	dstmesh.clear();
+	dstmesh.setMode(OF_PRIMITIVE_TRIANGLE_STRIP);
+	addStroke(src, style, dstmesh);
+}
+
+//----------------------------------------------------------
+void ofStroker::addStroke(const ofPolyline & polyline, const ofStrokeStyle & style, ofMesh & mesh){
+	if(style.width <= 0 || polyline.size() < 2){
+		return;
+	}
+
+	// repeated points have no direction to stroke along, the distances
+	// come from the cache in the polyline
+	points.clear();
+	lengths.clear();
+	for(size_t i = 0; i < polyline.size(); i++){
+		auto & p = toGlm(polyline[i]);
+		if(points.empty() || p.x != points.back().x || p.y != points.back().y){
+			points.push_back(p);
+			lengths.push_back(polyline.getLengthAtIndex(i));
+		}
+	}
+	bool closed = polyline.isClosed();
+	if(closed && points.size() > 2 && points.back().x == points.front().x && points.back().y == points.front().y){
+		points.pop_back();
+		lengths.pop_back();
+	}
+	if(points.size() < 2){
+		return;
+	}
+	float totalLength = closed ? polyline.getPerimeter() : lengths.back();
+
+	bool bDashed = !style.dashes.empty();
+	float patternLength = 0;
+	for(auto dash: style.dashes){
+		if(dash < 0){
+			ofLogWarning("ofStroker") << "addStroke(): dashes can't be negative, drawing a solid line";
+			bDashed = false;
+		}
+		patternLength += dash;
+	}
+	if(!bDashed || patternLength <= 0){
+		strokeRun(points, lengths, closed, totalLength, style, mesh);
+		return;
+	}
+
+	// as in svg an odd number of dashes is repeated so dashes and gaps
+	// keep alternating
+	auto pattern = style.dashes;
+	if(pattern.size() % 2 == 1){
+		pattern.insert(pattern.end(), style.dashes.begin(), style.dashes.end());
+	}
+	if(closed){
+		points.push_back(points.front());
+		lengths.push_back(totalLength);
+	}
+	addDashes(pattern, totalLength, style, mesh);
+}
+
+//----------------------------------------------------------
+void ofStroker::addDashes(const vector<float> & pattern, float totalLength, const ofStrokeStyle & style, ofMesh & mesh){
+	float patternLength = 0;
+	for(auto dash: pattern){
+		patternLength += dash;
+	}
+
+	// find the dash the line starts in
+	float offset = fmod(style.dashOffset, patternLength);
+	if(offset < 0){
+		offset += patternLength;
+	}
+	size_t dash = 0;
+	while(offset >= pattern[dash]){
+		offset -= pattern[dash];
+		dash = (dash + 1) % pattern.size();
+	}
+
+	auto getPointAtLength = [this](size_t segment, float length){
+		float segmentLength = lengths[segment + 1] - lengths[segment];
+		float t = segmentLength > 0 ? (length - lengths[segment]) / segmentLength : 0;
+		return glm::mix(points[segment], points[segment + 1], t);
+	};
+
+	size_t segment = 0;
+	float dashStart = -offset;
+	while(dashStart < totalLength){
+		float dashEnd = dashStart + pattern[dash];
+		float from = std::max(dashStart, 0.f);
+		float to = std::min(dashEnd, totalLength);
+		// even entries are dashes, odd ones gaps
+		if(dash % 2 == 0 && to > from){
+			while(segment + 2 < points.size() && lengths[segment + 1] <= from){
+				segment++;
+			}
+			dashPoints.clear();
+			dashLengths.clear();
+			dashPoints.push_back(getPointAtLength(segment, from));
+			dashLengths.push_back(from);
+			size_t i = segment + 1;
+			while(i + 1 < points.size() && lengths[i] < to){
+				dashPoints.push_back(points[i]);
+				dashLengths.push_back(lengths[i]);
+				i++;
+			}
+			dashPoints.push_back(getPointAtLength(i - 1, to));
+			dashLengths.push_back(to);
+			strokeRun(dashPoints, dashLengths, false, to, style, mesh);
+		}
+		dashStart = dashEnd;
+		dash = (dash + 1) % pattern.size();
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::strokeRun(const vector<glm::vec3> & runPoints, const vector<float> & runLengths, bool closed, float closedLength, const ofStrokeStyle & style, ofMesh & mesh){
+	size_t n = runPoints.size();
+	if(n < 2){
+		return;
+	}
+	bNewStrip = true;
+	if(closed){
+		// the strip starts with the outgoing side of the first join and
+		// ends with the whole join so it's only drawn once
+		addJoin(runPoints[n - 1], runPoints[0], runPoints[1], runLengths[0], true, style, mesh);
+		for(size_t i = 1; i < n; i++){
+			addJoin(runPoints[i - 1], runPoints[i], runPoints[(i + 1) % n], runLengths[i], false, style, mesh);
+		}
+		addJoin(runPoints[n - 1], runPoints[0], runPoints[1], closedLength, false, style, mesh);
+	}else{
+		addCap(runPoints[0], runPoints[1], runLengths[0], true, style, mesh);
+		for(size_t i = 1; i + 1 < n; i++){
+			addJoin(runPoints[i - 1], runPoints[i], runPoints[i + 1], runLengths[i], false, style, mesh);
+		}
+		addCap(runPoints[n - 1], runPoints[n - 2], runLengths[n - 1], false, style, mesh);
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::addJoin(const glm::vec3 & prev, const glm::vec3 & p, const glm::vec3 & next, float u, bool onlyOutgoing, const ofStrokeStyle & style, ofMesh & mesh){
+	float halfWidth = style.width * 0.5f;
+	auto dirPrev = getDirection(prev, p);
+	auto dirNext = getDirection(p, next);
+	auto normalPrev = getPerpendicular(dirPrev);
+	auto normalNext = getPerpendicular(dirNext);
+	float cross = dirPrev.x * dirNext.y - dirPrev.y * dirNext.x;
+	float dot = dirPrev.x * dirNext.x + dirPrev.y * dirNext.y;
+
+	if(std::abs(cross) < 1e-4f && dot > 0){
+		addPair(p + normalNext * halfWidth, p - normalNext * halfWidth, u, mesh);
+		return;
+	}
+
+	// the inner corner is on the left side when turning left
+	bool leftTurn = cross > 0;
+	float innerSide = leftTurn ? 1.f : -1.f;
+	auto addInnerOuter = [&](const glm::vec3 & inner, const glm::vec3 & outer){
+		if(leftTurn){
+			addPair(inner, outer, u, mesh);
+		}else{
+			addPair(outer, inner, u, mesh);
+		}
+	};
+
+	// the inner edges meet along the bisector, for very short segments
+	// the intersection would be past their ends so it's clamped there
+	glm::vec3 inner = p;
+	auto bisector = normalPrev + normalNext;
+	float bisectorLength = glm::length(bisector);
+	if(bisectorLength > 1e-4f){
+		auto miterDirection = bisector / bisectorLength;
+		float miterLength = halfWidth / (bisectorLength * 0.5f);
+		float shortestSegment = std::min(glm::length(glm::vec2(p - prev)), glm::length(glm::vec2(next - p)));
+		float maxInnerLength = sqrt(halfWidth * halfWidth + shortestSegment * shortestSegment);
+		inner = p + miterDirection * innerSide * std::min(miterLength, maxInnerLength);
+		if(style.join == OF_LINE_JOIN_MITER && miterLength <= style.miterLimit * halfWidth){
+			addInnerOuter(inner, p - miterDirection * innerSide * miterLength);
+			return;
+		}
+	}
+
+	auto outerPrev = p - normalPrev * innerSide * halfWidth;
+	auto outerNext = p - normalNext * innerSide * halfWidth;
+	if(onlyOutgoing){
+		addInnerOuter(inner, outerNext);
+		return;
+	}
+	if(style.join == OF_LINE_JOIN_ROUND){
+		auto from = outerPrev - p;
+		auto to = outerNext - p;
+		float angle = atan2(from.x * to.y - from.y * to.x, from.x * to.x + from.y * to.y);
+		int segments = getRoundSegments(std::abs(angle), halfWidth, style);
+		for(int i = 0; i <= segments; i++){
+			addInnerOuter(inner, p + rotate(from, angle * i / segments));
+		}
+	}else{
+		addInnerOuter(inner, outerPrev);
+		addInnerOuter(inner, outerNext);
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::addCap(const glm::vec3 & p, const glm::vec3 & neighbour, float u, bool start, const ofStrokeStyle & style, ofMesh & mesh){
+	float halfWidth = style.width * 0.5f;
+	// direction of the line at this end, pointing forward
+	auto direction = start ? getDirection(p, neighbour) : getDirection(neighbour, p);
+	auto normal = getPerpendicular(direction);
+	auto left = p + normal * halfWidth;
+	auto right = p - normal * halfWidth;
+
+	switch(style.cap){
+	case OF_LINE_CAP_BUTT:
+		addPair(left, right, u, mesh);
+		break;
+	case OF_LINE_CAP_SQUARE:{
+		auto extension = direction * halfWidth;
+		if(start){
+			addPair(left - extension, right - extension, u - halfWidth, mesh);
+			addPair(left, right, u, mesh);
+		}else{
+			addPair(left, right, u, mesh);
+			addPair(left + extension, right + extension, u + halfWidth, mesh);
+		}
+		break;
+	}
+	case OF_LINE_CAP_ROUND:{
+		// half circle from the left to the right side going around the
+		// end, as a strip that zig zags between both sides
+		int segments = getRoundSegments(PI, halfWidth, style);
+		segments = std::max(2, segments + segments % 2);
+		int tip = segments / 2;
+		float step = (start ? PI : -PI) / segments;
+		auto arcPoint = [&](int i){
+			return p + rotate(normal, step * i) * halfWidth;
+		};
+		auto arcU = [&](int i){
+			return u + glm::dot(arcPoint(i) - p, direction);
+		};
+		if(start){
+			addVertex(arcPoint(tip), glm::vec2(arcU(tip), 0.5f), mesh);
+			for(int i = 1; i <= tip; i++){
+				addPair(arcPoint(tip - i), arcPoint(tip + i), arcU(tip - i), mesh);
+			}
+		}else{
+			addPair(left, right, u, mesh);
+			for(int i = 1; i < tip; i++){
+				addPair(arcPoint(i), arcPoint(segments - i), arcU(i), mesh);
+			}
+			addVertex(arcPoint(tip), glm::vec2(arcU(tip), 0.5f), mesh);
+		}
+		break;
+	}
+	}
+}
+
+//----------------------------------------------------------
+void ofStroker::addPair(const glm::vec3 & left, const glm::vec3 & right, float u, ofMesh & mesh){
+	addVertex(left, glm::vec2(u, 0), mesh);
+	addVertex(right, glm::vec2(u, 1), mesh);
+}
+
+//----------------------------------------------------------
+void ofStroker::addVertex(const glm::vec3 & position, const glm::vec2 & texCoord, ofMesh & mesh){
+	if(bNewStrip){
+		// repeating the last vertex of the previous strip and the first of
+		// this one creates degenerate triangles that connect both
+		if(mesh.getNumVertices() > 0){
+			auto lastVertex = mesh.getVertices().back();
+			auto lastTexCoord = mesh.getTexCoords().back();
+			mesh.addVertex(lastVertex);
+			mesh.addTexCoord(lastTexCoord);
+			mesh.addVertex(position);
+			mesh.addTexCoord(texCoord);
+		}
+		bNewStrip = false;
+	}
+	mesh.addVertex(position);
+	mesh.addTexCoord(texCoord);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofGraphicsBaseTypes.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+/// \brief Describes how a thick line is converted to triangles by ofStroker.
+struct ofStrokeStyle{
+	/// Width of the line in the same units as its vertices.
+	float width = 1;
+	ofLineJoin join = OF_LINE_JOIN_MITER;
+	ofLineCap cap = OF_LINE_CAP_BUTT;
+	/// Maximum ratio between the length of a miter and the width of the
+	/// line, sharper corners are beveled. Same as the SVG miter limit.
+	float miterLimit = 4;
+	/// Lengths of alternating dashes and gaps, the line is solid if empty.
+	std::vector<float> dashes;
+	/// Distance into the dash pattern at which the line starts.
+	float dashOffset = 0;
+	/// Maximum distance between round joins or caps and an exact circle.
+	float roundTolerance = 0.25f;
+};
+
+/// \brief ofStroker converts ofPolyline instances into triangle meshes of a
+/// given width, with joins between segments, caps at the ends of open
+/// lines and optional dashes.
+///
+/// Line widths bigger than 1 are not supported by core profile OpenGL so
+/// ofGLProgrammableRenderer draws thick ofPath outlines using the meshes
+/// generated here. Since many polylines can be stroked into the same mesh
+/// it's also a way of drawing lots of thick lines in one draw call:
+///
+/// ~~~~{.cpp}
+/// ofStrokeStyle style;
+/// style.width = 8;
+/// style.join = OF_LINE_JOIN_ROUND;
+/// style.cap = OF_LINE_CAP_ROUND;
+/// ofStroker stroker;
+/// stroker.strokeToMesh(lines, style, mesh);
+/// mesh.draw();
+/// ~~~~
+///
+/// The meshes use OF_PRIMITIVE_TRIANGLE_STRIP, separate lines and dashes
+/// are joined with degenerate triangles. Lines are stroked on the xy plane
+/// keeping the z of their vertices. Texture coordinates go along the line
+/// in x, measured as the distance from its first vertex, and across it in y
+/// from 0 on the left side to 1 on the right one.
+class ofStroker{
+public:
+	/// \brief Strokes a vector of ofPolyline instances into a single ofMesh.
+	void strokeToMesh(const std::vector<ofPolyline> & src, const ofStrokeStyle & style, ofMesh & dstmesh);
+
+	/// \brief Strokes an ofPolyline into an ofMesh.
+	void strokeToMesh(const ofPolyline & src, const ofStrokeStyle & style, ofMesh & dstmesh);
+
+private:
+	void addStroke(const ofPolyline & polyline, const ofStrokeStyle & style, ofMesh & mesh);
+	void addDashes(const std::vector<float> & pattern, float totalLength, const ofStrokeStyle & style, ofMesh & mesh);
+	void strokeRun(const std::vector<glm::vec3> & runPoints, const std::vector<float> & runLengths, bool closed, float closedLength, const ofStrokeStyle & style, ofMesh & mesh);
+	void addJoin(const glm::vec3 & prev, const glm::vec3 & p, const glm::vec3 & next, float u, bool onlyOutgoing, const ofStrokeStyle & style, ofMesh & mesh);
+	void addCap(const glm::vec3 & p, const glm::vec3 & neighbour, float u, bool start, const ofStrokeStyle & style, ofMesh & mesh);
+	void addPair(const glm::vec3 & left, const glm::vec3 & right, float u, ofMesh & mesh);
+	void addVertex(const glm::vec3 & position, const glm::vec2 & texCoord, ofMesh & mesh);
+
+	// vertices of the polyline being stroked without repeated points and
+	// their distance along it
+	std::vector<glm::vec3> points;
+	std::vector<float> lengths;
+	// same for the dash being stroked
+	std::vector<glm::vec3> dashPoints;
+	std::vector<float> dashLengths;
+	// the next vertex starts a new strip, which is connected to the
+	// previous one with degenerate triangles
+	bool bNewStrip = true;
+};
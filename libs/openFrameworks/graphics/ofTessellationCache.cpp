@@ -0,0 +1,243 @@
+#include "ofTessellationCache.h"
+#include "ofUtils.h"
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace{
+	struct Entry{
+		uint64_t key;
+		// the geometry the key was computed from, to tell apart shapes
+		// with the same hash
+		ofPolyWindingMode windingMode;
+		std::vector<std::size_t> sizes;
+		std::vector<ofDefaultVertexType> vertices;
+		std::shared_ptr<const ofMesh> mesh;
+		std::size_t bytes;
+		uint64_t tessellationTime;
+
+		bool matches(const vector<ofPolyline> & polylines, ofPolyWindingMode windingMode) const{
+			if(windingMode != this->windingMode || polylines.size() != sizes.size()){
+				return false;
+			}
+			std::size_t offset = 0;
+			for(std::size_t i = 0; i < polylines.size(); i++){
+				auto & polylineVertices = polylines[i].getVertices();
+				if(polylineVertices.size() != sizes[i]){
+					return false;
+				}
+				if(!polylineVertices.empty() && memcmp(polylineVertices.data(), vertices.data() + offset, sizes[i] * sizeof(ofDefaultVertexType)) != 0){
+					return false;
+				}
+				offset += sizes[i];
+			}
+			return true;
+		}
+	};
+
+	// the polylines are the input of the tessellator so identical polylines
+	// with the same winding mode have the same tessellation, whatever
+	// commands and curve settings generated them. hashed with fnv-1a
+	uint64_t getKey(const vector<ofPolyline> & polylines, ofPolyWindingMode windingMode){
+		uint64_t hash = 14695981039346656037ull;
+		auto add = [&hash](const void * data, size_t size){
+			auto bytes = static_cast<const unsigned char*>(data);
+			for(size_t i = 0; i < size; i++){
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+		};
+		add(&windingMode, sizeof(windingMode));
+		for(auto & polyline: polylines){
+			size_t size = polyline.size();
+			add(&size, sizeof(size));
+			if(size > 0){
+				add(&polyline.getVertices()[0], size * sizeof(polyline.getVertices()[0]));
+			}
+		}
+		return hash;
+	}
+
+	struct Cache{
+		std::mutex mutex;
+		// most recently used first
+		std::list<Entry> entries;
+		std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+		bool enabled = true;
+		std::size_t byteBudget = 32 * 1024 * 1024;
+		std::size_t bytesUsed = 0;
+		std::size_t numHits = 0;
+		std::size_t numMisses = 0;
+		std::size_t numEvictions = 0;
+		uint64_t tessellationTime = 0;
+		uint64_t tessellationTimeSaved = 0;
+	};
+
+	Cache & getCache(){
+		static Cache cache;
+		return cache;
+	}
+
+	std::size_t memoryUsage(const ofMesh & mesh){
+		return mesh.getNumVertices() * sizeof(ofDefaultVertexType) +
+			mesh.getNumNormals() * sizeof(ofDefaultNormalType) +
+			mesh.getNumColors() * sizeof(ofDefaultColorType) +
+			mesh.getNumTexCoords() * sizeof(ofDefaultTexCoordType) +
+			mesh.getNumIndices() * sizeof(ofIndexType);
+	}
+
+	// needs the cache to be locked
+	void remove(Cache & c, std::list<Entry>::iterator entry){
+		c.bytesUsed -= entry->bytes;
+		c.index.erase(entry->key);
+		c.entries.erase(entry);
+	}
+
+	// needs the cache to be locked
+	void evict(Cache & c){
+		while(c.bytesUsed > c.byteBudget && !c.entries.empty()){
+			remove(c, std::prev(c.entries.end()));
+			c.numEvictions += 1;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<const ofMesh> ofTessellationCache::get(const vector<ofPolyline> & polylines, ofPolyWindingMode windingMode, const std::function<void(ofMesh &)> & tessellate){
+	auto & c = getCache();
+	auto key = getKey(polylines, windingMode);
+	std::unique_lock<std::mutex> lock(c.mutex);
+	if(c.enabled){
+		auto it = c.index.find(key);
+		if(it != c.index.end() && it->second->matches(polylines, windingMode)){
+			c.entries.splice(c.entries.begin(), c.entries, it->second);
+			c.numHits += 1;
+			c.tessellationTimeSaved += it->second->tessellationTime;
+			return it->second->mesh;
+		}
+	}
+	bool enabled = c.enabled;
+	lock.unlock();
+
+	auto then = ofGetElapsedTimeMicros();
+	auto mesh = std::make_shared<ofMesh>();
+	tessellate(*mesh);
+	auto tessellationTime = ofGetElapsedTimeMicros() - then;
+	if(!enabled){
+		return mesh;
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.windingMode = windingMode;
+	for(auto & polyline: polylines){
+		entry.sizes.push_back(polyline.size());
+		entry.vertices.insert(entry.vertices.end(), polyline.getVertices().begin(), polyline.getVertices().end());
+	}
+	entry.mesh = mesh;
+	entry.bytes = memoryUsage(*mesh) + entry.sizes.size() * sizeof(std::size_t) + entry.vertices.size() * sizeof(ofDefaultVertexType);
+	entry.tessellationTime = tessellationTime;
+
+	lock.lock();
+	c.numMisses += 1;
+	c.tessellationTime += tessellationTime;
+	if(!c.enabled){
+		return mesh;
+	}
+	// another thread might have tessellated the same shape meanwhile,
+	// a different shape with the same hash is replaced
+	auto it = c.index.find(key);
+	if(it != c.index.end()){
+		if(it->second->matches(polylines, windingMode)){
+			c.entries.splice(c.entries.begin(), c.entries, it->second);
+			return it->second->mesh;
+		}
+		remove(c, it->second);
+	}
+	c.bytesUsed += entry.bytes;
+	c.entries.push_front(std::move(entry));
+	c.index[key] = c.entries.begin();
+	evict(c);
+	return mesh;
+}
+
+//--------------------------------------------------------------
+void ofTessellationCache::setByteBudget(std::size_t bytes){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	c.byteBudget = bytes;
+	evict(c);
+}
+
+//--------------------------------------------------------------
+std::size_t ofTessellationCache::getByteBudget(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	return c.byteBudget;
+}
+
+//--------------------------------------------------------------
+void ofTessellationCache::setEnabled(bool enabled){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	c.enabled = enabled;
+	if(!enabled){
+		c.entries.clear();
+		c.index.clear();
+		c.bytesUsed = 0;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofTessellationCache::isEnabled(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	return c.enabled;
+}
+
+//--------------------------------------------------------------
+void ofTessellationCache::clear(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	c.entries.clear();
+	c.index.clear();
+	c.bytesUsed = 0;
+	c.numHits = 0;
+	c.numMisses = 0;
+	c.numEvictions = 0;
+	c.tessellationTime = 0;
+	c.tessellationTimeSaved = 0;
+}
+
+//--------------------------------------------------------------
+ofTessellationCache::Stats ofTessellationCache::getStats(){
+	auto & c = getCache();
+	std::unique_lock<std::mutex> lock(c.mutex);
+	Stats stats;
+	stats.numMeshes = c.entries.size();
+	stats.numHits = c.numHits;
+	stats.numMisses = c.numMisses;
+	stats.numEvictions = c.numEvictions;
+	stats.bytesUsed = c.bytesUsed;
+	stats.byteBudget = c.byteBudget;
+	stats.tessellationTime = c.tessellationTime;
+	stats.tessellationTimeSaved = c.tessellationTimeSaved;
+	return stats;
+}
+
+//--------------------------------------------------------------
+std::ostream & operator<<(std::ostream & os, const ofTessellationCache::Stats & stats){
+	os << stats.numMeshes << " meshes, "
+	   << stats.numHits << " hits, "
+	   << stats.numMisses << " misses, "
+	   << stats.numEvictions << " evictions, "
+	   << stats.bytesUsed / 1024 << "KB used of "
+	   << stats.byteBudget / 1024 << "KB, "
+	   << stats.tessellationTime / 1000. << "ms tessellating, "
+	   << stats.tessellationTimeSaved / 1000. << "ms saved";
+	return os;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ofMesh.h"
+#include "ofPolyline.h"
+#include <functional>
+#include <memory>
+
+/// \brief Shares the tessellation of identical ofPath instances.
+///
+/// Tessellating a path with libtess2 is expensive and the same shapes are
+/// often tessellated again and again: copies of glyph outlines returned by
+/// ofTrueTypeFont::getCharacterAsPoints(), repeated symbols in an svg or
+/// paths that are rebuilt every frame with the same commands.
+/// ofTessellationCache keeps the meshes keyed by the polylines of the path,
+/// which already reflect its curve settings, and its winding mode so
+/// ofPath::tessellate() only runs libtess2 the first time a shape is seen.
+/// Lookups go through a hash of the key, the polylines of every hit are
+/// compared with the stored ones so different shapes never share a mesh.
+///
+/// The returned meshes are immutable and shared by every path with the
+/// same geometry. The cache holds on to the most recently used meshes up to
+/// a budget in bytes, meshes evicted from the cache stay alive while a path
+/// still uses them.
+///
+/// ~~~~{.cpp}
+/// ofTessellationCache::setByteBudget(64 * 1024 * 1024);
+/// ofLogNotice() << ofTessellationCache::getStats();
+/// ~~~~
+class ofTessellationCache{
+public:
+	struct Stats{
+		/// Number of meshes in the cache.
+		std::size_t numMeshes = 0;
+		/// Number of requests served from the cache.
+		std::size_t numHits = 0;
+		/// Number of requests that had to tessellate.
+		std::size_t numMisses = 0;
+		/// Number of meshes dropped to stay under the budget.
+		std::size_t numEvictions = 0;
+		/// Memory used by the meshes in the cache and the polylines they
+		/// were tessellated from.
+		std::size_t bytesUsed = 0;
+		/// Maximum memory used by the meshes in the cache.
+		std::size_t byteBudget = 0;
+		/// Total time spent tessellating in microseconds.
+		uint64_t tessellationTime = 0;
+		/// Time in microseconds that would have been spent tessellating
+		/// the meshes served from the cache.
+		uint64_t tessellationTimeSaved = 0;
+	};
+
+	/// \brief Get the mesh for some polylines and winding mode, calling
+	/// tessellate to create it if it's not in the cache.
+	///
+	/// tessellate is called without holding the cache lock so several
+	/// threads can tessellate different shapes at the same time.
+	static std::shared_ptr<const ofMesh> get(const std::vector<ofPolyline> & polylines, ofPolyWindingMode windingMode, const std::function<void(ofMesh &)> & tessellate);
+
+	/// \brief Sets the maximum memory used by the cached meshes, the least
+	/// recently used meshes are dropped first. 32MB by default.
+	static void setByteBudget(std::size_t bytes);
+	static std::size_t getByteBudget();
+
+	/// \brief Enables or disables the cache, enabled by default. When
+	/// disabled ofPath tessellates into its own mesh as before.
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	/// \brief Forgets all the cached meshes and resets the stats. Meshes
+	/// already in use are not affected.
+	static void clear();
+
+	static Stats getStats();
+};
+
+std::ostream & operator<<(std::ostream & os, const ofTessellationCache::Stats & stats);
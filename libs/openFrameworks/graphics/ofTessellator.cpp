@@ -43,44 +43,170 @@ using namespace std;
 // ------------------------------------
 
 
+//----------------------------------------------------------
+// every allocation is preceded by its size so it can be reallocated,
+// the header keeps the returned pointers aligned for any type
+static const std::size_t arenaHeaderSize = 16;
+static const std::size_t arenaMinBlockSize = 64 * 1024;
+
+// rough memory used by libtess2 per input vertex, counting the mesh, the
+// sweep line and the output arrays
+static const std::size_t arenaBytesPerVertex = 256;
+
+static std::size_t alignArenaSize(std::size_t size){
+	return (size + arenaHeaderSize - 1) & ~(arenaHeaderSize - 1);
+}
+
+//----------------------------------------------------------
+void * of::priv::TessellatorArena::allocate(std::size_t size){
+	std::size_t needed = arenaHeaderSize + alignArenaSize(size);
+	while(currentBlock < blocks.size() && offset + needed > blocks[currentBlock].size){
+		currentBlock++;
+		offset = 0;
+	}
+	if(currentBlock == blocks.size()){
+		std::size_t blockSize = std::max(needed, blocks.empty() ? arenaMinBlockSize : blocks.back().size * 2);
+		blocks.push_back({std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+		numBlockAllocations++;
+		offset = 0;
+	}
+	char * header = blocks[currentBlock].data.get() + offset;
+	*reinterpret_cast<std::size_t*>(header) = size;
+	offset += needed;
+	usedBytes += needed;
+	peakBytes = std::max(peakBytes, usedBytes);
+	numAllocations++;
+	lastAllocation = header + arenaHeaderSize;
+	return lastAllocation;
+}
+
+//----------------------------------------------------------
+void * of::priv::TessellatorArena::reallocate(void * ptr, std::size_t size){
+	if(ptr == nullptr){
+		return allocate(size);
+	}
+	char * data = static_cast<char*>(ptr);
+	std::size_t & oldSize = *reinterpret_cast<std::size_t*>(data - arenaHeaderSize);
+	if(size <= oldSize){
+		return ptr;
+	}
+	// the last allocation can grow in place, that's usually the case for
+	// the output arrays and the priority queue
+	if(data == lastAllocation){
+		std::size_t grow = alignArenaSize(size) - alignArenaSize(oldSize);
+		if(offset + grow <= blocks[currentBlock].size){
+			offset += grow;
+			usedBytes += grow;
+			peakBytes = std::max(peakBytes, usedBytes);
+			numAllocations++;
+			oldSize = size;
+			return ptr;
+		}
+	}
+	std::size_t copySize = oldSize;
+	void * newData = allocate(size);
+	memcpy(newData, ptr, copySize);
+	return newData;
+}
+
+//----------------------------------------------------------
+void of::priv::TessellatorArena::reset(std::size_t expectedBytes){
+	std::size_t capacity = getCapacity();
+	std::size_t neededCapacity = std::max(expectedBytes, arenaMinBlockSize);
+	// keep a single block big enough for the recent tessellations, but
+	// don't hold on to a huge one after a one off big tessellation. the
+	// high water mark decays slowly so alternating big and small inputs
+	// don't reallocate every time
+	highWaterMark = std::max(usedBytes, highWaterMark - highWaterMark / 8);
+	std::size_t recentCapacity = std::max(neededCapacity, highWaterMark);
+	bool tooBig = capacity > 8 * 1024 * 1024 && capacity > 4 * recentCapacity;
+	if(blocks.size() > 1 || capacity < neededCapacity || tooBig){
+		std::size_t blockSize = tooBig ? recentCapacity : std::max(neededCapacity, capacity);
+		blocks.clear();
+		blocks.push_back({std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+		numBlockAllocations++;
+	}
+	currentBlock = 0;
+	offset = 0;
+	usedBytes = 0;
+	lastAllocation = nullptr;
+}
+
+//----------------------------------------------------------
+std::size_t of::priv::TessellatorArena::getUsedBytes() const{
+	return usedBytes;
+}
+
+//----------------------------------------------------------
+std::size_t of::priv::TessellatorArena::getCapacity() const{
+	std::size_t capacity = 0;
+	for(auto & block: blocks){
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+//----------------------------------------------------------
+std::size_t of::priv::TessellatorArena::getPeakBytes() const{
+	return peakBytes;
+}
+
+//----------------------------------------------------------
+std::size_t of::priv::TessellatorArena::getNumAllocations() const{
+	return numAllocations;
+}
+
+//----------------------------------------------------------
+std::size_t of::priv::TessellatorArena::getNumBlockAllocations() const{
+	return numBlockAllocations;
+}
+
+//----------------------------------------------------------
+void of::priv::TessellatorArena::resetStats(){
+	peakBytes = usedBytes;
+	numAllocations = 0;
+	numBlockAllocations = 0;
+}
+
+//----------------------------------------------------------
 void * memAllocator( void *userData, unsigned int size ){
-	return malloc(size);
+	return static_cast<of::priv::TessellatorArena*>(userData)->allocate(size);
 }
 
+//----------------------------------------------------------
 void * memReallocator( void *userData, void* ptr, unsigned int size ){
-	return realloc(ptr,size);
+	return static_cast<of::priv::TessellatorArena*>(userData)->reallocate(ptr, size);
 }
 
+//----------------------------------------------------------
+// memory is only released when the arena is reset
 void memFree( void *userData, void *ptr ){
-	free (ptr);
 }
 
 //----------------------------------------------------------
 ofTessellator::ofTessellator()
   : cacheTess(nullptr)
+  , numTessellations(0)
 {
 	init();
 }
 
 //----------------------------------------------------------
 ofTessellator::~ofTessellator(){
-	tessDeleteTess(cacheTess);
+	// the tessellator lives in the arena, releasing it is enough
 }
 
 //----------------------------------------------------------
 ofTessellator::ofTessellator(const ofTessellator & mom)
   : cacheTess(nullptr)
+  , numTessellations(0)
 {
-	if(&mom != this){
-		if(cacheTess) tessDeleteTess(cacheTess);
-		init();
-	}
+	init();
 }
 
 //----------------------------------------------------------
 ofTessellator & ofTessellator::operator=(const ofTessellator & mom){
 	if(&mom != this){
-		if(cacheTess) tessDeleteTess(cacheTess);
 		init();
 	}
 	return *this;
@@ -91,18 +217,58 @@ void ofTessellator::init(){
 	tessAllocator.memalloc = memAllocator;
 	tessAllocator.memrealloc = memReallocator;
 	tessAllocator.memfree = memFree;
-	tessAllocator.meshEdgeBucketSize=0;
-	tessAllocator.meshVertexBucketSize=0;
-	tessAllocator.meshFaceBucketSize=0;
-	tessAllocator.dictNodeBucketSize=0;
-	tessAllocator.regionBucketSize=0;
-	tessAllocator.extraVertices=0;
+	tessAllocator.userData = &arena;
+	beginTessellation(0);
+}
+
+//----------------------------------------------------------
+void ofTessellator::beginTessellation(std::size_t numVertices){
+	// the meshes built by libtess2 have around 3 edges and 2 faces per
+	// vertex, the sweep line dictionary and regions only hold the edges
+	// crossing it at a time
+	auto bucketSize = [](std::size_t count, std::size_t maxSize){
+		return (int)std::min(std::max(count, std::size_t(16)), maxSize);
+	};
+	tessAllocator.meshVertexBucketSize = bucketSize(numVertices, 4096);
+	tessAllocator.meshEdgeBucketSize = bucketSize(numVertices * 3, 4096);
+	tessAllocator.meshFaceBucketSize = bucketSize(numVertices * 2, 4096);
+	tessAllocator.dictNodeBucketSize = bucketSize(numVertices / 4, 512);
+	tessAllocator.regionBucketSize = bucketSize(numVertices / 4, 512);
+	tessAllocator.extraVertices = bucketSize(numVertices / 4, 4096);
+	arena.reset(numVertices * arenaBytesPerVertex);
 	cacheTess = tessNewTess( &tessAllocator );
 }
 
+//----------------------------------------------------------
+static std::size_t getNumVertices(const vector<ofPolyline> & src){
+	std::size_t numVertices = 0;
+	for(auto & polyline: src){
+		numVertices += polyline.size();
+	}
+	return numVertices;
+}
+
+//----------------------------------------------------------
+ofTessellator::AllocationStats ofTessellator::getAllocationStats() const{
+	AllocationStats stats;
+	stats.peakBytes = arena.getPeakBytes();
+	stats.allocations = arena.getNumAllocations();
+	stats.blocks = arena.getNumBlockAllocations();
+	stats.tessellations = numTessellations;
+	return stats;
+}
+
+//----------------------------------------------------------
+void ofTessellator::resetAllocationStats(){
+	arena.resetStats();
+	numTessellations = 0;
+}
+
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D){
 
+	beginTessellation(src.size());
+
 	ofPolyline& polyline = const_cast<ofPolyline&>(src);
 	tessAddContour( cacheTess, bIs2D?2:3, &polyline.getVertices()[0], sizeof(glm::vec3), polyline.size());
 
@@ -113,6 +279,8 @@ void ofTessellator::tessellateToMesh( const ofPolyline& src,  ofPolyWindingMode
 //----------------------------------------------------------
 void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, ofMesh & dstmesh, bool bIs2D ) {
 
+	beginTessellation(getNumVertices(src));
+
 
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
@@ -129,6 +297,8 @@ void ofTessellator::tessellateToMesh( const vector<ofPolyline>& src, ofPolyWindi
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D){
 
+	beginTessellation(src.size());
+
 	if (src.size() > 0) {
 		ofPolyline& polyline = const_cast<ofPolyline&>(src);
 		tessAddContour(cacheTess, bIs2D ? 2 : 3, &polyline.getVertices()[0], sizeof(glm::vec3), polyline.size());
@@ -140,6 +310,8 @@ void ofTessellator::tessellateToPolylines( const ofPolyline& src,  ofPolyWinding
 //----------------------------------------------------------
 void ofTessellator::tessellateToPolylines( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly, bool bIs2D ) {
 
+	beginTessellation(getNumVertices(src));
+
 	// pass vertex pointers to GLU tessellator
 	for ( int i=0; i<(int)src.size(); ++i ) {
 		if (src[i].size() > 0) {
@@ -160,6 +332,7 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, ofMes
 		ofLogError("ofTessellator") << "performTessellation(): mesh polygon tessellation failed, winding mode " << polyWindingMode;
 		return;
 	}
+	numTessellations++;
 
 	int numVertices = tessGetVertexCount( cacheTess );
 	int numIndices = tessGetElementCount( cacheTess )*3;
@@ -183,6 +356,7 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vecto
 		ofLogError("ofTessellator") << "performTesselation(): polyline boundary contours tessellation failed, winding mode " << polyWindingMode;
 		return;
 	}
+	numTessellations++;
 
 	const ofDefaultVertexType* verts = (ofDefaultVertexType*)tessGetVertices(cacheTess);
 	const TESSindex* elems = tessGetElements(cacheTess);
@@ -197,3 +371,165 @@ void ofTessellator::performTessellation(ofPolyWindingMode polyWindingMode, vecto
 			dstpoly[i].setClosed(true);
 	}
 }
+
+//----------------------------------------------------------
+void ofTessellator::clipToPolylines( const vector<ofPolyline>& subject, ofPolyWindingMode subjectWindingMode, const vector<ofPolyline>& clip, ofPolyWindingMode clipWindingMode, ofPolyClipType clipType, vector<ofPolyline>& dstpoly ){
+
+	// resolving each input with its own winding mode leaves contours where
+	// the area inside has a winding number of 1 and outside 0, so added
+	// together the winding number tells if a point is in the subject, the
+	// clip or both. for the difference the clip contours are reversed and
+	// the points only in the subject are the ones with winding number 1
+	vector<ofPolyline> subjectContours, clipContours;
+	beginTessellation(getNumVertices(subject));
+	if(addContours(subject, false)){
+		performClip(subjectWindingMode, subjectContours);
+	}
+	beginTessellation(getNumVertices(clip));
+	if(addContours(clip, false)){
+		performClip(clipWindingMode, clipContours);
+	}
+
+	beginTessellation(getNumVertices(subjectContours) + getNumVertices(clipContours));
+	bool bHasContours = addContours(subjectContours, false);
+	bHasContours |= addContours(clipContours, clipType == OF_POLY_CLIP_DIFFERENCE);
+	if(!bHasContours){
+		dstpoly.clear();
+		return;
+	}
+
+	switch(clipType){
+	case OF_POLY_CLIP_UNION:
+	case OF_POLY_CLIP_DIFFERENCE:
+		performClip(OF_POLY_WINDING_POSITIVE, dstpoly);
+		break;
+	case OF_POLY_CLIP_INTERSECTION:
+		performClip(OF_POLY_WINDING_ABS_GEQ_TWO, dstpoly);
+		break;
+	case OF_POLY_CLIP_XOR:
+		performClip(OF_POLY_WINDING_ODD, dstpoly);
+		break;
+	}
+}
+
+//----------------------------------------------------------
+void ofTessellator::offsetToPolylines( const vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, float delta, vector<ofPolyline>& dstpoly, ofLineJoin join, float miterLimit, float roundTolerance ){
+
+	vector<ofPolyline> contours;
+	beginTessellation(getNumVertices(src));
+	if(!addContours(src, false)){
+		dstpoly.clear();
+		return;
+	}
+	performClip(polyWindingMode, contours);
+	if(delta == 0){
+		dstpoly = contours;
+		return;
+	}
+
+	// every edge is moved along its normal and the corners joined. where
+	// the moved edges overlap, the raw contour goes back through the
+	// original vertex which leaves loops with a winding number of 0 or
+	// less that are removed by filling only positive winding numbers.
+	// outer contours go counter clockwise and holes clockwise so the
+	// right side of every edge is outside of the shape
+	float absDelta = std::abs(delta);
+	int circleResolution = of::priv::getCircleResolutionForTolerance(absDelta, roundTolerance);
+	vector<glm::vec3> normals;
+	vector<glm::vec3> offsetContour;
+	bool bHasContours = false;
+	beginTessellation(getNumVertices(contours) * 3);
+	for(auto & contour: contours){
+		auto & vertices = contour.getVertices();
+		size_t n = vertices.size();
+		if(n < 3) continue;
+		normals.resize(n);
+		for(size_t i = 0; i < n; i++){
+			auto & p0 = vertices[i];
+			auto & p1 = vertices[(i + 1) % n];
+			auto d = glm::vec3(p1.x - p0.x, p1.y - p0.y, 0);
+			float length = glm::length(d);
+			normals[i] = length > 0 ? glm::vec3(d.y, -d.x, 0) / length : glm::vec3(0);
+		}
+
+		offsetContour.clear();
+		for(size_t i = 0; i < n; i++){
+			auto p = glm::vec3(vertices[i].x, vertices[i].y, 0);
+			auto & n1 = normals[(i + n - 1) % n];
+			auto & n2 = normals[i];
+			float sinA = n1.x * n2.y - n1.y * n2.x;
+			float cosA = n1.x * n2.x + n1.y * n2.y;
+			if(std::abs(sinA) < 1e-4f && cosA > 0){
+				offsetContour.push_back(p + n2 * delta);
+			}else if(sinA * delta < 0){
+				offsetContour.push_back(p + n1 * delta);
+				offsetContour.push_back(p);
+				offsetContour.push_back(p + n2 * delta);
+			}else if(join == OF_LINE_JOIN_ROUND){
+				float angle = atan2(sinA, cosA);
+				int steps = std::max(1, (int)ceil(std::abs(angle) * circleResolution / TWO_PI));
+				for(int j = 0; j <= steps; j++){
+					float a = angle * j / steps;
+					auto normal = glm::vec3(n1.x * cos(a) - n1.y * sin(a), n1.x * sin(a) + n1.y * cos(a), 0);
+					offsetContour.push_back(p + normal * delta);
+				}
+			}else if(join == OF_LINE_JOIN_MITER && 1 + cosA >= 2 / (miterLimit * miterLimit)){
+				offsetContour.push_back(p + (n1 + n2) * delta / (1 + cosA));
+			}else{
+				offsetContour.push_back(p + n1 * delta);
+				offsetContour.push_back(p + n2 * delta);
+			}
+		}
+		tessAddContour(cacheTess, 2, &offsetContour[0].x, sizeof(glm::vec3), offsetContour.size());
+		bHasContours = true;
+	}
+
+	if(bHasContours){
+		performClip(OF_POLY_WINDING_POSITIVE, dstpoly);
+	}else{
+		dstpoly.clear();
+	}
+}
+
+//----------------------------------------------------------
+bool ofTessellator::addContours( const vector<ofPolyline>& src, bool bReversed ){
+	vector<glm::vec3> reversed;
+	bool bHasContours = false;
+	for(auto & polyline: src){
+		if(polyline.size() == 0) continue;
+		if(bReversed){
+			reversed.assign(polyline.getVertices().rbegin(), polyline.getVertices().rend());
+			tessAddContour(cacheTess, 2, &reversed[0].x, sizeof(glm::vec3), reversed.size());
+		}else{
+			tessAddContour(cacheTess, 2, &polyline.getVertices()[0].x, sizeof(glm::vec3), polyline.size());
+		}
+		bHasContours = true;
+	}
+	return bHasContours;
+}
+
+//----------------------------------------------------------
+void ofTessellator::performClip(ofPolyWindingMode polyWindingMode, vector<ofPolyline>& dstpoly ) {
+	// without an explicit normal the tessellator flips the orientation
+	// when the total area is negative, which would change the meaning of
+	// the winding numbers
+	const TESSreal normal[3] = {0, 0, 1};
+	if (!tessTesselate(cacheTess, polyWindingMode, TESS_BOUNDARY_CONTOURS, 0, 3, normal)){
+		ofLogError("ofTessellator") << "performClip(): polyline boundary contours tessellation failed, winding mode " << polyWindingMode;
+		dstpoly.clear();
+		return;
+	}
+	numTessellations++;
+
+	const ofDefaultVertexType* verts = (ofDefaultVertexType*)tessGetVertices(cacheTess);
+	const TESSindex* elems = tessGetElements(cacheTess);
+	const int nelems = tessGetElementCount(cacheTess);
+	dstpoly.resize(nelems);
+	for (int i = 0; i < nelems; ++i){
+		int b = elems[i*2];
+		int n = elems[i*2+1];
+		dstpoly[i].clear();
+		dstpoly[i].addVertices(&verts[b],n);
+		dstpoly[i].setClosed(true);
+	}
+}
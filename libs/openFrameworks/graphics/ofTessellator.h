@@ -7,6 +7,44 @@
 typedef struct TESStesselator TESStesselator;
 typedef struct TESSalloc TESSalloc;
 
+namespace of{
+	namespace priv{
+		// bump allocator for libtess2. everything allocated during a
+		// tessellation, including the tessellator itself, is released at
+		// once when the next one starts instead of freeing every node
+		class TessellatorArena{
+		public:
+			void * allocate(std::size_t size);
+			void * reallocate(void * ptr, std::size_t size);
+			void reset(std::size_t expectedBytes);
+
+			std::size_t getUsedBytes() const;
+			std::size_t getCapacity() const;
+
+			// counters since the arena was created or resetStats() called
+			std::size_t getPeakBytes() const;
+			std::size_t getNumAllocations() const;
+			std::size_t getNumBlockAllocations() const;
+			void resetStats();
+
+		private:
+			struct Block{
+				std::unique_ptr<char[]> data;
+				std::size_t size;
+			};
+			std::vector<Block> blocks;
+			std::size_t currentBlock = 0;
+			std::size_t offset = 0;
+			std::size_t usedBytes = 0;
+			std::size_t highWaterMark = 0;
+			char * lastAllocation = nullptr;
+			std::size_t peakBytes = 0;
+			std::size_t numAllocations = 0;
+			std::size_t numBlockAllocations = 0;
+		};
+	}
+}
+
 /// \brief
 /// ofTessellator exists for one purpose: to turn ofPolylines into ofMeshes so
 /// that they can be more efficiently displayed using OpenGL. The ofPath class
@@ -49,14 +87,60 @@ public:
 	/// \brief Tessellate multiple polylines into a single polyline.
 	void tessellateToPolylines( const ofPolyline & src, ofPolyWindingMode polyWindingMode, std::vector<ofPolyline>& dstpoly, bool bIs2D=false );
 
+	/// \brief Computes a boolean operation between the areas filled by two
+	/// vectors of ofPolyline instances, each with its own winding mode.
+	///
+	/// The result is a set of closed contours on the xy plane that don't
+	/// intersect each other. Outer contours have a positive
+	/// ofPolyline::getArea() and holes a negative one, so they can be filled
+	/// with any winding mode but OF_POLY_WINDING_NEGATIVE and
+	/// OF_POLY_WINDING_ABS_GEQ_TWO. Self intersecting and overlapping inputs
+	/// are resolved by the same sweep line used for tessellation. Open
+	/// polylines are treated as closed.
+	void clipToPolylines( const std::vector<ofPolyline>& subject, ofPolyWindingMode subjectWindingMode, const std::vector<ofPolyline>& clip, ofPolyWindingMode clipWindingMode, ofPolyClipType clipType, std::vector<ofPolyline>& dstpoly );
+
+	/// \brief Grows the area filled by a vector of ofPolyline instances by
+	/// delta, or shrinks it if delta is negative.
+	///
+	/// Corners that move outwards are joined with join, miters longer than
+	/// miterLimit times delta are beveled and round joins are never further
+	/// than roundTolerance from an exact circle. The result has the same
+	/// orientation as clipToPolylines().
+	void offsetToPolylines( const std::vector<ofPolyline>& src, ofPolyWindingMode polyWindingMode, float delta, std::vector<ofPolyline>& dstpoly, ofLineJoin join=OF_LINE_JOIN_MITER, float miterLimit=4, float roundTolerance=0.25f );
+
+	/// \brief Memory used by libtess2 in this tessellator.
+	///
+	/// All the memory for a tessellation comes from an arena that is reused
+	/// by the next one, sized from the number of vertices of the input and
+	/// grown when needed. Peak bytes tell how big a single tessellation got
+	/// and blocks how many times the arena had to ask the system for memory.
+	struct AllocationStats{
+		std::size_t peakBytes = 0;
+		std::size_t allocations = 0;
+		std::size_t blocks = 0;
+		std::size_t tessellations = 0;
+	};
+
+	/// \brief Get the allocation counters since the tessellator was created
+	/// or resetAllocationStats() was called.
+	AllocationStats getAllocationStats() const;
+
+	/// \brief Sets all the allocation counters to 0.
+	void resetAllocationStats();
+
 private:
-	
+
 	void performTessellation( ofPolyWindingMode polyWindingMode, ofMesh& dstmesh, bool bIs2D );
 	void performTessellation(ofPolyWindingMode polyWindingMode, std::vector<ofPolyline>& dstpoly, bool bIs2D );
+	bool addContours( const std::vector<ofPolyline>& src, bool bReversed );
+	void performClip( ofPolyWindingMode polyWindingMode, std::vector<ofPolyline>& dstpoly );
 	void init();
+	void beginTessellation(std::size_t numVertices);
 
 	TESStesselator * cacheTess;
 	TESSalloc tessAllocator;
+	of::priv::TessellatorArena arena;
+	std::size_t numTessellations;
 };
 
 
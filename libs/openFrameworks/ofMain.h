@@ -15,6 +15,9 @@
 #if !defined(TARGET_EMSCRIPTEN)
 #include "ofThread.h"
 #include "ofThreadChannel.h"
+#include "ofBoundedThreadChannel.h"
+#include "ofTaskPool.h"
+#include "ofParallel.h"
 #endif
 
 #include "ofFpsCounter.h"
@@ -30,6 +33,8 @@
 #include "ofRectangle.h"
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
+#include "ofParameterLayout.h"
+#include "ofAtomicParameter.h"
 
 //--------------------------
 // math
@@ -54,6 +59,7 @@
 #include "ofTexture.h"
 #include "ofVbo.h"
 #include "ofVboMesh.h"
+#include "ofInterleavedMesh.h"
 // #include "ofGLProgrammableRenderer.h"
 // #ifndef TARGET_PROGRAMMABLE_GL
 // 	#include "ofGLRenderer.h"
@@ -69,7 +75,10 @@
 #include "ofPath.h"
 #include "ofPixels.h"
 #include "ofPolyline.h"
+#include "ofPolylineIndex.h"
 #include "ofRendererCollection.h"
+#include "ofStroker.h"
+#include "ofTessellationCache.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
 
@@ -110,7 +119,9 @@
 #include "ofCamera.h"
 #include "ofEasyCam.h"
 #include "ofMesh.h"
+#include "ofMeshBVH.h"
 #include "ofNode.h"
+#include "ofPrimitiveCache.h"
 
 //--------------------------
 using namespace std;
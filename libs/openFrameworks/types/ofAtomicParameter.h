@@ -0,0 +1,275 @@
+#pragma once
+
+#include "ofParameter.h"
+#include <atomic>
+#include <type_traits>
+
+/// \brief How ofAtomicParameter::smooth() moves towards a new value.
+enum ofParameterSmoothing{
+	/// \brief Jumps to the new value on the next block.
+	OF_PARAMETER_SMOOTHING_NONE,
+	/// \brief Moves to the new value at a constant rate, reaching it after
+	/// the smoothing time.
+	OF_PARAMETER_SMOOTHING_LINEAR,
+	/// \brief Moves a fraction of the remaining distance every block, the
+	/// smoothing time is the time constant of the filter.
+	OF_PARAMETER_SMOOTHING_ONE_POLE,
+};
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// single writer storage for trivially copyable values. values that fit
+	// in a word are read and written with one atomic operation, bigger
+	// ones are split in words protected by a sequence counter: readers
+	// never block, they only copy again when a write happened meanwhile
+	template<typename T>
+	class AtomicValue{
+	public:
+		static_assert(std::is_trivially_copyable<T>::value, "ofAtomicParameter needs a trivially copyable type");
+
+		void store(const T & value){
+			uint64_t words[NumWords] = {};
+			memcpy(words, &value, sizeof(T));
+			if(NumWords == 1){
+				data[0].store(words[0], std::memory_order_release);
+				return;
+			}
+			auto seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for(std::size_t i = 0; i < NumWords; i++){
+				data[i].store(words[i], std::memory_order_relaxed);
+			}
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+
+		T load() const{
+			uint64_t words[NumWords];
+			if(NumWords == 1){
+				words[0] = data[0].load(std::memory_order_acquire);
+			}else{
+				while(true){
+					auto seq = sequence.load(std::memory_order_acquire);
+					for(std::size_t i = 0; i < NumWords; i++){
+						words[i] = data[i].load(std::memory_order_relaxed);
+					}
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if((seq & 1) == 0 && sequence.load(std::memory_order_relaxed) == seq){
+						break;
+					}
+				}
+			}
+			T value;
+			memcpy(&value, words, sizeof(T));
+			return value;
+		}
+
+	private:
+		static const std::size_t NumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+		std::atomic<uint64_t> data[NumWords];
+		std::atomic<uint32_t> sequence{0};
+	};
+}
+}
+/*! \endcond */
+
+/// \brief An ofParameter that can be read from another thread, usually the
+/// audio thread, without locks.
+///
+/// Reading an ofParameter while the main thread sets it, from a GUI or
+/// OSC, is a data race and protecting it with a mutex can make the audio
+/// thread wait for the main one. An ofAtomicParameter is an ofParameter,
+/// so it can be added to groups, GUIs and serialized as usual, that also
+/// keeps a copy of its value that load() reads without ever blocking:
+///
+/// ~~~~{.cpp}
+/// ofAtomicParameter<float> volume{"volume", 0.5, 0, 1};
+/// gui.add(volume);
+///
+/// void ofApp::audioOut(ofSoundBuffer & buffer){
+///     float gain = volume.smooth(buffer.getNumFrames(), buffer.getSampleRate());
+///     ...
+/// }
+/// ~~~~
+///
+/// The copy is updated when the parameter notifies its listeners, before
+/// any other listener, so parameters set inside an ofParameterTransaction
+/// reach load() when it's committed. Sets without notifications through
+/// other references to the same parameter don't update it.
+///
+/// ParameterType has to be trivially copyable. Values up to 8 bytes are
+/// read with a single atomic load, bigger ones like vectors and colors
+/// copy again if they were being written at the same time. The parameter
+/// is meant to be set from one thread at a time.
+template<typename ParameterType>
+class ofAtomicParameter: public ofParameter<ParameterType>{
+public:
+	ofAtomicParameter();
+	ofAtomicParameter(const ofAtomicParameter<ParameterType> & v);
+	ofAtomicParameter(const ParameterType & v);
+	ofAtomicParameter(const std::string& name, const ParameterType & v);
+	ofAtomicParameter(const std::string& name, const ParameterType & v, const ParameterType & min, const ParameterType & max);
+
+	using ofParameter<ParameterType>::operator=;
+	ofAtomicParameter<ParameterType> & operator=(const ofAtomicParameter<ParameterType> & v);
+
+	/// \brief Last value set, can be called from any thread without blocking.
+	ParameterType load() const;
+
+	/// \brief Sets how smooth() moves towards new values, time is in
+	/// seconds. Can be called from any thread.
+	void setSmoothing(ofParameterSmoothing mode, float time);
+
+	/// \brief Advances the smoothing by a block of numFrames frames and
+	/// returns the value at its end.
+	///
+	/// Keeps the smoothed value between calls, so it should be called
+	/// once per block from a single thread. The value at the start of the
+	/// block, to interpolate per frame, is getBlockStart(). Only available
+	/// for floating point types, vectors and float colors.
+	ParameterType smooth(std::size_t numFrames, float sampleRate);
+
+	/// \brief Smoothed value at the start of the last block.
+	ParameterType getBlockStart() const;
+
+	ofAtomicParameter<ParameterType> & setWithoutEventNotifications(const ParameterType & v);
+	void makeReferenceTo(ofAtomicParameter<ParameterType> & mom);
+	std::string type() const;
+
+private:
+	struct Shared{
+		of::priv::AtomicValue<ParameterType> value;
+		std::atomic<int> smoothingMode{OF_PARAMETER_SMOOTHING_NONE};
+		std::atomic<float> smoothingTime{0.f};
+		ofEventListener listener;
+
+		// only used by the thread that calls smooth()
+		bool smoothing = false;
+		ParameterType current;
+		ParameterType blockStart;
+		ParameterType target;
+		ParameterType step;
+		double remainingFrames = 0;
+	};
+
+	void init();
+
+	std::shared_ptr<Shared> shared;
+};
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType>::ofAtomicParameter(){
+	init();
+}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType>::ofAtomicParameter(const ofAtomicParameter<ParameterType> & v)
+:ofParameter<ParameterType>(v)
+,shared(v.shared){}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType>::ofAtomicParameter(const ParameterType & v)
+:ofParameter<ParameterType>(v){
+	init();
+}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType>::ofAtomicParameter(const std::string& name, const ParameterType & v)
+:ofParameter<ParameterType>(name, v){
+	init();
+}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType>::ofAtomicParameter(const std::string& name, const ParameterType & v, const ParameterType & min, const ParameterType & max)
+:ofParameter<ParameterType>(name, v, min, max){
+	init();
+}
+
+template<typename ParameterType>
+void ofAtomicParameter<ParameterType>::init(){
+	shared = std::make_shared<Shared>();
+	shared->value.store(this->get());
+	auto value = &shared->value;
+	shared->listener = this->newListener([value](ParameterType & v){
+		value->store(v);
+	}, OF_EVENT_ORDER_BEFORE_APP);
+}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType> & ofAtomicParameter<ParameterType>::operator=(const ofAtomicParameter<ParameterType> & v){
+	this->set(v.get());
+	return *this;
+}
+
+template<typename ParameterType>
+inline ParameterType ofAtomicParameter<ParameterType>::load() const{
+	return shared->value.load();
+}
+
+template<typename ParameterType>
+void ofAtomicParameter<ParameterType>::setSmoothing(ofParameterSmoothing mode, float time){
+	shared->smoothingTime.store(time);
+	shared->smoothingMode.store(mode);
+}
+
+template<typename ParameterType>
+ParameterType ofAtomicParameter<ParameterType>::smooth(std::size_t numFrames, float sampleRate){
+	auto & s = *shared;
+	auto target = s.value.load();
+	auto mode = ofParameterSmoothing(s.smoothingMode.load());
+	auto frames = std::max(s.smoothingTime.load() * sampleRate, 1.f);
+	if(!s.smoothing || mode == OF_PARAMETER_SMOOTHING_NONE){
+		s.smoothing = true;
+		s.blockStart = target;
+		s.current = target;
+		s.target = target;
+		s.remainingFrames = 0;
+		return target;
+	}
+
+	s.blockStart = s.current;
+	if(mode == OF_PARAMETER_SMOOTHING_LINEAR){
+		if(!(target == s.target)){
+			s.target = target;
+			s.remainingFrames = frames;
+			s.step = (target - s.current) * float(1.0 / frames);
+		}
+		if(s.remainingFrames <= numFrames){
+			s.current = target;
+			s.remainingFrames = 0;
+		}else{
+			s.current = s.current + s.step * float(numFrames);
+			s.remainingFrames -= numFrames;
+		}
+	}else{
+		s.target = target;
+		auto amount = float(1.0 - std::exp(-double(numFrames) / frames));
+		s.current = s.current + (target - s.current) * amount;
+	}
+	return s.current;
+}
+
+template<typename ParameterType>
+inline ParameterType ofAtomicParameter<ParameterType>::getBlockStart() const{
+	return shared->blockStart;
+}
+
+template<typename ParameterType>
+ofAtomicParameter<ParameterType> & ofAtomicParameter<ParameterType>::setWithoutEventNotifications(const ParameterType & v){
+	ofParameter<ParameterType>::setWithoutEventNotifications(v);
+	shared->value.store(v);
+	return *this;
+}
+
+template<typename ParameterType>
+void ofAtomicParameter<ParameterType>::makeReferenceTo(ofAtomicParameter<ParameterType> & mom){
+	ofParameter<ParameterType>::makeReferenceTo(mom);
+	shared = mom.shared;
+}
+
+template<typename ParameterType>
+std::string ofAtomicParameter<ParameterType>::type() const{
+	// groups and GUIs look for the type of the ofParameter
+	return typeid(ofParameter<ParameterType>).name();
+}
@@ -147,3 +147,155 @@ void ofParameter<void>::setParent(ofParameterGroup & parent){
 size_t ofParameter<void>::getNumListeners() const{
 	return obj->changedE.size();
 }
+
+namespace{
+#if defined(TARGET_EMSCRIPTEN)
+	ofParameterTransaction * currentTransaction = nullptr;
+#elif HAS_TLS
+	thread_local ofParameterTransaction * currentTransaction = nullptr;
+#else
+	// without thread local storage a transaction also batches the sets
+	// from other threads
+	ofParameterTransaction * currentTransaction = nullptr;
+#endif
+}
+
+ofParameterTransaction::ofParameterTransaction()
+:queue(nullptr)
+,outer(currentTransaction)
+,inner(nullptr){
+	if(outer){
+		outer->inner = this;
+	}
+	currentTransaction = this;
+}
+
+ofParameterTransaction::ofParameterTransaction(ofEventQueue & queue)
+:queue(&queue)
+,outer(currentTransaction)
+,inner(nullptr){
+	if(outer){
+		outer->inner = this;
+	}
+	currentTransaction = this;
+}
+
+ofParameterTransaction::~ofParameterTransaction(){
+	// unlink from the transactions of this thread in case they aren't
+	// destroyed in reverse order. listeners notified by the commit can set
+	// parameters normally
+	if(inner){
+		inner->outer = outer;
+	}
+	if(outer){
+		outer->inner = inner;
+	}
+	if(currentTransaction == this){
+		currentTransaction = outer;
+	}
+	commit();
+}
+
+void ofParameterTransaction::commit(){
+	if(changes.empty()){
+		return;
+	}
+	Changes committed;
+	std::swap(committed, changes);
+	if(outer){
+		outer->changes.merge(std::move(committed));
+	}else if(queue){
+		post(*queue, std::move(committed));
+	}else{
+		committed.notify();
+	}
+}
+
+size_t ofParameterTransaction::size() const{
+	return changes.size();
+}
+
+bool ofParameterTransaction::isActive(){
+	return currentTransaction != nullptr;
+}
+
+ofParameterTransaction * ofParameterTransaction::getCurrent(){
+	return currentTransaction;
+}
+
+void ofParameterTransaction::post(ofEventQueue & queue, Changes && changes){
+	// changes posted to the same queue are merged until it's flushed
+	static auto & mutex = *(new std::mutex);
+	static auto & pending = *(new std::unordered_map<ofEventQueue*, std::shared_ptr<Changes>>);
+	std::shared_ptr<Changes> queued;
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		auto & entry = pending[&queue];
+		if(!entry){
+			entry = std::make_shared<Changes>();
+		}
+		entry->merge(std::move(changes));
+		queued = entry;
+	}
+	queue.post(queued.get(), [queued, &queue]{
+		Changes batch;
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			std::swap(batch, *queued);
+			auto it = pending.find(&queue);
+			if(it != pending.end() && it->second == queued){
+				pending.erase(it);
+			}
+		}
+		batch.notify();
+	}, OF_EVENT_POST_LATEST);
+}
+
+void ofParameterTransaction::Changes::add(Change && change){
+	if(keys.insert(change.key).second){
+		changes.push_back(std::move(change));
+	}
+}
+
+void ofParameterTransaction::Changes::merge(Changes && other){
+	for(auto & change: other.changes){
+		add(std::move(change));
+	}
+	other.changes.clear();
+	other.keys.clear();
+}
+
+void ofParameterTransaction::Changes::notify(){
+	std::vector<std::shared_ptr<ofParameterGroup::Value>> groups;
+	for(auto & change: changes){
+		change.notify(*change.parameter, groups);
+	}
+
+	// every group that contains a changed parameter, directly or through
+	// its subgroups, is notified once
+	std::unordered_set<const void*> visited;
+	std::vector<std::shared_ptr<ofParameterGroup::Value>> changedGroups;
+	for(size_t i = 0; i < groups.size(); i++){
+		auto group = groups[i];
+		if(visited.insert(group.get()).second){
+			changedGroups.push_back(group);
+			for(auto & parent: group->parents){
+				auto p = parent.lock();
+				if(p){
+					groups.push_back(p);
+				}
+			}
+		}
+	}
+	for(auto & group: changedGroups){
+		ofNotifyEvent(group->batchChangedE);
+	}
+}
+
+bool ofParameterTransaction::Changes::empty() const{
+	return changes.empty();
+}
+
+size_t ofParameterTransaction::Changes::size() const{
+	return changes.size();
+}
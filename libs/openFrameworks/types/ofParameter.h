@@ -6,6 +6,7 @@
 #include "ofColor.h"
 #include "ofLog.h"
 #include <map>
+#include <unordered_set>
 
 template<typename ParameterType>
 class ofParameter;
@@ -15,6 +16,8 @@ class ofReadOnlyParameter;
 
 class ofParameterGroup;
 
+class ofParameterTransaction;
+
 
 
 //----------------------------------------------------------------------
@@ -241,6 +244,16 @@ public:
 
 	ofEvent<ofAbstractParameter> & parameterChangedE();
 
+	/// \brief Notified once after parameters in the group or its subgroups
+	/// change.
+	///
+	/// parameterChangedE is notified for every parameter that changes,
+	/// batchChangedE after every set outside of an ofParameterTransaction
+	/// and only once per commit of a transaction, no matter how many
+	/// parameters of the group it changed. Listen to it to update
+	/// whatever depends on the group as a whole.
+	ofEvent<void> & batchChangedE();
+
 	std::vector<std::shared_ptr<ofAbstractParameter> >::iterator begin();
 	std::vector<std::shared_ptr<ofAbstractParameter> >::iterator end();
 	std::vector<std::shared_ptr<ofAbstractParameter> >::const_iterator begin() const;
@@ -259,7 +272,7 @@ private:
 		Value()
 		:serializable(true){}
 
-		void notifyParameterChanged(ofAbstractParameter & param);
+		void notifyParameterChanged(ofAbstractParameter & param, bool notifyBatch = true);
 
 		std::map<std::string,std::size_t> parametersIndex;
 		std::vector<std::shared_ptr<ofAbstractParameter> > parameters;
@@ -267,6 +280,7 @@ private:
 		bool serializable;
 		std::vector<std::weak_ptr<Value>> parents;
 		ofEvent<ofAbstractParameter> parameterChangedE;
+		ofEvent<void> batchChangedE;
 	};
 	std::shared_ptr<Value> obj;
 	ofParameterGroup(std::shared_ptr<Value> obj)
@@ -278,6 +292,8 @@ private:
 	template<typename T, typename F>
 	friend class ofReadOnlyParameter;
 
+	friend class ofParameterTransaction;
+
 	const ofParameterGroup getFirstParent() const;
 };
 
@@ -323,6 +339,110 @@ ofReadOnlyParameter<ParameterType, Friend> & ofParameterGroup::getReadOnly(std::
 }
 
 
+/// \brief Batches the notifications of the parameters set while it exists.
+///
+/// Every set of an ofParameter notifies its listeners and all the groups
+/// it belongs to, so loading a preset, syncing a group through OSC or
+/// dragging a slider that drives other parameters can trigger the same
+/// listeners many times per frame. While an ofParameterTransaction
+/// exists, parameters set from the same thread take their new value
+/// right away but their notifications wait until the transaction is
+/// committed. Then each parameter that changed notifies its listeners
+/// once with its last value, each group notifies parameterChangedE once
+/// per changed parameter and ofParameterGroup::batchChangedE() once:
+///
+/// ~~~~{.cpp}
+/// {
+///     ofParameterTransaction transaction;
+///     for(auto & particle: particles){
+///         particle.size = size;
+///         particle.speed = speed;
+///     }
+/// } // listeners are notified here
+/// ~~~~
+///
+/// A transaction created with a queue doesn't notify when it's committed
+/// but when the queue is flushed. The changes of all the transactions
+/// committed to a queue in between are merged, so with
+/// ofGetMainEventQueue() listeners are notified at most once per frame,
+/// before update(), even if the parameters are set from several places.
+///
+/// Only the notifications are deferred, the values are still written
+/// when the parameters are set. A queued transaction doesn't make it safe
+/// to set parameters from another thread while the main thread reads
+/// them, set them from the thread that owns them or use
+/// ofAtomicParameter.
+///
+/// A transaction created while another one exists in the same thread
+/// hands its changes to the outer one when it's committed. Transactions
+/// don't need to be destroyed in the reverse order they were created, the
+/// changes of an inner transaction go to the closest outer one still
+/// alive.
+class ofParameterTransaction{
+public:
+	ofParameterTransaction();
+	ofParameterTransaction(ofEventQueue & queue);
+	ofParameterTransaction(const ofParameterTransaction &) = delete;
+	ofParameterTransaction & operator=(const ofParameterTransaction &) = delete;
+
+	/// \brief Commits the changes that are still pending.
+	~ofParameterTransaction();
+
+	/// \brief Notifies the changes made so far, or posts them to the queue.
+	///
+	/// Parameters set after committing, including from the listeners
+	/// notified by the commit, are batched again until the next commit or
+	/// the end of the transaction.
+	void commit();
+
+	/// \brief Number of parameters changed since the last commit.
+	std::size_t size() const;
+
+	/// \brief Whether parameters set from this thread are being batched.
+	static bool isActive();
+
+private:
+	struct Change{
+		const void * key;
+		std::shared_ptr<ofAbstractParameter> parameter;
+		void (*notify)(ofAbstractParameter & parameter, std::vector<std::shared_ptr<ofParameterGroup::Value>> & groups);
+	};
+
+	class Changes{
+	public:
+		template<typename ParameterType>
+		void add(ofParameter<ParameterType> & parameter);
+		void add(Change && change);
+		void merge(Changes && changes);
+		void notify();
+		bool empty() const;
+		std::size_t size() const;
+	private:
+		std::vector<Change> changes;
+		std::unordered_set<const void*> keys;
+	};
+
+	static ofParameterTransaction * getCurrent();
+	static void post(ofEventQueue & queue, Changes && changes);
+
+	Changes changes;
+	ofEventQueue * queue;
+	ofParameterTransaction * outer;
+	ofParameterTransaction * inner;
+
+	template<typename ParameterType>
+	friend class ofParameter;
+};
+
+template<typename ParameterType>
+void ofParameterTransaction::Changes::add(ofParameter<ParameterType> & parameter){
+	auto key = parameter.getInternalObject();
+	if(keys.insert(key).second){
+		changes.push_back({key, parameter.newReference(), &ofParameter<ParameterType>::notifyCommitted});
+	}
+}
+
+
 /*! \cond PRIVATE */
 namespace of{
 namespace priv{
@@ -630,9 +750,13 @@ private:
 
 	void eventsSetValue(const ParameterType & v);
 	void noEventsSetValue(const ParameterType & v);
+	void notifyChanged(bool notifyBatch);
+	static void notifyCommitted(ofAbstractParameter & parameter, std::vector<std::shared_ptr<ofParameterGroup::Value>> & groups);
 
 	template<typename T, typename F>
 	friend class ofReadOnlyParameter;
+
+	friend class ofParameterTransaction;
 };
 
 
@@ -719,6 +843,12 @@ inline void ofParameter<ParameterType>::eventsSetValue(const ParameterType & v){
 	{
 		noEventsSetValue(v);
 	}
+	// Inside a transaction, set the value now and notify when it's committed.
+	else if(auto transaction = ofParameterTransaction::getCurrent())
+	{
+		noEventsSetValue(v);
+		transaction->changes.add(*this);
+	}
 	else
 	{
 		// Mark the object as in its notification loop.
@@ -727,30 +857,53 @@ inline void ofParameter<ParameterType>::eventsSetValue(const ParameterType & v){
 		// Set the value.
 		obj->value = v;
 
-		// Notify any local subscribers.
-		ofNotifyEvent(obj->changedE,obj->value,this);
-
-		// Notify all parents, if there are any.
-		if(!obj->parents.empty())
-		{
-			// Erase each invalid parent
-			obj->parents.erase(std::remove_if(obj->parents.begin(),
-											  obj->parents.end(),
-											  [this](const std::weak_ptr<ofParameterGroup::Value> & p){ return p.expired(); }),
-							   obj->parents.end());
-
-			// notify all leftover (valid) parents of this object's changed value.
-			// this can't happen in the same iterator as above, because a notified listener
-			// might perform similar cleanups that would corrupt our iterator
-			// (which appens for example if the listener calls getFirstParent on us)
-			for(auto & parent: obj->parents){
-				auto p = parent.lock();
-				if(p){
-					p->notifyParameterChanged(*this);
-				}
+		notifyChanged(true);
+
+		obj->bInNotify = false;
+	}
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::notifyChanged(bool notifyBatch){
+	// Notify any local subscribers.
+	ofNotifyEvent(obj->changedE,obj->value,this);
+
+	// Notify all parents, if there are any.
+	if(!obj->parents.empty())
+	{
+		// Erase each invalid parent
+		obj->parents.erase(std::remove_if(obj->parents.begin(),
+										  obj->parents.end(),
+										  [this](const std::weak_ptr<ofParameterGroup::Value> & p){ return p.expired(); }),
+						   obj->parents.end());
+
+		// notify all leftover (valid) parents of this object's changed value.
+		// this can't happen in the same iterator as above, because a notified listener
+		// might perform similar cleanups that would corrupt our iterator
+		// (which appens for example if the listener calls getFirstParent on us)
+		for(auto & parent: obj->parents){
+			auto p = parent.lock();
+			if(p){
+				p->notifyParameterChanged(*this, notifyBatch);
 			}
 		}
-		obj->bInNotify = false;
+	}
+}
+
+template<typename ParameterType>
+void ofParameter<ParameterType>::notifyCommitted(ofAbstractParameter & parameter, std::vector<std::shared_ptr<ofParameterGroup::Value>> & groups){
+	auto & typed = static_cast<ofParameter<ParameterType>&>(parameter);
+	if(typed.obj->bInNotify){
+		return;
+	}
+	typed.obj->bInNotify = true;
+	typed.notifyChanged(false);
+	typed.obj->bInNotify = false;
+	for(auto & parent: typed.obj->parents){
+		auto p = parent.lock();
+		if(p){
+			groups.push_back(p);
+		}
 	}
 }
 
@@ -404,11 +404,14 @@ bool ofParameterGroup::contains(const string& name) const{
 	return obj->parametersIndex.find(escape(name))!=obj->parametersIndex.end();
 }
 
-void ofParameterGroup::Value::notifyParameterChanged(ofAbstractParameter & param){
+void ofParameterGroup::Value::notifyParameterChanged(ofAbstractParameter & param, bool notifyBatch){
 	ofNotifyEvent(parameterChangedE,param);
-	parents.erase(std::remove_if(parents.begin(),parents.end(),[&param](const weak_ptr<Value> & p){
+	if(notifyBatch){
+		ofNotifyEvent(batchChangedE);
+	}
+	parents.erase(std::remove_if(parents.begin(),parents.end(),[&param,notifyBatch](const weak_ptr<Value> & p){
 		auto parent = p.lock();
-		if(parent) parent->notifyParameterChanged(param);
+		if(parent) parent->notifyParameterChanged(param,notifyBatch);
 		return !parent;
 	}),parents.end());
 }
@@ -426,6 +429,10 @@ ofEvent<ofAbstractParameter> & ofParameterGroup::parameterChangedE(){
 	return obj->parameterChangedE;
 }
 
+ofEvent<void> & ofParameterGroup::batchChangedE(){
+	return obj->batchChangedE;
+}
+
 ofAbstractParameter & ofParameterGroup::back(){
 	return *obj->parameters.back();
 }
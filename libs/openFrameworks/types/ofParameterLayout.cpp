@@ -0,0 +1,412 @@
+#include "ofParameterLayout.h"
+#include "ofFileUtils.h"
+#include <unordered_map>
+
+using namespace std;
+
+namespace{
+	// conversion of each parameter type to and from its floats in a snapshot
+	template<typename T, int N>
+	struct VectorComponents{
+		static const std::size_t numFloats = N;
+		static void toFloats(const T & value, float * dst){
+			for(int i = 0; i < N; i++){
+				dst[i] = value[i];
+			}
+		}
+		static T fromFloats(const float * src){
+			T value;
+			for(int i = 0; i < N; i++){
+				value[i] = src[i];
+			}
+			return value;
+		}
+	};
+
+	template<typename T>
+	struct ColorComponents{
+		static const std::size_t numFloats = 4;
+		static void toFloats(const ofColor_<T> & value, float * dst){
+			for(int i = 0; i < 4; i++){
+				dst[i] = value[i];
+			}
+		}
+		static ofColor_<T> fromFloats(const float * src){
+			ofColor_<T> value;
+			for(int i = 0; i < 4; i++){
+				value[i] = T(std::round(std::max(0.f, std::min(src[i], float(ofColor_<T>::limit())))));
+			}
+			return value;
+		}
+	};
+
+	template<typename T>
+	struct Components;
+
+	template<>
+	struct Components<bool>{
+		static const std::size_t numFloats = 1;
+		static void toFloats(const bool & value, float * dst){
+			dst[0] = value ? 1.f : 0.f;
+		}
+		static bool fromFloats(const float * src){
+			return src[0] > 0.5f;
+		}
+	};
+
+	// ints and doubles have more precision than a float, they are split
+	// in a sum of floats, each holding the rest of the previous ones, so
+	// they are restored exactly and still interpolate linearly
+	template<typename T, int N>
+	struct SplitComponents{
+		static const std::size_t numFloats = N;
+		static void toFloats(const T & value, float * dst){
+			double rest = value;
+			for(int i = 0; i < N; i++){
+				dst[i] = float(rest);
+				rest -= dst[i];
+			}
+		}
+		static double sum(const float * src){
+			double value = 0;
+			for(int i = 0; i < N; i++){
+				value += src[i];
+			}
+			return value;
+		}
+	};
+
+	template<>
+	struct Components<int>: SplitComponents<int, 2>{
+		static int fromFloats(const float * src){
+			return int(std::round(sum(src)));
+		}
+	};
+
+	template<>
+	struct Components<float>{
+		static const std::size_t numFloats = 1;
+		static void toFloats(const float & value, float * dst){
+			dst[0] = value;
+		}
+		static float fromFloats(const float * src){
+			return src[0];
+		}
+	};
+
+	template<>
+	struct Components<double>: SplitComponents<double, 3>{
+		static double fromFloats(const float * src){
+			return sum(src);
+		}
+	};
+
+	template<> struct Components<glm::vec2>: VectorComponents<glm::vec2, 2>{};
+	template<> struct Components<glm::vec3>: VectorComponents<glm::vec3, 3>{};
+	template<> struct Components<glm::vec4>: VectorComponents<glm::vec4, 4>{};
+	template<> struct Components<ofVec2f>: VectorComponents<ofVec2f, 2>{};
+	template<> struct Components<ofVec3f>: VectorComponents<ofVec3f, 3>{};
+	template<> struct Components<ofVec4f>: VectorComponents<ofVec4f, 4>{};
+	template<> struct Components<ofColor>: ColorComponents<unsigned char>{};
+	template<> struct Components<ofShortColor>: ColorComponents<unsigned short>{};
+	template<> struct Components<ofFloatColor>: VectorComponents<ofFloatColor, 4>{};
+
+	template<typename T>
+	struct ParameterAccess{
+		static void capture(const ofAbstractParameter & parameter, float * dst){
+			Components<T>::toFloats(parameter.cast<T>().get(), dst);
+		}
+
+		static bool restore(ofAbstractParameter & parameter, const float * src){
+			auto & typed = parameter.cast<T>();
+			auto value = Components<T>::fromFloats(src);
+			if(value == typed.get()){
+				return false;
+			}
+			typed.setWithoutEventNotifications(value);
+			return true;
+		}
+
+		static void notify(ofAbstractParameter & parameter){
+			auto & typed = parameter.cast<T>();
+			typed.set(typed.get());
+		}
+	};
+
+	const char fileMagic[4] = {'o','f','p','l'};
+
+	template<typename T>
+	void write(ofBuffer & buffer, const T & value){
+		buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool read(const ofBuffer & buffer, std::size_t & position, T & value){
+		if(position + sizeof(T) > buffer.size()){
+			return false;
+		}
+		memcpy(&value, buffer.getData() + position, sizeof(T));
+		position += sizeof(T);
+		return true;
+	}
+}
+
+const uint32_t ofParameterLayout::FileVersion;
+
+//----------------------------------------------------------
+ofParameterLayout::ofParameterLayout(ofParameterGroup & group){
+	setup(group);
+}
+
+//----------------------------------------------------------
+void ofParameterLayout::setup(ofParameterGroup & group){
+	entries.clear();
+	snapshotSize = 0;
+	std::unordered_set<const void*> added;
+	addGroup(group, "", added);
+
+	hash = 14695981039346656037ull;
+	auto add = [this](const void * data, size_t size){
+		auto bytes = static_cast<const unsigned char*>(data);
+		for(size_t i = 0; i < size; i++){
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	for(auto & entry: entries){
+		add(entry.path.c_str(), entry.path.size() + 1);
+		add(&entry.type, sizeof(entry.type));
+	}
+}
+
+//----------------------------------------------------------
+void ofParameterLayout::addGroup(ofParameterGroup & group, const std::string & prefix, std::unordered_set<const void*> & added){
+	for(auto & parameter: group){
+		auto path = prefix + parameter->getEscapedName();
+		if(parameter->type() == typeid(ofParameterGroup).name()){
+			addGroup(parameter->castGroup(), path + "/", added);
+			continue;
+		}
+		if(parameter->isReadOnly()){
+			continue;
+		}
+		addParameter<bool>(*parameter, path, Bool, added) ||
+		addParameter<int>(*parameter, path, Int, added) ||
+		addParameter<float>(*parameter, path, Float, added) ||
+		addParameter<double>(*parameter, path, Double, added) ||
+		addParameter<glm::vec2>(*parameter, path, Vec2, added) ||
+		addParameter<glm::vec3>(*parameter, path, Vec3, added) ||
+		addParameter<glm::vec4>(*parameter, path, Vec4, added) ||
+		addParameter<ofVec2f>(*parameter, path, OfVec2, added) ||
+		addParameter<ofVec3f>(*parameter, path, OfVec3, added) ||
+		addParameter<ofVec4f>(*parameter, path, OfVec4, added) ||
+		addParameter<ofColor>(*parameter, path, Color, added) ||
+		addParameter<ofShortColor>(*parameter, path, ShortColor, added) ||
+		addParameter<ofFloatColor>(*parameter, path, FloatColor, added);
+	}
+}
+
+//----------------------------------------------------------
+template<typename T>
+bool ofParameterLayout::addParameter(ofAbstractParameter & parameter, const std::string & path, Type type, std::unordered_set<const void*> & added){
+	auto typed = dynamic_cast<ofParameter<T>*>(&parameter);
+	if(!typed){
+		return false;
+	}
+	// references to the same parameter share the address of their value
+	if(added.insert(&typed->get()).second){
+		Entry entry;
+		entry.parameter = parameter.newReference();
+		entry.path = path;
+		entry.type = type;
+		entry.offset = snapshotSize;
+		entry.numFloats = Components<T>::numFloats;
+		entry.capture = &ParameterAccess<T>::capture;
+		entry.restore = &ParameterAccess<T>::restore;
+		entry.notify = &ParameterAccess<T>::notify;
+		entries.push_back(entry);
+		snapshotSize += entry.numFloats;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+std::size_t ofParameterLayout::size() const{
+	return entries.size();
+}
+
+//----------------------------------------------------------
+std::size_t ofParameterLayout::getSnapshotSize() const{
+	return snapshotSize;
+}
+
+//----------------------------------------------------------
+const std::string & ofParameterLayout::getPath(std::size_t index) const{
+	return entries[index].path;
+}
+
+//----------------------------------------------------------
+std::size_t ofParameterLayout::getOffset(std::size_t index) const{
+	return entries[index].offset;
+}
+
+//----------------------------------------------------------
+uint64_t ofParameterLayout::getHash() const{
+	return hash;
+}
+
+//----------------------------------------------------------
+void ofParameterLayout::capture(std::vector<float> & snapshot) const{
+	snapshot.resize(snapshotSize);
+	float * dst = snapshot.data();
+	for(auto & entry: entries){
+		entry.capture(*entry.parameter, dst + entry.offset);
+	}
+}
+
+//----------------------------------------------------------
+std::vector<float> ofParameterLayout::capture() const{
+	std::vector<float> snapshot;
+	capture(snapshot);
+	return snapshot;
+}
+
+//----------------------------------------------------------
+void ofParameterLayout::restore(const std::vector<float> & snapshot, bool notify){
+	if(snapshot.size() != snapshotSize){
+		ofLogError("ofParameterLayout") << "restore(): snapshot has " << snapshot.size() << " values but the layout needs " << snapshotSize;
+		return;
+	}
+	const float * src = snapshot.data();
+	std::vector<std::size_t> changed;
+	for(std::size_t i = 0; i < entries.size(); i++){
+		auto & entry = entries[i];
+		if(entry.restore(*entry.parameter, src + entry.offset) && notify){
+			changed.push_back(i);
+		}
+	}
+	// notifying inside a transaction lets each group know about the whole
+	// preset once
+	ofParameterTransaction transaction;
+	for(auto i: changed){
+		entries[i].notify(*entries[i].parameter);
+	}
+}
+
+//----------------------------------------------------------
+void ofParameterLayout::lerp(const std::vector<float> & from, const std::vector<float> & to, float amount, std::vector<float> & dst){
+	if(from.size() != to.size()){
+		ofLogError("ofParameterLayout") << "lerp(): snapshots have different sizes, " << from.size() << " and " << to.size();
+		return;
+	}
+	dst.resize(from.size());
+	const float * a = from.data();
+	const float * b = to.data();
+	float * d = dst.data();
+	const std::size_t size = from.size();
+	// plain loop over floats so the compiler can vectorize it
+	for(std::size_t i = 0; i < size; i++){
+		d[i] = a[i] + (b[i] - a[i]) * amount;
+	}
+}
+
+//----------------------------------------------------------
+bool ofParameterLayout::save(const std::filesystem::path & path, const std::vector<float> & snapshot) const{
+	if(snapshot.size() != snapshotSize){
+		ofLogError("ofParameterLayout") << "save(): snapshot has " << snapshot.size() << " values but the layout needs " << snapshotSize;
+		return false;
+	}
+	ofBuffer buffer;
+	buffer.append(fileMagic, sizeof(fileMagic));
+	write(buffer, FileVersion);
+	write(buffer, hash);
+	write(buffer, uint32_t(entries.size()));
+	write(buffer, uint32_t(snapshotSize));
+	for(auto & entry: entries){
+		write(buffer, uint32_t(entry.type));
+		write(buffer, uint32_t(entry.numFloats));
+		write(buffer, uint32_t(entry.path.size()));
+		buffer.append(entry.path.c_str(), entry.path.size());
+	}
+	buffer.append(reinterpret_cast<const char*>(snapshot.data()), snapshot.size() * sizeof(float));
+	if(!ofBufferToFile(path, buffer, true)){
+		ofLogError("ofParameterLayout") << "save(): couldn't write preset \"" << path.string() << "\"";
+		return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------
+bool ofParameterLayout::load(const std::filesystem::path & path, std::vector<float> & snapshot) const{
+	auto buffer = ofBufferFromFile(path, true);
+	std::size_t position = 0;
+	char magic[4];
+	uint32_t version = 0;
+	uint64_t fileHash = 0;
+	uint32_t numEntries = 0;
+	uint32_t numFloats = 0;
+	if(!read(buffer, position, magic) || memcmp(magic, fileMagic, sizeof(magic)) != 0){
+		ofLogError("ofParameterLayout") << "load(): \"" << path.string() << "\" is not a parameter preset";
+		return false;
+	}
+	if(!read(buffer, position, version) || version != FileVersion){
+		ofLogError("ofParameterLayout") << "load(): \"" << path.string() << "\" has version " << version << " but only version " << FileVersion << " is supported";
+		return false;
+	}
+	struct FileEntry{
+		uint32_t type;
+		uint32_t numFloats;
+		std::string path;
+		std::size_t offset;
+	};
+	std::vector<FileEntry> fileEntries;
+	bool valid = read(buffer, position, fileHash) && read(buffer, position, numEntries) && read(buffer, position, numFloats);
+	std::size_t offset = 0;
+	for(uint32_t i = 0; valid && i < numEntries; i++){
+		FileEntry entry;
+		uint32_t pathSize = 0;
+		valid = read(buffer, position, entry.type) && read(buffer, position, entry.numFloats) && read(buffer, position, pathSize) && position + pathSize <= buffer.size();
+		if(valid){
+			entry.path.assign(buffer.getData() + position, pathSize);
+			entry.offset = offset;
+			offset += entry.numFloats;
+			position += pathSize;
+			fileEntries.push_back(entry);
+		}
+	}
+	valid = valid && offset == numFloats && position + numFloats * sizeof(float) <= buffer.size();
+	if(!valid){
+		ofLogError("ofParameterLayout") << "load(): \"" << path.string() << "\" is truncated or corrupted";
+		return false;
+	}
+	// the values in the buffer aren't necessarily aligned for floats
+	std::vector<float> fileValues(numFloats);
+	memcpy(fileValues.data(), buffer.getData() + position, numFloats * sizeof(float));
+
+	if(fileHash == hash && numFloats == snapshotSize){
+		snapshot = std::move(fileValues);
+		return true;
+	}
+
+	// the layout changed since the file was saved, match parameters by
+	// path and type and keep the current value of the rest
+	capture(snapshot);
+	std::unordered_map<std::string, const FileEntry*> byPath;
+	for(auto & fileEntry: fileEntries){
+		byPath[fileEntry.path] = &fileEntry;
+	}
+	std::size_t numMissing = 0;
+	for(auto & entry: entries){
+		auto it = byPath.find(entry.path);
+		if(it == byPath.end() || it->second->type != uint32_t(entry.type) || it->second->numFloats != entry.numFloats){
+			numMissing++;
+			continue;
+		}
+		auto begin = fileValues.begin() + it->second->offset;
+		std::copy(begin, begin + entry.numFloats, snapshot.begin() + entry.offset);
+	}
+	if(numMissing > 0){
+		ofLogWarning("ofParameterLayout") << "load(): " << numMissing << " parameters not found in \"" << path.string() << "\", keeping their current values";
+	}
+	return true;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "ofParameter.h"
+#include <unordered_set>
+
+/// \brief Flat view of the numeric parameters of an ofParameterGroup tree
+/// to capture, restore and interpolate presets quickly.
+///
+/// Saving and loading presets through ofSerialize converts every parameter
+/// to a string and looks it up by name. An ofParameterLayout walks the
+/// group once and keeps a reference to each numeric parameter with its
+/// position in a snapshot, a plain vector of floats. Capturing and
+/// restoring a snapshot only copies values, so presets can be recalled or
+/// crossfaded every frame:
+///
+/// ~~~~{.cpp}
+/// ofParameterLayout layout(parameters);
+/// auto presetA = layout.capture();
+/// // ... change the parameters
+/// auto presetB = layout.capture();
+///
+/// // in update()
+/// ofParameterLayout::lerp(presetA, presetB, crossfade, mixed);
+/// layout.restore(mixed);
+/// ~~~~
+///
+/// bool, int, float, double, vectors and colors are part of the layout,
+/// any other parameter, read only parameters and parameters that appear
+/// more than once in the tree are skipped. Each vector and color takes as
+/// many floats as it has components, ints take 2 floats and doubles 3 so
+/// they are restored without losing precision. Values are converted back
+/// to the parameter type when restoring, ints and integer colors are
+/// rounded and bools are true above 0.5, so interpolating them works as
+/// expected.
+///
+/// The layout doesn't follow changes to the group, call setup() again
+/// after adding or removing parameters.
+class ofParameterLayout{
+public:
+	ofParameterLayout(){}
+	ofParameterLayout(ofParameterGroup & group);
+
+	/// \brief Builds the layout for all the numeric parameters in group
+	/// and its subgroups.
+	void setup(ofParameterGroup & group);
+
+	/// \brief Number of parameters in the layout.
+	std::size_t size() const;
+
+	/// \brief Number of floats in a snapshot of this layout.
+	std::size_t getSnapshotSize() const;
+
+	/// \brief Path of the parameter at index, the names of its groups
+	/// and its own separated by '/'.
+	const std::string & getPath(std::size_t index) const;
+
+	/// \brief Position of the first float of the parameter at index in a
+	/// snapshot.
+	std::size_t getOffset(std::size_t index) const;
+
+	/// \brief Copies the current value of every parameter into snapshot,
+	/// which is resized if needed.
+	void capture(std::vector<float> & snapshot) const;
+	std::vector<float> capture() const;
+
+	/// \brief Sets every parameter to its value in snapshot.
+	///
+	/// All the values are set before any listener is called, so listeners
+	/// see the whole preset instead of a mix of the old and new one. With
+	/// notify each parameter whose value changed then notifies its
+	/// listeners and groups once, as in an ofParameterTransaction,
+	/// otherwise no events are triggered.
+	void restore(const std::vector<float> & snapshot, bool notify = true);
+
+	/// \brief Interpolates between two snapshots of the same layout into
+	/// dst, which is resized if needed.
+	static void lerp(const std::vector<float> & from, const std::vector<float> & to, float amount, std::vector<float> & dst);
+
+	/// \brief Writes snapshot to a binary preset file.
+	///
+	/// The file stores the layout next to the values so it can still be
+	/// loaded after parameters are added, removed or reordered.
+	bool save(const std::filesystem::path & path, const std::vector<float> & snapshot) const;
+
+	/// \brief Reads a binary preset file written by save().
+	///
+	/// Files written with the same layout are copied straight into
+	/// snapshot. Otherwise parameters are matched by path and type,
+	/// parameters missing in the file keep their value from the current
+	/// state of the group.
+	bool load(const std::filesystem::path & path, std::vector<float> & snapshot) const;
+
+	/// \brief Identifies the paths and types of the layout, snapshots can
+	/// be exchanged between layouts with the same hash.
+	uint64_t getHash() const;
+
+	/// \brief Version of the binary preset format written by save().
+	static const uint32_t FileVersion = 2;
+
+private:
+	enum Type: uint32_t{
+		Bool,
+		Int,
+		Float,
+		Double,
+		Vec2,
+		Vec3,
+		Vec4,
+		OfVec2,
+		OfVec3,
+		OfVec4,
+		Color,
+		ShortColor,
+		FloatColor,
+	};
+
+	struct Entry{
+		std::shared_ptr<ofAbstractParameter> parameter;
+		std::string path;
+		Type type;
+		std::size_t offset;
+		std::size_t numFloats;
+		void (*capture)(const ofAbstractParameter & parameter, float * dst);
+		bool (*restore)(ofAbstractParameter & parameter, const float * src);
+		void (*notify)(ofAbstractParameter & parameter);
+	};
+
+	void addGroup(ofParameterGroup & group, const std::string & prefix, std::unordered_set<const void*> & added);
+	template<typename T>
+	bool addParameter(ofAbstractParameter & parameter, const std::string & path, Type type, std::unordered_set<const void*> & added);
+
+	std::vector<Entry> entries;
+	std::size_t snapshotSize = 0;
+	uint64_t hash = 0;
+};
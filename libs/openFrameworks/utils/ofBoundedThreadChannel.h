@@ -0,0 +1,520 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// \brief What a bounded thread channel does with a value sent while it's
+/// full.
+enum ofThreadChannelOverflow{
+	/// \brief Waits until the receiver makes room for it.
+	OF_THREAD_CHANNEL_BLOCK,
+	/// \brief Drops the value being sent.
+	OF_THREAD_CHANNEL_DROP_NEWEST,
+	/// \brief Drops the oldest value in the channel to make room for it.
+	OF_THREAD_CHANNEL_DROP_OLDEST,
+};
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// ring buffer where every slot has a sequence number telling whether
+	// it's ready to be written or read in the current lap, so senders and
+	// receivers only synchronize through the slot they use. with a single
+	// producer positions are claimed without compare and swap. threads
+	// only take the mutex to sleep when the channel is empty or full
+	template<typename T, bool MultipleProducers>
+	class BoundedThreadChannel{
+	public:
+		BoundedThreadChannel(std::size_t capacity, ofThreadChannelOverflow overflow)
+		:overflow(overflow)
+		,closed(false){
+			std::size_t size = 2;
+			while(size < capacity){
+				size *= 2;
+			}
+			mask = size - 1;
+			slots.reset(new Slot[size]);
+			for(std::size_t i = 0; i < size; i++){
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+			enqueuePos.store(0, std::memory_order_relaxed);
+			dequeuePos.store(0, std::memory_order_relaxed);
+			numOverflows.store(0, std::memory_order_relaxed);
+			numWaiting.store(0, std::memory_order_relaxed);
+		}
+
+		BoundedThreadChannel(const BoundedThreadChannel &) = delete;
+		BoundedThreadChannel & operator=(const BoundedThreadChannel &) = delete;
+
+		bool receive(T & sentValue){
+			return receiveUntil(sentValue, nullptr);
+		}
+
+		bool tryReceive(T & sentValue){
+			if(closed){
+				return false;
+			}
+			return pop(sentValue);
+		}
+
+		bool tryReceive(T & sentValue, int64_t timeoutMs){
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+			return receiveUntil(sentValue, &deadline);
+		}
+
+		std::size_t receiveAll(std::vector<T> & values){
+			if(closed){
+				return 0;
+			}
+			std::size_t count = 0;
+			T value;
+			while(pop(value)){
+				values.push_back(std::move(value));
+				count++;
+			}
+			return count;
+		}
+
+		bool send(const T & value){
+			T copy = value;
+			return sendUntil(copy, overflow == OF_THREAD_CHANNEL_BLOCK, nullptr);
+		}
+
+		bool send(T && value){
+			return sendUntil(value, overflow == OF_THREAD_CHANNEL_BLOCK, nullptr);
+		}
+
+		bool trySend(const T & value){
+			T copy = value;
+			return sendUntil(copy, false, nullptr);
+		}
+
+		bool trySend(T && value){
+			return sendUntil(value, false, nullptr);
+		}
+
+		bool trySend(T && value, int64_t timeoutMs){
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+			return sendUntil(value, overflow == OF_THREAD_CHANNEL_BLOCK, &deadline);
+		}
+
+		void close(){
+			std::unique_lock<std::mutex> lock(mutex);
+			closed = true;
+			condition.notify_all();
+		}
+
+		bool empty() const{
+			return size() == 0;
+		}
+
+		std::size_t size() const{
+			auto dequeued = dequeuePos.load(std::memory_order_acquire);
+			auto enqueued = enqueuePos.load(std::memory_order_acquire);
+			return enqueued > dequeued ? std::min(enqueued - dequeued, capacity()) : 0;
+		}
+
+		std::size_t capacity() const{
+			return mask + 1;
+		}
+
+		uint64_t getNumOverflows() const{
+			return numOverflows.load(std::memory_order_relaxed);
+		}
+
+	private:
+		struct Slot{
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		typedef std::chrono::steady_clock::time_point TimePoint;
+
+		bool push(T & value){
+			Slot * slot;
+			auto pos = enqueuePos.load(std::memory_order_relaxed);
+			while(true){
+				slot = &slots[pos & mask];
+				auto sequence = slot->sequence.load(std::memory_order_acquire);
+				auto diff = intptr_t(sequence) - intptr_t(pos);
+				if(diff == 0){
+					if(!MultipleProducers){
+						enqueuePos.store(pos + 1, std::memory_order_relaxed);
+						break;
+					}
+					if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+						break;
+					}
+				}else if(diff < 0){
+					// the receiver hasn't freed this slot yet, full
+					return false;
+				}else{
+					pos = enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+			slot->value = std::move(value);
+			slot->sequence.store(pos + 1, std::memory_order_release);
+			wake();
+			return true;
+		}
+
+		// senders also pop to drop the oldest value, so positions are
+		// always claimed with compare and swap
+		bool pop(T & value){
+			Slot * slot;
+			auto pos = dequeuePos.load(std::memory_order_relaxed);
+			while(true){
+				slot = &slots[pos & mask];
+				auto sequence = slot->sequence.load(std::memory_order_acquire);
+				auto diff = intptr_t(sequence) - intptr_t(pos + 1);
+				if(diff == 0){
+					if(dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+						break;
+					}
+				}else if(diff < 0){
+					return false;
+				}else{
+					pos = dequeuePos.load(std::memory_order_relaxed);
+				}
+			}
+			value = std::move(slot->value);
+			slot->sequence.store(pos + mask + 1, std::memory_order_release);
+			wake();
+			return true;
+		}
+
+		bool canPush() const{
+			auto pos = enqueuePos.load(std::memory_order_relaxed);
+			return intptr_t(slots[pos & mask].sequence.load(std::memory_order_acquire)) - intptr_t(pos) >= 0;
+		}
+
+		bool canPop() const{
+			auto pos = dequeuePos.load(std::memory_order_relaxed);
+			return intptr_t(slots[pos & mask].sequence.load(std::memory_order_acquire)) - intptr_t(pos + 1) >= 0;
+		}
+
+		// senders wait for room and the receiver for values on the same
+		// condition, they are never waiting at the same time unless the
+		// channel is being closed
+		void wake(){
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(numWaiting.load(std::memory_order_relaxed) > 0){
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+				}
+				condition.notify_all();
+			}
+		}
+
+		template<typename Ready>
+		bool wait(Ready ready, const TimePoint * deadline){
+			std::unique_lock<std::mutex> lock(mutex);
+			numWaiting++;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bool timedOut = false;
+			if(!ready() && !closed){
+				if(deadline){
+					timedOut = condition.wait_until(lock, *deadline) == std::cv_status::timeout;
+				}else{
+					condition.wait(lock);
+				}
+			}
+			numWaiting--;
+			return !timedOut && !closed;
+		}
+
+		bool receiveUntil(T & sentValue, const TimePoint * deadline){
+			while(!closed){
+				if(pop(sentValue)){
+					return true;
+				}
+				if(!wait([this]{ return canPop(); }, deadline)){
+					return !closed && pop(sentValue);
+				}
+			}
+			return false;
+		}
+
+		bool sendUntil(T & value, bool block, const TimePoint * deadline){
+			bool overflowed = false;
+			while(!closed){
+				if(push(value)){
+					return true;
+				}
+				if(!overflowed){
+					overflowed = true;
+					numOverflows++;
+				}
+				if(overflow == OF_THREAD_CHANNEL_DROP_OLDEST){
+					T oldest;
+					pop(oldest);
+				}else if(!block || !wait([this]{ return canPush(); }, deadline)){
+					return !closed && push(value);
+				}
+			}
+			return false;
+		}
+
+		std::unique_ptr<Slot[]> slots;
+		std::size_t mask;
+		ofThreadChannelOverflow overflow;
+
+		// senders and receivers write different positions, keep them in
+		// different cache lines
+		char padding0[64];
+		std::atomic<std::size_t> enqueuePos;
+		char padding1[64];
+		std::atomic<std::size_t> dequeuePos;
+		char padding2[64];
+
+		std::atomic<uint64_t> numOverflows;
+		std::atomic<int> numWaiting;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::atomic<bool> closed;
+	};
+}
+}
+/*! \endcond */
+
+/// \brief A fixed size ofThreadChannel for one sending and one receiving
+/// thread.
+///
+/// ofThreadChannel grows without limit when the receiver can't keep up
+/// and every send and receive takes a lock. A bounded channel allocates
+/// all its slots upfront in a ring buffer that both ends access without
+/// locks: sending and receiving never wait for the other thread, they
+/// only sleep when the channel is empty or, with OF_THREAD_CHANNEL_BLOCK,
+/// full. What happens when a value is sent to a full channel is set by
+/// the overflow policy, and getNumOverflows() counts how many times it
+/// happened:
+///
+/// ~~~~{.cpp}
+/// // keeps the latest 64 frames if the main thread falls behind
+/// ofSpscThreadChannel<ofPixels> frames{64, OF_THREAD_CHANNEL_DROP_OLDEST};
+///
+/// // in the capture thread
+/// frames.send(std::move(pixels));
+///
+/// // in update()
+/// std::vector<ofPixels> newFrames;
+/// frames.receiveAll(newFrames);
+/// ~~~~
+///
+/// Only one thread can send and only one can receive. Use an
+/// ofMpscThreadChannel for several senders.
+///
+/// \tparam T The data type sent, has to be default constructible and
+/// movable.
+template<typename T>
+class ofSpscThreadChannel{
+public:
+	/// \brief Creates a channel for at least capacity values, rounded up to
+	/// the next power of 2.
+	ofSpscThreadChannel(std::size_t capacity, ofThreadChannelOverflow overflow = OF_THREAD_CHANNEL_BLOCK)
+	:channel(capacity, overflow){}
+
+	/// \brief Blocks until a new value is available.
+	///
+	/// \returns True if a new value was received or false if the channel was closed.
+	bool receive(T & sentValue){
+		return channel.receive(sentValue);
+	}
+
+	/// \brief Receives a new value if there's one available, without blocking.
+	///
+	/// \returns True if a new value was received, false if there was none
+	/// or the channel was closed.
+	bool tryReceive(T & sentValue){
+		return channel.tryReceive(sentValue);
+	}
+
+	/// \brief Waits at most timeoutMs milliseconds for a new value.
+	///
+	/// \returns True if a new value was received, false if there was none
+	/// or the channel was closed.
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		return channel.tryReceive(sentValue, timeoutMs);
+	}
+
+	/// \brief Appends all the available values to values, without blocking.
+	///
+	/// \returns The number of values received.
+	std::size_t receiveAll(std::vector<T> & values){
+		return channel.receiveAll(values);
+	}
+
+	/// \brief Sends a copy of value, blocking while the channel is full
+	/// with OF_THREAD_CHANNEL_BLOCK.
+	///
+	/// \returns False if the channel was closed or the value was dropped.
+	bool send(const T & value){
+		return channel.send(value);
+	}
+
+	/// \brief Sends value without copying it, blocking while the channel is
+	/// full with OF_THREAD_CHANNEL_BLOCK.
+	///
+	/// \returns False if the channel was closed or the value was dropped.
+	bool send(T && value){
+		return channel.send(std::move(value));
+	}
+
+	/// \brief Sends a copy of value without ever blocking.
+	///
+	/// \returns False if the channel was closed or the value was dropped,
+	/// with OF_THREAD_CHANNEL_BLOCK values sent to a full channel are
+	/// dropped.
+	bool trySend(const T & value){
+		return channel.trySend(value);
+	}
+
+	/// \brief Sends value without copying it or ever blocking.
+	///
+	/// \returns False if the channel was closed or the value was dropped,
+	/// with OF_THREAD_CHANNEL_BLOCK values sent to a full channel are
+	/// dropped.
+	bool trySend(T && value){
+		return channel.trySend(std::move(value));
+	}
+
+	/// \brief Sends value waiting at most timeoutMs milliseconds for room
+	/// with OF_THREAD_CHANNEL_BLOCK.
+	///
+	/// \returns False if the channel was closed or the value was dropped.
+	bool trySend(T && value, int64_t timeoutMs){
+		return channel.trySend(std::move(value), timeoutMs);
+	}
+
+	/// \brief Closes the channel.
+	///
+	/// Wakes up the threads waiting to send or receive, after that every
+	/// send and receive returns false.
+	void close(){
+		channel.close();
+	}
+
+	/// \brief Whether there are no values waiting, only an approximation
+	/// while other threads use the channel.
+	bool empty() const{
+		return channel.empty();
+	}
+
+	/// \brief Number of values waiting, only an approximation while other
+	/// threads use the channel.
+	std::size_t size() const{
+		return channel.size();
+	}
+
+	/// \brief Maximum number of values waiting in the channel.
+	std::size_t capacity() const{
+		return channel.capacity();
+	}
+
+	/// \brief Number of values sent while the channel was full, whether
+	/// they were dropped, dropped the oldest or had to wait.
+	uint64_t getNumOverflows() const{
+		return channel.getNumOverflows();
+	}
+
+private:
+	of::priv::BoundedThreadChannel<T, false> channel;
+};
+
+/// \brief A fixed size ofThreadChannel for several sending threads and one
+/// receiving thread.
+///
+/// Works like ofSpscThreadChannel, except that any number of threads can
+/// send at the same time. Senders claim slots with an atomic compare and
+/// swap, so a sender never waits for another one unless the channel is
+/// full.
+///
+/// \tparam T The data type sent, has to be default constructible and
+/// movable.
+template<typename T>
+class ofMpscThreadChannel{
+public:
+	/// \brief Creates a channel for at least capacity values, rounded up to
+	/// the next power of 2.
+	ofMpscThreadChannel(std::size_t capacity, ofThreadChannelOverflow overflow = OF_THREAD_CHANNEL_BLOCK)
+	:channel(capacity, overflow){}
+
+	/// \copydoc ofSpscThreadChannel::receive
+	bool receive(T & sentValue){
+		return channel.receive(sentValue);
+	}
+
+	/// \copydoc ofSpscThreadChannel::tryReceive(T&)
+	bool tryReceive(T & sentValue){
+		return channel.tryReceive(sentValue);
+	}
+
+	/// \copydoc ofSpscThreadChannel::tryReceive(T&,int64_t)
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		return channel.tryReceive(sentValue, timeoutMs);
+	}
+
+	/// \copydoc ofSpscThreadChannel::receiveAll
+	std::size_t receiveAll(std::vector<T> & values){
+		return channel.receiveAll(values);
+	}
+
+	/// \copydoc ofSpscThreadChannel::send(const T&)
+	bool send(const T & value){
+		return channel.send(value);
+	}
+
+	/// \copydoc ofSpscThreadChannel::send(T&&)
+	bool send(T && value){
+		return channel.send(std::move(value));
+	}
+
+	/// \copydoc ofSpscThreadChannel::trySend(const T&)
+	bool trySend(const T & value){
+		return channel.trySend(value);
+	}
+
+	/// \copydoc ofSpscThreadChannel::trySend(T&&)
+	bool trySend(T && value){
+		return channel.trySend(std::move(value));
+	}
+
+	/// \copydoc ofSpscThreadChannel::trySend(T&&,int64_t)
+	bool trySend(T && value, int64_t timeoutMs){
+		return channel.trySend(std::move(value), timeoutMs);
+	}
+
+	/// \copydoc ofSpscThreadChannel::close
+	void close(){
+		channel.close();
+	}
+
+	/// \copydoc ofSpscThreadChannel::empty
+	bool empty() const{
+		return channel.empty();
+	}
+
+	/// \copydoc ofSpscThreadChannel::size
+	std::size_t size() const{
+		return channel.size();
+	}
+
+	/// \copydoc ofSpscThreadChannel::capacity
+	std::size_t capacity() const{
+		return channel.capacity();
+	}
+
+	/// \copydoc ofSpscThreadChannel::getNumOverflows
+	uint64_t getNumOverflows() const{
+		return channel.getNumOverflows();
+	}
+
+private:
+	of::priv::BoundedThreadChannel<T, true> channel;
+};
@@ -2,7 +2,13 @@
 #ifndef TARGET_WIN32
 	#include <pwd.h>
 	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
 #endif
+#include <cerrno>
+#include <cstring>
+#include <limits>
 
 #include "ofUtils.h"
 #include "ofLog.h"
@@ -22,6 +28,21 @@ using namespace std;
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 
+// A file mapped in memory, unmapped when the last buffer using it goes away
+//--------------------------------------------------
+struct ofBuffer::Mapping{
+	~Mapping(){
+#ifdef TARGET_WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(data, size);
+#endif
+	}
+
+	char * data;
+	std::size_t size;
+};
+
 //--------------------------------------------------
 ofBuffer::ofBuffer()
 :currentLine(end(),end()){
@@ -45,7 +66,23 @@ bool ofBuffer::set(istream & stream, std::size_t ioBlockSize){
 		clear();
 		return false;
 	}else{
-		buffer.clear();
+		clear();
+	}
+
+	// streams that can seek, like files, know their size so they can be
+	// read at once instead of growing the buffer block by block
+	auto start = stream.tellg();
+	if(start != std::streampos(-1) && stream.seekg(0, ios::end)){
+		auto end = stream.tellg();
+		if(stream.seekg(start) && end > start){
+			buffer.resize(std::size_t(end - start));
+			stream.read(buffer.data(), buffer.size());
+			buffer.resize(std::size_t(stream.gcount()));
+		}
+	}
+	if(stream.fail() && !stream.eof() && !stream.bad()){
+		// seeking isn't supported, read the rest in blocks
+		stream.clear();
 	}
 
 	vector<char> aux_buffer(ioBlockSize);
@@ -58,7 +95,7 @@ bool ofBuffer::set(istream & stream, std::size_t ioBlockSize){
 
 //--------------------------------------------------
 void ofBuffer::setall(char mem){
-	buffer.assign(buffer.size(), mem);
+	std::fill(begin(), end(), mem);
 }
 
 //--------------------------------------------------
@@ -66,13 +103,16 @@ bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(buffer.data(), buffer.size());
+	stream.write(getData(), size());
 	return stream.good();
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * buffer, std::size_t size){
-	this->buffer.assign(buffer, buffer+size);
+	// the data can come from this buffer's mapping, copy it before unmapping
+	std::vector<char> data(buffer, buffer + size);
+	mapping.reset();
+	this->buffer.swap(data);
 }
 
 //--------------------------------------------------
@@ -87,16 +127,19 @@ void ofBuffer::append(const std::string& buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * buffer, std::size_t size){
+	copyMapping();
 	this->buffer.insert(this->buffer.end(), buffer, buffer + size);
 }
 
 //--------------------------------------------------
 void ofBuffer::reserve(std::size_t size){
+	copyMapping();
 	buffer.reserve(size);
 }
 
 //--------------------------------------------------
 void ofBuffer::clear(){
+	mapping.reset();
 	buffer.clear();
 }
 
@@ -107,18 +150,121 @@ void ofBuffer::allocate(std::size_t size){
 
 //--------------------------------------------------
 void ofBuffer::resize(std::size_t size){
+	copyMapping();
 	buffer.resize(size);
 }
 
+//--------------------------------------------------
+void ofBuffer::copyMapping(){
+	if(mapping){
+		buffer.assign(mapping->data, mapping->data + mapping->size);
+		mapping.reset();
+	}
+}
+
+//--------------------------------------------------
+bool ofBuffer::mapFile(const std::filesystem::path & path, ofBufferAccess access){
+	clear();
+	auto file = ofToDataPath(path, true);
+
+#if defined(TARGET_WIN32)
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if(access == OF_BUFFER_ACCESS_SEQUENTIAL){
+		flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	}else if(access == OF_BUFFER_ACCESS_RANDOM){
+		flags |= FILE_FLAG_RANDOM_ACCESS;
+	}
+	HANDLE handle = CreateFileW(std::filesystem::path(file).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+	if(handle == INVALID_HANDLE_VALUE){
+		ofLogError("ofBuffer") << "mapFile(): couldn't open \"" << file << "\"";
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(handle, &fileSize) || uint64_t(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max()){
+		CloseHandle(handle);
+		ofLogError("ofBuffer") << "mapFile(): couldn't get the size of \"" << file << "\"";
+		return false;
+	}
+	if(fileSize.QuadPart == 0){
+		// empty files can't be mapped, the buffer is empty already
+		CloseHandle(handle);
+		return true;
+	}
+	// read only, writing to the buffer copies it to memory first
+	HANDLE fileMapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(handle);
+	if(fileMapping == nullptr){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map \"" << file << "\"";
+		return false;
+	}
+	void * data = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(fileMapping);
+	if(data == nullptr){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map \"" << file << "\"";
+		return false;
+	}
+	std::size_t size = fileSize.QuadPart;
+#else
+	int fd = ::open(file.c_str(), O_RDONLY);
+	if(fd == -1){
+		ofLogError("ofBuffer") << "mapFile(): couldn't open \"" << file << "\": " << strerror(errno);
+		return false;
+	}
+	struct stat info;
+	if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || uint64_t(info.st_size) > std::numeric_limits<std::size_t>::max()){
+		::close(fd);
+		ofLogError("ofBuffer") << "mapFile(): \"" << file << "\" is not a file that can be mapped";
+		return false;
+	}
+	if(info.st_size == 0){
+		// empty files can't be mapped, the buffer is empty already
+		::close(fd);
+		return true;
+	}
+	std::size_t size = info.st_size;
+	// read only, writing to the buffer copies it to memory first
+	void * data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if(data == MAP_FAILED){
+		ofLogError("ofBuffer") << "mapFile(): couldn't map \"" << file << "\": " << strerror(errno);
+		return false;
+	}
+	if(access == OF_BUFFER_ACCESS_SEQUENTIAL){
+		madvise(data, size, MADV_SEQUENTIAL);
+	}else if(access == OF_BUFFER_ACCESS_RANDOM){
+		madvise(data, size, MADV_RANDOM);
+	}
+#endif
+
+	mapping = std::make_shared<Mapping>();
+	mapping->data = static_cast<char*>(data);
+	mapping->size = size;
+	currentLine = Line(getReadOnlyData() + size, getReadOnlyData() + size);
+	return true;
+}
+
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mapping != nullptr;
+}
+
 
 //--------------------------------------------------
 char * ofBuffer::getData(){
+	// the mapping is read only and might be shared with other buffers
+	copyMapping();
 	return buffer.data();
 }
 
+//--------------------------------------------------
+char * ofBuffer::getReadOnlyData() const{
+	// for the line iterators, which never write to the data
+	return const_cast<char*>(getData());
+}
+
 //--------------------------------------------------
 const char * ofBuffer::getData() const{
-	return buffer.data();
+	return mapping ? mapping->data : buffer.data();
 }
 
 //--------------------------------------------------
@@ -133,10 +279,10 @@ const char * ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	if(size() == 0){
 		return "";
 	}
-	return std::string(buffer.begin(), buffer.end());
+	return std::string(begin(), end());
 }
 
 //--------------------------------------------------
@@ -152,7 +298,7 @@ ofBuffer & ofBuffer::operator=(const std::string & text){
 
 //--------------------------------------------------
 std::size_t ofBuffer::size() const {
-	return buffer.size();
+	return mapping ? mapping->size : buffer.size();
 }
 
 //--------------------------------------------------
@@ -182,47 +328,47 @@ void ofBuffer::resetLineReader(){
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::begin(){
-	return buffer.begin();
+char * ofBuffer::begin(){
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::end(){
-	return buffer.end();
+char * ofBuffer::end(){
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::begin() const{
-	return buffer.begin();
+const char * ofBuffer::begin() const{
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::end() const{
-	return buffer.end();
+const char * ofBuffer::end() const{
+	return getData() + size();
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rbegin(){
-	return buffer.rbegin();
+std::reverse_iterator<char*> ofBuffer::rbegin(){
+	return std::reverse_iterator<char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rend(){
-	return buffer.rend();
+std::reverse_iterator<char*> ofBuffer::rend(){
+	return std::reverse_iterator<char*>(begin());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rbegin() const{
-	return buffer.rbegin();
+std::reverse_iterator<const char*> ofBuffer::rbegin() const{
+	return std::reverse_iterator<const char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rend() const{
-	return buffer.rend();
+std::reverse_iterator<const char*> ofBuffer::rend() const{
+	return std::reverse_iterator<const char*>(begin());
 }
 
 //--------------------------------------------------
-ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
+ofBuffer::Line::Line(char * _begin, char * _end)
 	:_current(_begin)
 	,_begin(_begin)
 	,_end(_end){
@@ -233,7 +379,7 @@ ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
 	}
 
 	_current = std::find(_begin, _end, '\n');
-	if(_current - 1 >= _begin && *(_current - 1) == '\r'){
+	if(_current > _begin && *(_current - 1) == '\r'){
 		line = string(_begin, _current - 1);
 	}else{
 		line = string(_begin, _current);
@@ -288,7 +434,7 @@ bool ofBuffer::Line::empty() const{
 
 
 //--------------------------------------------------
-ofBuffer::RLine::RLine(vector<char>::reverse_iterator _rbegin, vector<char>::reverse_iterator _rend)
+ofBuffer::RLine::RLine(std::reverse_iterator<char*> _rbegin, std::reverse_iterator<char*> _rend)
 	:_current(_rbegin)
 	,_rbegin(_rbegin)
 	,_rend(_rend){
@@ -347,7 +493,7 @@ bool ofBuffer::RLine::empty() const{
 }
 
 //--------------------------------------------------
-ofBuffer::Lines::Lines(vector<char>::iterator begin, vector<char>::iterator end)
+ofBuffer::Lines::Lines(char * begin, char * end)
 :_begin(begin)
 ,_end(end){}
 
@@ -363,7 +509,7 @@ ofBuffer::Line ofBuffer::Lines::end(){
 
 
 //--------------------------------------------------
-ofBuffer::RLines::RLines(vector<char>::reverse_iterator rbegin, vector<char>::reverse_iterator rend)
+ofBuffer::RLines::RLines(std::reverse_iterator<char*> rbegin, std::reverse_iterator<char*> rend)
 :_rbegin(rbegin)
 ,_rend(rend){}
 
@@ -379,12 +525,12 @@ ofBuffer::RLine ofBuffer::RLines::end(){
 
 //--------------------------------------------------
 ofBuffer::Lines ofBuffer::getLines(){
-	return ofBuffer::Lines(begin(), end());
+	return ofBuffer::Lines(getReadOnlyData(), getReadOnlyData() + size());
 }
 
 //--------------------------------------------------
 ofBuffer::RLines ofBuffer::getReverseLines(){
-	return ofBuffer::RLines(rbegin(), rend());
+	return ofBuffer::RLines(std::reverse_iterator<char*>(getReadOnlyData() + size()), std::reverse_iterator<char*>(getReadOnlyData()));
 }
 
 //--------------------------------------------------
@@ -405,6 +551,13 @@ ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary){
 	return ofBuffer(f);
 }
 
+//--------------------------------------------------
+ofBuffer ofBufferFromMappedFile(const std::filesystem::path & path, ofBufferAccess access){
+	ofBuffer buffer;
+	buffer.mapFile(path, access);
+	return buffer;
+}
+
 //--------------------------------------------------
 bool ofBufferToFile(const std::filesystem::path & path, const ofBuffer& buffer, bool binary){
 	ofFile f(path, ofFile::WriteOnly, binary);
@@ -2,6 +2,8 @@
 
 #include "ofConstants.h"
 #include <fstream>
+#include <iterator>
+#include <memory>
 
 #if OF_USING_STD_FS
 #	if __cplusplus < 201703L
@@ -27,6 +29,14 @@
 // ofBuffer
 //----------------------------------------------------------
 
+/// \brief How the contents of a memory mapped ofBuffer are going to be
+/// read, lets the system read ahead or not
+enum ofBufferAccess{
+	OF_BUFFER_ACCESS_DEFAULT,
+	OF_BUFFER_ACCESS_SEQUENTIAL,
+	OF_BUFFER_ACCESS_RANDOM,
+};
+
 /// \class ofBuffer
 ///
 /// A buffer of data which can be accessed as simple bytes or text.
@@ -46,8 +56,10 @@ public:
 	
 	/// Create a buffer and set its contents from an input stream.
 	///
+	/// Streams that know their size, like files, are read at once.
+	///
 	/// \param ioBlockSize the number of bytes to read from the stream in chunks
-	ofBuffer(std::istream & stream, std::size_t ioBlockSize = 1024);
+	ofBuffer(std::istream & stream, std::size_t ioBlockSize = 64 * 1024);
 
 	/// Set the contents of the buffer from a raw byte pointer.
 	///
@@ -66,7 +78,26 @@ public:
 	///
 	/// \param stream input stream to copy data from
 	/// \param ioBlockSize the number of bytes to read from the stream in chunks
-	bool set(std::istream & stream, std::size_t ioBlockSize = 1024);
+	bool set(std::istream & stream, std::size_t ioBlockSize = 64 * 1024);
+
+	/// Set the contents of the buffer by mapping a file in memory instead
+	/// of reading it.
+	///
+	/// The file is only read as its data is accessed, so opening big files
+	/// doesn't take time or memory up front. The mapping is read only and
+	/// shared by the copies of the buffer. The const getData(), begin() and
+	/// end(), getText() and the lines iterators read it directly, while the
+	/// non const getData(), begin() and end() and any function that
+	/// modifies the buffer copy its contents to memory first. Read mapped
+	/// buffers through a const reference to keep them mapped.
+	///
+	/// \param path file to map, relative to the data folder
+	/// \param access how the data is going to be read
+	/// \returns false if the file couldn't be mapped, leaving the buffer empty
+	bool mapFile(const std::filesystem::path & path, ofBufferAccess access = OF_BUFFER_ACCESS_DEFAULT);
+
+	/// \returns whether the contents of the buffer are a memory mapped file
+	bool isMapped() const;
 	
 	/// Set all bytes in the buffer to a given value.
 	///
@@ -115,6 +146,8 @@ public:
 
 	/// Access the buffer's contents using a raw byte pointer.
 	///
+	/// A mapped buffer is copied to memory first, see mapFile().
+	///
 	/// \warning Do not access bytes at indices beyond size()!
 	/// \returns pointer to internal raw bytes
 	char * getData();
@@ -153,19 +186,22 @@ public:
 	friend std::ostream & operator<<(std::ostream & ostr, const ofBuffer & buf);
 	friend std::istream & operator>>(std::istream & istr, ofBuffer & buf);
 
-	std::vector<char>::iterator begin();
-	std::vector<char>::iterator end();
-	std::vector<char>::const_iterator begin() const;
-	std::vector<char>::const_iterator end() const;
-	std::vector<char>::reverse_iterator rbegin();
-	std::vector<char>::reverse_iterator rend();
-	std::vector<char>::const_reverse_iterator rbegin() const;
-	std::vector<char>::const_reverse_iterator rend() const;
+	/// \note These used to return std::vector<char> iterators, code that
+	/// names that type needs to use char pointers or auto instead. The non
+	/// const versions copy a mapped buffer to memory, see mapFile().
+	char * begin();
+	char * end();
+	const char * begin() const;
+	const char * end() const;
+	std::reverse_iterator<char*> rbegin();
+	std::reverse_iterator<char*> rend();
+	std::reverse_iterator<const char*> rbegin() const;
+	std::reverse_iterator<const char*> rend() const;
 
 	/// A line of text in the buffer.
 	///
 	struct Line: public std::iterator<std::forward_iterator_tag,Line>{
-		Line(std::vector<char>::iterator _begin, std::vector<char>::iterator _end);
+		Line(char * _begin, char * _end);
 		const std::string & operator*() const;
 		const std::string * operator->() const;
 		const std::string & asString() const;
@@ -184,13 +220,13 @@ public:
 
 	private:
 		std::string line;
-		std::vector<char>::iterator _current, _begin, _end;
+		char * _current, * _begin, * _end;
 	};
 
 	/// A line of text in the buffer.
 	///
 	struct RLine: public std::iterator<std::forward_iterator_tag,Line>{
-		RLine(std::vector<char>::reverse_iterator _begin, std::vector<char>::reverse_iterator _end);
+		RLine(std::reverse_iterator<char*> _begin, std::reverse_iterator<char*> _end);
 		const std::string & operator*() const;
 		const std::string * operator->() const;
 		const std::string & asString() const;
@@ -209,13 +245,13 @@ public:
 
 	private:
 		std::string line;
-		std::vector<char>::reverse_iterator _current, _rbegin, _rend;
+		std::reverse_iterator<char*> _current, _rbegin, _rend;
 	};
 
 	/// A series of text lines in the buffer.
 	///
 	struct Lines{
-		Lines(std::vector<char>::iterator begin, std::vector<char>::iterator end);
+		Lines(char * begin, char * end);
 		
 		/// Get the first line in the buffer.
 		Line begin();
@@ -227,14 +263,14 @@ public:
 		RLine rend();
 
 	private:
-		std::vector<char>::iterator _begin, _end;
+		char * _begin, * _end;
 	};
 
 
 	/// A series of text lines in the buffer.
 	///
 	struct RLines{
-		RLines(std::vector<char>::reverse_iterator rbegin, std::vector<char>::reverse_iterator rend);
+		RLines(std::reverse_iterator<char*> rbegin, std::reverse_iterator<char*> rend);
 
 		/// Get the first line in the buffer.
 		RLine begin();
@@ -243,7 +279,7 @@ public:
 		RLine end();
 
 	private:
-		std::vector<char>::reverse_iterator _rbegin, _rend;
+		std::reverse_iterator<char*> _rbegin, _rend;
 	};
 
 	/// Access the contents of the buffer as a series of text lines.
@@ -264,7 +300,12 @@ public:
 	RLines getReverseLines();
 
 private:
+	struct Mapping;
+	void copyMapping();
+	char * getReadOnlyData() const;
+
 	std::vector<char> 	buffer;
+	std::shared_ptr<Mapping> mapping; //< set when the contents are a mapped file
 	Line			currentLine;
 };
 
@@ -278,6 +319,15 @@ private:
 /// split at endline characters automatically
 ofBuffer ofBufferFromFile(const std::filesystem::path & path, bool binary=true);
 
+//--------------------------------------------------
+/// Map a file in memory in a buffer instead of reading it.
+///
+/// Useful for big files that are only read, see ofBuffer::mapFile.
+///
+/// \param path file to map
+/// \param access how the data is going to be read
+ofBuffer ofBufferFromMappedFile(const std::filesystem::path & path, ofBufferAccess access = OF_BUFFER_ACCESS_DEFAULT);
+
 //--------------------------------------------------
 /// Write the contents of a buffer to a file at path.
 ///
@@ -12,10 +12,11 @@ using ofJson = nlohmann::json;
 /// \returns loaded json, or an empty json object on failure.
 inline ofJson ofLoadJson(const std::filesystem::path& filename){
 	ofJson json;
-	ofFile jsonFile(filename);
-	if(jsonFile.exists()){
+	if(ofFile::doesFileExist(filename)){
 		try{
-			jsonFile >> json;
+			// parsed straight from the mapped file without copying it
+			const auto buffer = ofBufferFromMappedFile(filename, OF_BUFFER_ACCESS_SEQUENTIAL);
+			json = ofJson::parse(buffer.begin(), buffer.end());
 		}catch(std::exception & e){
 			ofLogError("ofLoadJson") << "Error loading json from " << filename.string() << ": " << e.what();
 		}catch(...){
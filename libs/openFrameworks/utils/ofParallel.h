@@ -0,0 +1,208 @@
+#pragma once
+
+#include "ofTaskPool.h"
+#include <algorithm>
+#include <vector>
+
+template<typename PixelType>
+class ofPixels_;
+
+template<class V, class N, class C, class T>
+class ofMesh_;
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// number of elements per chunk when the caller doesn't choose one. it
+	// only depends on the size of the range so reductions give the same
+	// result on every machine
+	inline std::size_t getParallelGrain(std::size_t size, std::size_t grain){
+		if(grain > 0){
+			return grain;
+		}
+		return std::max<std::size_t>(1, size / 256);
+	}
+
+	// runs f(chunk) for every chunk in [0, numChunks). the calling thread
+	// and up to one helper per worker take the next chunk as soon as they
+	// finish the previous one, so chunks of uneven cost balance out
+	template<typename F>
+	void parallelForChunks(std::size_t numChunks, F & f){
+		auto & pool = ofGetTaskPool();
+		auto numHelpers = std::min(numChunks > 0 ? numChunks - 1 : 0, pool.getNumThreads());
+		if(numHelpers == 0){
+			for(std::size_t i = 0; i < numChunks; i++){
+				f(i);
+			}
+			return;
+		}
+		std::atomic<std::size_t> next{0};
+		auto work = [&]{
+			std::size_t i;
+			while((i = next++) < numChunks){
+				f(i);
+			}
+		};
+		ofTaskGroup group(pool);
+		for(std::size_t i = 0; i < numHelpers; i++){
+			group.run(work);
+		}
+		work();
+		group.wait();
+	}
+}
+}
+/*! \endcond */
+
+/// \brief Calls f(first, last) for consecutive ranges of at most grain
+/// indices that together cover [begin, end), in parallel.
+///
+/// Useful when every range needs some setup, like a buffer reused for all
+/// its elements. A grain of 0 picks one from the size of the range. The
+/// ranges run in the workers of ofGetTaskPool() and the calling thread,
+/// which returns once all of them have finished.
+template<typename F>
+void ofParallelForRange(std::size_t begin, std::size_t end, std::size_t grain, F f){
+	if(end <= begin){
+		return;
+	}
+	grain = of::priv::getParallelGrain(end - begin, grain);
+	auto numChunks = (end - begin + grain - 1) / grain;
+	auto chunk = [&](std::size_t i){
+		auto first = begin + i * grain;
+		f(first, std::min(first + grain, end));
+	};
+	of::priv::parallelForChunks(numChunks, chunk);
+}
+
+/// \brief Calls f(i) for every index in [begin, end), in parallel.
+///
+/// The indices are split in ranges of grain indices, each range runs in
+/// one thread. Bigger grains lower the overhead, smaller ones balance the
+/// work better when the cost of every index varies. A grain of 0 picks
+/// one from the size of the range.
+///
+/// ~~~~{.cpp}
+/// ofParallelFor(0, particles.size(), 64, [&](size_t i){
+///     particles[i].update(dt);
+/// });
+/// ~~~~
+///
+/// f is called from several threads at the same time, it can only write
+/// to data that belongs to its index.
+template<typename F>
+void ofParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F f){
+	ofParallelForRange(begin, end, grain, [&f](std::size_t first, std::size_t last){
+		for(auto i = first; i < last; i++){
+			f(i);
+		}
+	});
+}
+
+/// \brief Calls f(i) for every index in [begin, end), in parallel,
+/// choosing the grain from the size of the range.
+template<typename F>
+void ofParallelFor(std::size_t begin, std::size_t end, F f){
+	ofParallelFor(begin, end, 0, f);
+}
+
+/// \brief Combines map(i) for every index in [begin, end) with reduce,
+/// in parallel.
+///
+/// Every range of grain indices is reduced in order starting from
+/// identity, and the results of the ranges are then reduced in order in
+/// the calling thread. Since the ranges only depend on the size of the
+/// range and the grain, the result is the same on every run and with any
+/// number of threads, even when reduce isn't associative like floating
+/// point additions:
+///
+/// ~~~~{.cpp}
+/// float total = ofParallelReduce(0, samples.size(), 0, 0.f,
+///     [&](size_t i){ return samples[i] * samples[i]; },
+///     [](float a, float b){ return a + b; });
+/// ~~~~
+template<typename T, typename Map, typename Reduce>
+T ofParallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map map, Reduce reduce){
+	if(end <= begin){
+		return identity;
+	}
+	grain = of::priv::getParallelGrain(end - begin, grain);
+	auto numChunks = (end - begin + grain - 1) / grain;
+
+	// wrapped so vector<bool> doesn't pack results written from different
+	// threads in the same word
+	struct Partial{
+		T value;
+	};
+	std::vector<Partial> partials(numChunks, Partial{identity});
+	auto chunk = [&](std::size_t i){
+		auto first = begin + i * grain;
+		auto last = std::min(first + grain, end);
+		T value = identity;
+		for(auto j = first; j < last; j++){
+			value = reduce(value, map(j));
+		}
+		partials[i].value = std::move(value);
+	};
+	of::priv::parallelForChunks(numChunks, chunk);
+
+	T result = identity;
+	for(auto & partial: partials){
+		result = reduce(result, partial.value);
+	}
+	return result;
+}
+
+/// \brief Calls f(line) for every line of pixels, in parallel.
+///
+/// ~~~~{.cpp}
+/// ofParallelForRows(pixels, [](ofPixels::Line line){
+///     for(auto & c: line){
+///         c = 255 - c;
+///     }
+/// });
+/// ~~~~
+template<typename PixelType, typename F>
+void ofParallelForRows(ofPixels_<PixelType> & pixels, F f){
+	ofParallelFor(0, pixels.getHeight(), [&](std::size_t y){
+		f(pixels.getLine(y));
+	});
+}
+
+/// \brief Calls f(line) for every line of pixels, in parallel, with read
+/// only lines.
+template<typename PixelType, typename F>
+void ofParallelForRows(const ofPixels_<PixelType> & pixels, F f){
+	ofParallelFor(0, pixels.getHeight(), [&](std::size_t y){
+		f(pixels.getConstLine(y));
+	});
+}
+
+/// \brief Calls f(vertex, index) for every vertex of mesh, in parallel.
+///
+/// The index can be used to access the normal, color or texture
+/// coordinate of the vertex:
+///
+/// ~~~~{.cpp}
+/// auto & normals = mesh.getNormals();
+/// ofParallelForVertices(mesh, [&](glm::vec3 & v, size_t i){
+///     v += normals[i] * ofSignedNoise(v * 0.01f, t);
+/// });
+/// ~~~~
+template<class V, class N, class C, class T, typename F>
+void ofParallelForVertices(ofMesh_<V, N, C, T> & mesh, F f){
+	auto & vertices = mesh.getVertices();
+	ofParallelFor(0, vertices.size(), [&](std::size_t i){
+		f(vertices[i], i);
+	});
+}
+
+/// \brief Calls f(vertex, index) for every vertex of mesh, in parallel,
+/// with read only vertices.
+template<class V, class N, class C, class T, typename F>
+void ofParallelForVertices(const ofMesh_<V, N, C, T> & mesh, F f){
+	auto & vertices = mesh.getVertices();
+	ofParallelFor(0, vertices.size(), [&](std::size_t i){
+		f(vertices[i], i);
+	});
+}
@@ -0,0 +1,380 @@
+#include "ofTaskPool.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+
+#ifdef TARGET_ANDROID
+#include <jni.h>
+#include "ofxAndroidUtils.h"
+#endif
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID) || defined(TARGET_OSX) || defined(TARGET_OF_IOS)
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+namespace{
+	struct CurrentWorker{
+		const ofTaskPool * pool;
+		size_t index;
+	};
+
+#if !defined(TARGET_EMSCRIPTEN) && HAS_TLS
+	thread_local CurrentWorker currentWorker{nullptr, 0};
+#endif
+
+	void runTask(std::function<void()> & task){
+		try{
+			task();
+		}catch(const std::exception& exc){
+			ofLogFatalError("ofTaskPool") << "exception in task: " << exc.what();
+		}catch(...){
+			ofLogFatalError("ofTaskPool") << "unknown exception in task";
+		}
+	}
+
+	void setThreadName(const std::string & name){
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+		// linux limits names to 15 characters
+		pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(TARGET_OSX) || defined(TARGET_OF_IOS)
+		pthread_setname_np(name.c_str());
+#endif
+	}
+
+	void pinThread(size_t core){
+#if defined(TARGET_LINUX)
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(core, &cpus);
+		if(pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0){
+			ofLogWarning("ofTaskPool") << "couldn't pin worker to core " << core;
+		}
+#endif
+	}
+}
+
+//-------------------------------------------------
+of::priv::BaseTaskState::BaseTaskState(ofTaskPool & pool)
+:pool(pool)
+,done(false){
+}
+
+//-------------------------------------------------
+void of::priv::BaseTaskState::finish(){
+	std::vector<std::function<void()>> next;
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		done = true;
+		std::swap(next, continuations);
+	}
+	condition.notify_all();
+	for(auto & continuation: next){
+		pool.post(std::move(continuation));
+	}
+}
+
+//-------------------------------------------------
+void of::priv::BaseTaskState::addContinuation(std::function<void()> && continuation){
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		if(!done){
+			continuations.push_back(std::move(continuation));
+			return;
+		}
+	}
+	pool.post(std::move(continuation));
+}
+
+//-------------------------------------------------
+bool of::priv::BaseTaskState::isDone() const{
+	return done;
+}
+
+//-------------------------------------------------
+void of::priv::BaseTaskState::wait(){
+	while(!done){
+		// help with the pending tasks, the one we wait for might be one
+		// of them, and sleep only when there's nothing to do
+		if(!pool.runPendingTask()){
+			std::unique_lock<std::mutex> lck(mutex);
+			condition.wait_for(lck, std::chrono::milliseconds(1), [this]{ return done.load(); });
+		}
+	}
+}
+
+//-------------------------------------------------
+ofTaskPool::ofTaskPool(){
+	setup(Settings());
+}
+
+//-------------------------------------------------
+ofTaskPool::ofTaskPool(const Settings & settings){
+	setup(settings);
+}
+
+//-------------------------------------------------
+void ofTaskPool::setup(const Settings & settings){
+	numPending = 0;
+	numSleeping = 0;
+	stopping = false;
+#ifndef TARGET_NO_THREADS
+	auto numThreads = settings.numThreads;
+	if(numThreads == 0){
+		numThreads = std::max<size_t>(getMaxThreads() - 1, 1);
+	}else if(numThreads > getMaxThreads()){
+		ofLogWarning("ofTaskPool") << "requested " << numThreads << " threads but there are only " << getMaxThreads() << " cores, using " << getMaxThreads();
+		numThreads = getMaxThreads();
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers.push_back(std::make_unique<Worker>());
+	}
+	// start the threads once all the workers exist so they can steal
+	// from each other
+	for(size_t i = 0; i < numThreads; i++){
+		workers[i]->thread = std::thread(&ofTaskPool::run, this, i, settings);
+	}
+#endif
+}
+
+//-------------------------------------------------
+ofTaskPool::~ofTaskPool(){
+	{
+		std::unique_lock<std::mutex> lck(sleepMutex);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+	for(auto & worker: workers){
+		worker->thread.join();
+	}
+}
+
+//-------------------------------------------------
+void ofTaskPool::run(size_t index, const Settings & settings){
+#if !defined(TARGET_EMSCRIPTEN) && HAS_TLS
+	currentWorker = {this, index};
+#endif
+#ifdef TARGET_ANDROID
+	JNIEnv * env;
+	jint attachResult = ofGetJavaVMPtr()->AttachCurrentThread(&env,nullptr);
+	if(attachResult!=0){
+		ofLogWarning("ofTaskPool") << "couldn't attach worker to java vm";
+	}
+#endif
+	setThreadName(settings.name + " " + ofToString(index));
+	if(settings.pinThreads){
+		pinThread(index % getMaxThreads());
+	}
+
+	std::function<void()> task;
+	bool idle = false;
+	std::chrono::steady_clock::time_point idleStart;
+	while(true){
+		if(popTask(index, task)){
+			runTask(task);
+			task = nullptr;
+			idle = false;
+			continue;
+		}
+		if(settings.spinTime.count() > 0){
+			auto now = std::chrono::steady_clock::now();
+			if(!idle){
+				idle = true;
+				idleStart = now;
+			}
+			if(now - idleStart < settings.spinTime){
+				std::this_thread::yield();
+				continue;
+			}
+		}
+		std::unique_lock<std::mutex> lck(sleepMutex);
+		// announced before checking for tasks so post() either sees a
+		// sleeping worker or this sees its task
+		numSleeping++;
+		if(numPending == 0){
+			if(stopping){
+				numSleeping--;
+				break;
+			}
+			wakeUp.wait(lck);
+		}
+		numSleeping--;
+		idle = false;
+	}
+
+#ifdef TARGET_ANDROID
+	ofGetJavaVMPtr()->DetachCurrentThread();
+#endif
+}
+
+//-------------------------------------------------
+void ofTaskPool::post(std::function<void()> f){
+	if(workers.empty()){
+		runTask(f);
+		return;
+	}
+	// counted before it's queued so workers never see fewer pending tasks
+	// than there are in the queues
+	numPending++;
+	auto index = getWorkerIndex();
+	if(index < workers.size()){
+		auto & worker = *workers[index];
+		std::unique_lock<std::mutex> lck(worker.mutex);
+		worker.tasks.push_back(std::move(f));
+	}else{
+		std::unique_lock<std::mutex> lck(sharedMutex);
+		sharedTasks.push_back(std::move(f));
+	}
+	if(numSleeping > 0){
+		{
+			// makes sure a worker about to sleep sees the new task
+			std::unique_lock<std::mutex> lck(sleepMutex);
+		}
+		wakeUp.notify_one();
+	}
+}
+
+//-------------------------------------------------
+bool ofTaskPool::popTask(size_t index, std::function<void()> & task){
+	if(numPending == 0){
+		return false;
+	}
+
+	// newest task from our own queue, it's probably still in cache
+	if(index < workers.size()){
+		auto & worker = *workers[index];
+		std::unique_lock<std::mutex> lck(worker.mutex);
+		if(!worker.tasks.empty()){
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			numPending--;
+			return true;
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lck(sharedMutex);
+		if(!sharedTasks.empty()){
+			task = std::move(sharedTasks.front());
+			sharedTasks.pop_front();
+			numPending--;
+			return true;
+		}
+	}
+
+	// oldest task of another worker, it's usually the biggest one left
+	for(size_t i = 1; i <= workers.size(); i++){
+		auto & victim = *workers[(index + i) % workers.size()];
+		std::unique_lock<std::mutex> lck(victim.mutex);
+		if(!victim.tasks.empty()){
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			numPending--;
+			return true;
+		}
+	}
+	return false;
+}
+
+//-------------------------------------------------
+bool ofTaskPool::runPendingTask(){
+	std::function<void()> task;
+	if(popTask(getWorkerIndex(), task)){
+		runTask(task);
+		return true;
+	}
+	return false;
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getWorkerIndex() const{
+#if !defined(TARGET_EMSCRIPTEN) && HAS_TLS
+	if(currentWorker.pool == this){
+		return currentWorker.index;
+	}
+#else
+	auto id = std::this_thread::get_id();
+	for(size_t i = 0; i < workers.size(); i++){
+		if(workers[i]->thread.get_id() == id){
+			return i;
+		}
+	}
+#endif
+	return workers.size();
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getNumThreads() const{
+	return workers.size();
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getNumPendingTasks() const{
+	return numPending;
+}
+
+//-------------------------------------------------
+bool ofTaskPool::isWorkerThread() const{
+	return getWorkerIndex() < workers.size();
+}
+
+//-------------------------------------------------
+size_t ofTaskPool::getMaxThreads(){
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//-------------------------------------------------
+ofTaskGroup::ofTaskGroup()
+:ofTaskGroup(ofGetTaskPool()){
+}
+
+//-------------------------------------------------
+ofTaskGroup::ofTaskGroup(ofTaskPool & pool)
+:pool(pool)
+,state(std::make_shared<State>()){
+}
+
+//-------------------------------------------------
+ofTaskGroup::~ofTaskGroup(){
+	wait();
+}
+
+//-------------------------------------------------
+void ofTaskGroup::run(std::function<void()> f){
+	state->numRunning++;
+	auto state = this->state;
+	pool.post([f, state]() mutable{
+		runTask(f);
+		if(--state->numRunning == 0){
+			std::unique_lock<std::mutex> lck(state->mutex);
+			state->condition.notify_all();
+		}
+	});
+}
+
+//-------------------------------------------------
+void ofTaskGroup::wait(){
+	while(state->numRunning > 0){
+		if(!pool.runPendingTask()){
+			std::unique_lock<std::mutex> lck(state->mutex);
+			state->condition.wait_for(lck, std::chrono::milliseconds(1), [this]{ return state->numRunning == 0; });
+		}
+	}
+}
+
+//-------------------------------------------------
+bool ofTaskGroup::isDone() const{
+	return state->numRunning == 0;
+}
+
+//-------------------------------------------------
+ofTaskPool & ofGetTaskPool(){
+	static ofTaskPool * pool = []{
+		// parallel loops run in short bursts every frame, spinning a bit
+		// saves waking up the workers for every one of them
+		ofTaskPool::Settings settings;
+		settings.spinTime = std::chrono::milliseconds(1);
+		return new ofTaskPool(settings);
+	}();
+	return *pool;
+}
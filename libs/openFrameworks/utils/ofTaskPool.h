@@ -0,0 +1,332 @@
+#pragma once
+
+#include "ofConstants.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <thread>
+
+class ofTaskPool;
+
+/*! \cond PRIVATE */
+namespace of{
+namespace priv{
+	// completion and continuations of a task, shared by all the ofTask
+	// handles to it
+	class BaseTaskState{
+	public:
+		BaseTaskState(ofTaskPool & pool);
+		void finish();
+		void addContinuation(std::function<void()> && continuation);
+		bool isDone() const;
+		void wait();
+
+		ofTaskPool & pool;
+
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::atomic<bool> done;
+		std::vector<std::function<void()>> continuations;
+	};
+
+	template<typename T>
+	class TaskState: public BaseTaskState{
+	public:
+		TaskState(ofTaskPool & pool, std::shared_future<T> && future)
+		:BaseTaskState(pool)
+		,future(std::move(future)){}
+
+		std::shared_future<T> future;
+	};
+
+	// calls a continuation with the result of the task it follows
+	template<typename T>
+	struct TaskResult{
+		template<typename F>
+		static auto call(F & f, const std::shared_future<T> & future) -> decltype(f(future.get())){
+			return f(future.get());
+		}
+	};
+
+	template<>
+	struct TaskResult<void>{
+		template<typename F>
+		static auto call(F & f, const std::shared_future<void> & future) -> decltype(f()){
+			future.get();
+			return f();
+		}
+	};
+}
+}
+/*! \endcond */
+
+/// \brief Handle to the result of a function running in an ofTaskPool.
+///
+/// Returned by ofTaskPool::submit(). Copies of a task refer to the same
+/// result. Waiting for a task runs other pending tasks of the pool in the
+/// meantime, so tasks can wait for other tasks without blocking workers.
+/// Exceptions thrown by the function are rethrown by get().
+template<typename T>
+class ofTask{
+public:
+	ofTask(){}
+
+	/// \brief Whether the task refers to a submitted function.
+	bool isValid() const;
+
+	/// \brief Whether the function has finished, never blocks.
+	bool isReady() const;
+
+	/// \brief Waits for the function to finish.
+	void wait() const;
+
+	/// \brief Waits for the function to finish and returns its result.
+	///
+	/// Like std::future::get(), throws std::future_error with
+	/// std::future_errc::no_state if the task isn't valid.
+	auto get() const -> decltype(std::declval<std::shared_future<T>>().get());
+
+	/// \brief Submits f to run in the pool once this task has finished.
+	///
+	/// f receives the result of this task, or no arguments if it returns
+	/// void, and the returned task holds the result of f:
+	///
+	/// ~~~~{.cpp}
+	/// auto pixels = ofGetTaskPool().submit([path]{
+	///     ofPixels pixels;
+	///     ofLoadImage(pixels, path);
+	///     return pixels;
+	/// });
+	/// auto resized = pixels.then([](const ofPixels & pixels){
+	///     auto copy = pixels;
+	///     copy.resize(256, 256);
+	///     return copy;
+	/// });
+	/// ~~~~
+	///
+	/// On a task that isn't valid f never runs and the returned task isn't
+	/// valid either.
+	template<typename F>
+	auto then(F f) const -> ofTask<decltype(of::priv::TaskResult<T>::call(f, std::declval<const std::shared_future<T>&>()))>;
+
+private:
+	ofTask(std::shared_ptr<of::priv::TaskState<T>> state)
+	:state(state){}
+
+	std::shared_ptr<of::priv::TaskState<T>> state;
+
+	friend class ofTaskPool;
+
+	template<typename U>
+	friend class ofTask;
+};
+
+/// \brief Runs functions in a fixed set of worker threads.
+///
+/// Creating an ofThread for every background job starts a new OS thread
+/// each time and, with many of them, more threads than cores compete for
+/// the CPU. An ofTaskPool starts its workers once and runs small
+/// functions, tasks, on them. Each worker keeps its own queue: tasks
+/// submitted from a worker go to its queue and run in the reverse order
+/// they were submitted, while tasks submitted from any other thread go
+/// to a shared queue. Workers that run out of tasks take the oldest ones
+/// from the other workers' queues, so work spreads over all the workers
+/// without a single queue every thread has to lock.
+///
+/// Most code should use the pool shared by the whole application,
+/// ofGetTaskPool(), instead of creating new ones.
+///
+/// ~~~~{.cpp}
+/// auto task = ofGetTaskPool().submit([]{
+///     return computeSomething();
+/// });
+/// // ...
+/// auto result = task.get();
+/// ~~~~
+class ofTaskPool{
+public:
+	struct Settings{
+		/// \brief Number of worker threads, 0 to use one less than the
+		/// number of cores, since the thread waiting for the tasks also
+		/// runs them. Capped to getMaxThreads().
+		std::size_t numThreads = 0;
+
+		/// \brief Name of the workers in debuggers and profilers, followed
+		/// by the index of each worker.
+		std::string name = "ofTaskPool";
+
+		/// \brief Pins every worker to a different core. Only supported
+		/// on linux, ignored on other platforms.
+		bool pinThreads = false;
+
+		/// \brief Time workers keep looking for new tasks once they run
+		/// out of them before going to sleep.
+		///
+		/// Waking up a sleeping thread can take longer than running a
+		/// short task. Spinning for a while keeps the latency low for
+		/// tasks submitted in bursts, like parallel loops every frame, at
+		/// the cost of CPU time.
+		std::chrono::microseconds spinTime{0};
+	};
+
+	ofTaskPool();
+	ofTaskPool(const Settings & settings);
+	ofTaskPool(const ofTaskPool &) = delete;
+	ofTaskPool & operator=(const ofTaskPool &) = delete;
+
+	/// \brief Runs the tasks that are still pending and stops the workers.
+	~ofTaskPool();
+
+	/// \brief Runs f in a worker and returns a task to get its result.
+	template<typename F>
+	auto submit(F f) -> ofTask<decltype(f())>;
+
+	/// \brief Runs f in a worker, for functions whose result isn't needed.
+	///
+	/// Exceptions thrown by f are logged.
+	void post(std::function<void()> f);
+
+	/// \brief Runs one pending task in the calling thread.
+	///
+	/// \returns false if there were no pending tasks.
+	bool runPendingTask();
+
+	/// \brief Number of worker threads.
+	std::size_t getNumThreads() const;
+
+	/// \brief Number of tasks waiting for a worker.
+	std::size_t getNumPendingTasks() const;
+
+	/// \brief Whether the calling thread is one of the workers of this pool.
+	bool isWorkerThread() const;
+
+	/// \brief Maximum number of workers of a pool, the number of cores.
+	static std::size_t getMaxThreads();
+
+private:
+	struct Worker{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+		std::thread thread;
+	};
+
+	void setup(const Settings & settings);
+	void run(std::size_t index, const Settings & settings);
+	bool popTask(std::size_t index, std::function<void()> & task);
+	std::size_t getWorkerIndex() const;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex sharedMutex;
+	std::deque<std::function<void()>> sharedTasks;
+	std::atomic<std::size_t> numPending;
+	std::atomic<std::size_t> numSleeping;
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	bool stopping;
+};
+
+/// \brief Waits for a set of functions submitted together.
+///
+/// ~~~~{.cpp}
+/// ofTaskGroup group;
+/// for(auto & particles: systems){
+///     group.run([&particles]{ particles.update(); });
+/// }
+/// group.wait();
+/// ~~~~
+///
+/// The destructor waits for the functions that are still running.
+/// Exceptions thrown by them are logged.
+class ofTaskGroup{
+public:
+	ofTaskGroup();
+	ofTaskGroup(ofTaskPool & pool);
+	ofTaskGroup(const ofTaskGroup &) = delete;
+	ofTaskGroup & operator=(const ofTaskGroup &) = delete;
+	~ofTaskGroup();
+
+	/// \brief Runs f in the pool as part of this group.
+	void run(std::function<void()> f);
+
+	/// \brief Waits for all the functions run so far, running pending
+	/// tasks of the pool in the meantime.
+	void wait();
+
+	/// \brief Whether all the functions run so far have finished.
+	bool isDone() const;
+
+private:
+	struct State{
+		std::atomic<std::size_t> numRunning{0};
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+	ofTaskPool & pool;
+	std::shared_ptr<State> state;
+};
+
+/// \brief The task pool shared by openFrameworks and the application.
+///
+/// Its workers spin for a millisecond before sleeping, see
+/// Settings::spinTime.
+ofTaskPool & ofGetTaskPool();
+
+template<typename F>
+auto ofTaskPool::submit(F f) -> ofTask<decltype(f())>{
+	using T = decltype(f());
+	auto task = std::make_shared<std::packaged_task<T()>>(std::move(f));
+	auto state = std::make_shared<of::priv::TaskState<T>>(*this, task->get_future().share());
+	post([task, state]{
+		(*task)();
+		state->finish();
+	});
+	return ofTask<T>(state);
+}
+
+template<typename T>
+inline bool ofTask<T>::isValid() const{
+	return state != nullptr;
+}
+
+template<typename T>
+inline bool ofTask<T>::isReady() const{
+	return state && state->isDone();
+}
+
+template<typename T>
+inline void ofTask<T>::wait() const{
+	if(state){
+		state->wait();
+	}
+}
+
+template<typename T>
+inline auto ofTask<T>::get() const -> decltype(std::declval<std::shared_future<T>>().get()){
+	if(!state){
+		throw std::future_error(std::future_errc::no_state);
+	}
+	wait();
+	return state->future.get();
+}
+
+template<typename T>
+template<typename F>
+auto ofTask<T>::then(F f) const -> ofTask<decltype(of::priv::TaskResult<T>::call(f, std::declval<const std::shared_future<T>&>()))>{
+	using R = decltype(of::priv::TaskResult<T>::call(f, std::declval<const std::shared_future<T>&>()));
+	if(!state){
+		return ofTask<R>();
+	}
+	auto parent = state;
+	auto task = std::make_shared<std::packaged_task<R()>>([f, parent]() mutable{
+		return of::priv::TaskResult<T>::call(f, parent->future);
+	});
+	auto next = std::make_shared<of::priv::TaskState<R>>(parent->pool, task->get_future().share());
+	parent->addContinuation([task, next]{
+		(*task)();
+		next->finish();
+	});
+	return ofTask<R>(next);
+}
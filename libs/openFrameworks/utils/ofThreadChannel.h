@@ -25,6 +25,10 @@
 /// If multiple threads attempt to send data using the same ofThreadChannel, the
 /// send method will block the calling thread until it is free.
 ///
+/// ofThreadChannel grows without limit if the receiver can't keep up, see
+/// ofSpscThreadChannel and ofMpscThreadChannel for fixed size lock-free
+/// channels.
+///
 /// \sa https://github.com/openframeworks/ofBook/blob/master/chapters/threads/chapter.md
 /// \tparam T The data type sent by the ofThreadChannel.
 template<typename T>
@@ -1,6 +1,7 @@
 #include "ofURLFileLoader.h"
 #include "ofAppRunner.h"
 #include "ofUtils.h"
+#include "ofLog.h"
 
 #include "ofConstants.h"
 
@@ -10,6 +11,11 @@ using namespace std;
 	#include <curl/curl.h>
 	#include "ofThreadChannel.h"
 	#include "ofThread.h"
+	#include <algorithm>
+	#include <condition_variable>
+	#include <fstream>
+	#include <iomanip>
+	#include <sstream>
 	static bool curlInited = false;
 #endif
 
@@ -24,6 +30,436 @@ ofEvent<ofHttpResponse> & ofURLResponseEvent(){
 
 
 #if !defined(TARGET_IMPLEMENTS_URL_LOADER)
+namespace{
+	int64_t getUnixTime(){
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	// seconds a response can be used without revalidating it according to
+	// its Cache-Control header, -1 if it can't be stored
+	int64_t getMaxAge(const std::string & cacheControl){
+		int64_t maxAge = 0;
+		bool noCache = false;
+		for(auto & directive: ofSplitString(ofToLower(cacheControl), ",", true, true)){
+			if(directive == "no-store"){
+				return -1;
+			}else if(directive == "no-cache"){
+				noCache = true;
+			}else if(directive.compare(0, 8, "max-age=") == 0){
+				maxAge = ofFromString<int64_t>(directive.substr(8));
+			}
+		}
+		return noCache ? 0 : std::max<int64_t>(maxAge, 0);
+	}
+
+	// responses to GET requests, stored as <hash>.body with their url,
+	// validators, expiration and last use in <hash>.meta. the last use of
+	// a hit is only written when evicting or stopping the loader. shared
+	// by the loader thread and the blocking requests
+	class HttpCache{
+	public:
+		struct Entry{
+			std::string url;
+			std::string etag;
+			std::string lastModified;
+			int64_t expires = 0; // unix time after which it has to be revalidated
+			int64_t lastUse = 0;
+			uint64_t size = 0;
+			bool lastUseChanged = false; // not written to the .meta yet
+		};
+
+		~HttpCache();
+
+		void setup(const std::filesystem::path & directory, uint64_t maxSize);
+		bool isEnabled();
+		bool find(const std::string & url, Entry & entry);
+		std::filesystem::path getBodyPath(const std::string & url);
+		std::filesystem::path getTempPath(const std::string & url, int id);
+		bool store(Entry entry, const std::filesystem::path & body);
+		void refresh(const std::string & url, const std::string & etag, const std::string & lastModified, int64_t expires);
+		void clear();
+		void countHit(bool revalidated);
+		void countMiss();
+		ofURLFileLoaderCacheStats getStats();
+		void flush();
+
+	private:
+		void writeLastUses();
+		void load();
+		void evict(const std::string & keep);
+		void remove(const std::string & key);
+		void writeMeta(const std::string & key, const Entry & entry);
+
+		std::mutex mutex;
+		std::filesystem::path directory;
+		uint64_t maxSize = 0;
+		std::map<std::string, Entry> entries; // by key
+		ofURLFileLoaderCacheStats stats;
+	};
+
+	// 64 bit FNV-1a of the url. unlike std::hash it's the same in every
+	// build so the cache survives recompiling
+	std::string getCacheKey(const std::string & url){
+		uint64_t hash = 14695981039346656037ull;
+		for(auto c: url){
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+		std::ostringstream key;
+		key << std::hex << std::setw(16) << std::setfill('0') << hash;
+		return key.str();
+	}
+
+	void HttpCache::setup(const std::filesystem::path & dir, uint64_t maxSize){
+		std::unique_lock<std::mutex> lck(mutex);
+		this->maxSize = maxSize;
+		std::filesystem::path directory;
+		if(!dir.empty()){
+			directory = ofToDataPath(dir, true);
+		}
+		if(directory != this->directory){
+			writeLastUses();
+			this->directory = directory;
+			entries.clear();
+			stats = ofURLFileLoaderCacheStats();
+			load();
+		}
+		evict("");
+	}
+
+	void HttpCache::load(){
+		if(directory.empty()){
+			return;
+		}
+		std::vector<std::filesystem::path> files;
+		try{
+			std::filesystem::create_directories(directory);
+			for(std::filesystem::directory_iterator it(directory); it != std::filesystem::directory_iterator(); ++it){
+				files.push_back(it->path());
+			}
+		}catch(std::exception & e){
+			ofLogError("ofURLFileLoader") << "couldn't open cache directory " << directory.string() << ": " << e.what();
+			directory.clear();
+			return;
+		}
+		for(auto & path: files){
+			auto key = path.stem().string();
+			auto meta = directory / (key + ".meta");
+			auto body = directory / (key + ".body");
+			try{
+				if(path.extension() == ".tmp"){
+					// left by a download that didn't finish
+					std::filesystem::remove(path);
+				}else if(path.extension() == ".body" && !std::filesystem::exists(meta)){
+					std::filesystem::remove(path);
+				}else if(path.extension() == ".meta"){
+					Entry entry;
+					std::string expires, lastUse;
+					std::ifstream file(path.string());
+					std::getline(file, entry.url);
+					std::getline(file, entry.etag);
+					std::getline(file, entry.lastModified);
+					std::getline(file, expires);
+					std::getline(file, lastUse);
+					file.close();
+					if(entry.url.empty() || !std::filesystem::exists(body)){
+						std::filesystem::remove(path);
+						continue;
+					}
+					entry.expires = ofFromString<int64_t>(expires);
+					entry.lastUse = ofFromString<int64_t>(lastUse);
+					entry.size = std::filesystem::file_size(body);
+					entries[key] = entry;
+					stats.size += entry.size;
+				}
+			}catch(std::exception & e){
+				ofLogWarning("ofURLFileLoader") << "couldn't load cache file " << path.string() << ": " << e.what();
+			}
+		}
+	}
+
+	HttpCache::~HttpCache(){
+		flush();
+	}
+
+	bool HttpCache::isEnabled(){
+		std::unique_lock<std::mutex> lck(mutex);
+		return !directory.empty();
+	}
+
+	bool HttpCache::find(const std::string & url, Entry & entry){
+		std::unique_lock<std::mutex> lck(mutex);
+		auto it = entries.find(getCacheKey(url));
+		if(it == entries.end() || it->second.url != url){
+			return false;
+		}
+		// only in memory, written when evicting or flushing so a hit
+		// doesn't write to disk
+		it->second.lastUse = getUnixTime();
+		it->second.lastUseChanged = true;
+		entry = it->second;
+		return true;
+	}
+
+	std::filesystem::path HttpCache::getBodyPath(const std::string & url){
+		std::unique_lock<std::mutex> lck(mutex);
+		return directory / (getCacheKey(url) + ".body");
+	}
+
+	std::filesystem::path HttpCache::getTempPath(const std::string & url, int id){
+		std::unique_lock<std::mutex> lck(mutex);
+		return directory / (getCacheKey(url) + "." + ofToString(id) + ".tmp");
+	}
+
+	bool HttpCache::store(Entry entry, const std::filesystem::path & body){
+		std::unique_lock<std::mutex> lck(mutex);
+		if(directory.empty()){
+			return false;
+		}
+		auto key = getCacheKey(entry.url);
+		try{
+			entry.size = std::filesystem::file_size(body);
+			if(entry.size > maxSize){
+				return false;
+			}
+			std::filesystem::rename(body, directory / (key + ".body"));
+		}catch(std::exception & e){
+			ofLogError("ofURLFileLoader") << "couldn't cache " << entry.url << ": " << e.what();
+			return false;
+		}
+		auto it = entries.find(key);
+		if(it != entries.end()){
+			stats.size -= it->second.size;
+		}
+		entry.lastUse = getUnixTime();
+		entry.lastUseChanged = false;
+		entries[key] = entry;
+		stats.size += entry.size;
+		writeMeta(key, entry);
+		evict(key);
+		return true;
+	}
+
+	void HttpCache::refresh(const std::string & url, const std::string & etag, const std::string & lastModified, int64_t expires){
+		std::unique_lock<std::mutex> lck(mutex);
+		auto it = entries.find(getCacheKey(url));
+		if(it == entries.end() || it->second.url != url){
+			return;
+		}
+		auto & entry = it->second;
+		if(!etag.empty()){
+			entry.etag = etag;
+		}
+		if(!lastModified.empty()){
+			entry.lastModified = lastModified;
+		}
+		entry.expires = expires;
+		entry.lastUse = getUnixTime();
+		entry.lastUseChanged = false;
+		writeMeta(it->first, entry);
+	}
+
+	void HttpCache::clear(){
+		std::unique_lock<std::mutex> lck(mutex);
+		while(!entries.empty()){
+			remove(entries.begin()->first);
+		}
+	}
+
+	void HttpCache::countHit(bool revalidated){
+		std::unique_lock<std::mutex> lck(mutex);
+		stats.hits++;
+		if(revalidated){
+			stats.revalidations++;
+		}
+	}
+
+	void HttpCache::countMiss(){
+		std::unique_lock<std::mutex> lck(mutex);
+		stats.misses++;
+	}
+
+	ofURLFileLoaderCacheStats HttpCache::getStats(){
+		std::unique_lock<std::mutex> lck(mutex);
+		auto stats = this->stats;
+		stats.numEntries = entries.size();
+		return stats;
+	}
+
+	void HttpCache::flush(){
+		std::unique_lock<std::mutex> lck(mutex);
+		writeLastUses();
+	}
+
+	// writes the last use of the entries found since it was last written
+	void HttpCache::writeLastUses(){
+		if(directory.empty()){
+			return;
+		}
+		for(auto & entry: entries){
+			if(entry.second.lastUseChanged){
+				writeMeta(entry.first, entry.second);
+				entry.second.lastUseChanged = false;
+			}
+		}
+	}
+
+	// removes the least recently used responses until the cache fits in
+	// its maximum size
+	void HttpCache::evict(const std::string & keep){
+		if(stats.size <= maxSize){
+			return;
+		}
+		while(stats.size > maxSize){
+			auto oldest = entries.end();
+			for(auto it = entries.begin(); it != entries.end(); ++it){
+				if(it->first != keep && (oldest == entries.end() || it->second.lastUse < oldest->second.lastUse)){
+					oldest = it;
+				}
+			}
+			if(oldest == entries.end()){
+				return;
+			}
+			remove(oldest->first);
+			stats.evictions++;
+		}
+		// the order of the entries left has to survive a restart
+		writeLastUses();
+	}
+
+	void HttpCache::remove(const std::string & key){
+		auto it = entries.find(key);
+		if(it == entries.end()){
+			return;
+		}
+		try{
+			std::filesystem::remove(directory / (key + ".body"));
+			std::filesystem::remove(directory / (key + ".meta"));
+		}catch(std::exception & e){
+			ofLogWarning("ofURLFileLoader") << "couldn't remove cache entry " << key << ": " << e.what();
+		}
+		// key might be the one in the entry, erased last
+		stats.size -= it->second.size;
+		entries.erase(it);
+	}
+
+	void HttpCache::writeMeta(const std::string & key, const Entry & entry){
+		std::ofstream file((directory / (key + ".meta")).string());
+		file << entry.url << "\n"
+			<< entry.etag << "\n"
+			<< entry.lastModified << "\n"
+			<< entry.expires << "\n"
+			<< entry.lastUse << "\n";
+		if(!file){
+			ofLogWarning("ofURLFileLoader") << "couldn't write cache entry for " << entry.url;
+		}
+	}
+
+	typedef ofThreadChannel<std::function<void()>> Notifications;
+
+	// a request while curl runs it
+	struct Transfer{
+		Transfer(const ofHttpRequest & request, size_t retries, Notifications * notifications)
+		:request(request)
+		,response(request, 0, "")
+		,body(request.body)
+		,retries(retries)
+		,notifications(notifications){}
+
+		~Transfer(){
+			if(headers){
+				curl_slist_free_all(headers);
+			}
+			if(!cachePath.empty()){
+				cacheFile.close();
+				try{
+					std::filesystem::remove(cachePath);
+				}catch(...){
+				}
+			}
+		}
+
+		// receives the body from curl or from the cache
+		void write(const char * data, size_t size){
+			if(cacheFile.is_open()){
+				cacheFile.write(data, size);
+			}
+			if(file){
+				file->write(data, size);
+			}else if(request.stream){
+				streamed = true;
+				if(notifications){
+					chunk.append(data, size);
+				}else{
+					request.stream(ofBuffer(data, size));
+				}
+			}else{
+				response.data.append(data, size);
+			}
+		}
+
+		// sends the progress and the data streamed since the last call to
+		// be notified in update
+		void notify(){
+			if(!notifications){
+				return;
+			}
+			if(request.progress && (received != notifiedReceived || total != notifiedTotal)){
+				notifiedReceived = received;
+				notifiedTotal = total;
+				auto progress = request.progress;
+				auto received = this->received;
+				auto total = this->total;
+				notifications->send([progress, received, total]{
+					progress(received, total);
+				});
+			}
+			if(chunk.size() > 0){
+				auto stream = request.stream;
+				auto data = std::make_shared<ofBuffer>(std::move(chunk));
+				chunk.clear();
+				notifications->send([stream, data]{
+					stream(*data);
+				});
+			}
+		}
+
+		ofHttpRequest request;
+		ofHttpResponse response;
+		std::unique_ptr<ofFile> file;
+		std::string body;
+		curl_slist * headers = nullptr;
+		size_t retries;
+		Notifications * notifications; // null for blocking requests
+		ofBuffer chunk;
+		bool streamed = false;
+		uint64_t received = 0;
+		uint64_t total = 0;
+		uint64_t notifiedReceived = 0;
+		uint64_t notifiedTotal = 0;
+
+		// a copy of the body is written to cachePath while it downloads
+		std::ofstream cacheFile;
+		std::filesystem::path cachePath;
+		bool revalidating = false;
+		std::map<std::string, std::string> responseHeaders; // lowercase names
+	};
+
+	// a request waiting for a free transfer, ordered by priority first
+	// and the order they were made after
+	struct PendingRequest{
+		ofHttpRequest request;
+		size_t retries;
+
+		bool operator<(const PendingRequest & other) const{
+			if(request.priority != other.request.priority){
+				return request.priority < other.request.priority;
+			}
+			return request.getId() > other.request.getId();
+		}
+	};
+}
+
 class ofURLFileLoaderImpl: public ofThread, public ofBaseURLFileLoader{
 public:
 	ofURLFileLoaderImpl();
@@ -35,6 +471,9 @@ public:
 	void remove(int id);
 	void clear();
 	void stop();
+	void setup(const ofURLFileLoaderSettings & settings);
+	ofURLFileLoaderCacheStats getCacheStats();
+	void clearCache();
 	ofHttpResponse handleRequest(const ofHttpRequest & request);
 	int handleRequestAsync(const ofHttpRequest& request); // returns id
 
@@ -42,24 +481,246 @@ protected:
 	// threading -----------------------------------------------
 	void threadedFunction();
 	void start();
+	void wakeUp();
 	void update(ofEventArgs & args);  // notify in update so the notification is thread safe
 
 private:
-	// perform the requests on the thread
-
-	ofThreadChannel<ofHttpRequest> requests;
-	ofThreadChannel<ofHttpResponse> responses;
-	ofThreadChannel<int> cancelRequestQueue;
-	set<int> cancelledRequests;
-	std::unique_ptr<CURL, void(*)(CURL*)> curl;
+	// runs the transfers on the thread
+	bool startTransfers(std::vector<PendingRequest> & requests);
+	void cancelTransfers();
+	void finishTransfer(CURL * handle, CURLcode result);
+	void notifyResponse(Transfer & transfer);
+	void applySettings();
+
+	// shared with the thread, protected by mutex
+	std::vector<PendingRequest> pending;
+	std::vector<int> cancelledRequests;
+	bool cancelAll = false;
+	bool settingsChanged = true;
+	ofURLFileLoaderSettings settings;
+	std::condition_variable requestsCondition;
+
+	// only used by the thread
+	std::map<CURL*, std::unique_ptr<Transfer>> active;
+	std::vector<CURL*> idleHandles;
+	ofURLFileLoaderSettings threadSettings;
+
+	// progress, streamed data and responses, in the order they happen
+	Notifications notifications;
+	HttpCache cache;
+	std::unique_ptr<CURLM, CURLMcode(*)(CURLM*)> multi;
 };
 
+namespace{
+	size_t write_cb(void *buffer, size_t size, size_t nmemb, void *userdata){
+		auto transfer = (Transfer*)userdata;
+		transfer->write((const char*)buffer, size * nmemb);
+		return size * nmemb;
+	}
+
+	size_t header_cb(char *buffer, size_t size, size_t nitems, void *userdata){
+		auto transfer = (Transfer*)userdata;
+		std::string line(buffer, size * nitems);
+		if(line.compare(0, 5, "HTTP/") == 0){
+			// every redirection starts a new response
+			transfer->responseHeaders.clear();
+		}else{
+			auto colon = line.find(':');
+			if(colon != std::string::npos){
+				transfer->responseHeaders[ofToLower(ofTrim(line.substr(0, colon)))] = ofTrim(line.substr(colon + 1));
+			}
+		}
+		return size * nitems;
+	}
+
+    size_t readBody_cb(void *ptr, size_t size, size_t nmemb, void *userdata){
+        auto body = (std::string*)userdata;
+
+        if(size*nmemb < 1){
+            return 0;
+        }
+
+        if(!body->empty()) {
+            auto sent = std::min(size * nmemb, body->size());
+            memcpy(ptr, body->c_str(), sent);
+            *body = body->substr(sent);
+            return sent;
+        }
+
+        return 0;                          /* no more data left to deliver */
+    }
+
+	int progress_cb(void *userdata, curl_off_t dltotal, curl_off_t dlnow, curl_off_t, curl_off_t){
+		auto transfer = (Transfer*)userdata;
+		transfer->received = dlnow;
+		transfer->total = dltotal;
+		return 0;
+	}
+
+	// fills the response with the cached body as if it was downloaded
+	bool respondFromCache(HttpCache & cache, Transfer & transfer){
+		std::ifstream body(cache.getBodyPath(transfer.request.url).string(), std::ios::binary);
+		if(!body){
+			return false;
+		}
+		if(transfer.request.saveTo){
+			transfer.file.reset(new ofFile(transfer.request.name, ofFile::WriteOnly, true));
+		}
+		std::vector<char> buffer(64 * 1024);
+		transfer.received = 0;
+		while(body.read(buffer.data(), buffer.size()) || body.gcount() > 0){
+			transfer.write(buffer.data(), body.gcount());
+			transfer.received += body.gcount();
+			transfer.total = transfer.received;
+			transfer.notify();
+		}
+		transfer.file.reset();
+		transfer.response.status = 200;
+		transfer.response.error = "";
+		return true;
+	}
+
+	// answers the request with the cached response while it's fresh,
+	// otherwise prepares the transfer to revalidate or store it. returns
+	// true when the response is ready
+	bool prepareCache(HttpCache & cache, Transfer & transfer){
+		auto & request = transfer.request;
+		if(!request.useCache || request.method != ofHttpRequest::GET || !request.body.empty() || !cache.isEnabled()){
+			return false;
+		}
+		HttpCache::Entry entry;
+		if(cache.find(request.url, entry)){
+			if(getUnixTime() < entry.expires && respondFromCache(cache, transfer)){
+				cache.countHit(false);
+				return true;
+			}
+			if(!entry.etag.empty()){
+				transfer.headers = curl_slist_append(transfer.headers, ("If-None-Match: " + entry.etag).c_str());
+			}
+			if(!entry.lastModified.empty()){
+				transfer.headers = curl_slist_append(transfer.headers, ("If-Modified-Since: " + entry.lastModified).c_str());
+			}
+			transfer.revalidating = !entry.etag.empty() || !entry.lastModified.empty();
+		}
+		transfer.cachePath = cache.getTempPath(request.url, request.getId());
+		transfer.cacheFile.open(transfer.cachePath.string(), std::ios::binary);
+		if(!transfer.cacheFile){
+			ofLogWarning("ofURLFileLoader") << "couldn't create cache file " << transfer.cachePath.string();
+			transfer.cachePath.clear();
+		}
+		return false;
+	}
+
+	// stores the downloaded response or, when the server says the cached
+	// one is still valid, answers with it
+	void finishCache(HttpCache & cache, Transfer & transfer){
+		if(transfer.cachePath.empty()){
+			return;
+		}
+		transfer.cacheFile.close();
+		auto & headers = transfer.responseHeaders;
+		auto maxAge = getMaxAge(headers["cache-control"]);
+		auto expires = getUnixTime() + std::max<int64_t>(maxAge, 0);
+		if(transfer.response.status == 304 && transfer.revalidating){
+			cache.refresh(transfer.request.url, headers["etag"], headers["last-modified"], expires);
+			if(respondFromCache(cache, transfer)){
+				cache.countHit(true);
+			}
+		}else if(transfer.response.status == 200){
+			cache.countMiss();
+			HttpCache::Entry entry;
+			entry.url = transfer.request.url;
+			entry.etag = headers["etag"];
+			entry.lastModified = headers["last-modified"];
+			entry.expires = expires;
+			// without validators an expired response can't be reused
+			auto reusable = maxAge > 0 || (maxAge == 0 && (!entry.etag.empty() || !entry.lastModified.empty()));
+			if(reusable && cache.store(entry, transfer.cachePath)){
+				transfer.cachePath.clear();
+			}
+		}
+	}
+
+	void setupTransfer(CURL * curl, Transfer & transfer, const ofURLFileLoaderSettings & settings){
+		auto & request = transfer.request;
+		curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
+		curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
+		curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+
+		// always follow redirections
+		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+
+		// Set content type and any other header
+		if(request.contentType!=""){
+			transfer.headers = curl_slist_append(transfer.headers, ("Content-Type: " + request.contentType).c_str());
+		}
+		for(map<string,string>::const_iterator it = request.headers.cbegin(); it!=request.headers.cend(); it++){
+			transfer.headers = curl_slist_append(transfer.headers, (it->first + ": " +it->second).c_str());
+		}
+
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
+
+		// set body if there's any
+		if(request.body!=""){
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.size());
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, nullptr);
+			curl_easy_setopt(curl, CURLOPT_READFUNCTION, readBody_cb);
+			curl_easy_setopt(curl, CURLOPT_READDATA, &transfer.body);
+		}
+		if(request.method == ofHttpRequest::GET){
+			curl_easy_setopt(curl, CURLOPT_HTTPGET, 1);
+		}else{
+			curl_easy_setopt(curl, CURLOPT_POST, 1);
+		}
+
+		auto timeout = request.timeoutSeconds > 0 ? request.timeoutSeconds : settings.timeoutSeconds;
+		if(timeout>0){
+			curl_easy_setopt(curl, CURLOPT_TIMEOUT, long(timeout));
+		}
+		if(settings.connectTimeoutSeconds>0){
+			curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, long(settings.connectTimeoutSeconds));
+		}
+
+		if(request.progress){
+			curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progress_cb);
+			curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &transfer);
+			curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+		}
+
+		if(!transfer.cachePath.empty()){
+			curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_cb);
+			curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+		}
+
+		// the body goes straight to the file, the stream callback or
+		// the response data, see Transfer::write
+		if(request.saveTo){
+			transfer.file.reset(new ofFile(request.name, ofFile::WriteOnly, true));
+		}
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_cb);
+	}
+
+	void finishResponse(CURL * curl, Transfer & transfer, CURLcode err){
+		transfer.file.reset();
+		if(err==CURLE_OK){
+			long http_code = 0;
+			curl_easy_getinfo (curl, CURLINFO_RESPONSE_CODE, &http_code);
+			transfer.response.status = http_code;
+		}else{
+			transfer.response.error = curl_easy_strerror(err);
+			transfer.response.status = -1;
+		}
+	}
+}
+
 ofURLFileLoaderImpl::ofURLFileLoaderImpl()
-:curl(nullptr, nullptr){
+:multi(nullptr, nullptr){
 	if(!curlInited){
 		 curl_global_init(CURL_GLOBAL_ALL);
+		 curlInited = true;
 	}
-	curl = std::unique_ptr<CURL, void(*)(CURL*)>(curl_easy_init(), curl_easy_cleanup);
+	multi = std::unique_ptr<CURLM, CURLMcode(*)(CURLM*)>(curl_multi_init(), curl_multi_cleanup);
 }
 
 ofURLFileLoaderImpl::~ofURLFileLoaderImpl(){
@@ -75,9 +736,7 @@ ofHttpResponse ofURLFileLoaderImpl::get(const string& url) {
 
 int ofURLFileLoaderImpl::getAsync(const string& url, const string& name){
 	ofHttpRequest request(url, name.empty() ? url : name);
-	requests.send(request);
-	start();
-	return request.getId();
+	return handleRequestAsync(request);
 }
 
 
@@ -88,20 +747,52 @@ ofHttpResponse ofURLFileLoaderImpl::saveTo(const string& url, const std::filesys
 
 int ofURLFileLoaderImpl::saveAsync(const string& url, const std::filesystem::path& path){
 	ofHttpRequest request(url,path.string(),true);
-	requests.send(request);
-	start();
-	return request.getId();
+	return handleRequestAsync(request);
 }
 
 void ofURLFileLoaderImpl::remove(int id){
-	cancelRequestQueue.send(id);
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		auto it = std::find_if(pending.begin(), pending.end(), [id](const PendingRequest & p){
+			return p.request.getId() == id;
+		});
+		if(it != pending.end()){
+			pending.erase(it);
+			std::make_heap(pending.begin(), pending.end());
+			return;
+		}
+		cancelledRequests.push_back(id);
+	}
+	wakeUp();
 }
 
 void ofURLFileLoaderImpl::clear(){
-	ofHttpResponse resp;
-	ofHttpRequest req;
-	while(requests.tryReceive(req)){}
-	while(responses.tryReceive(resp)){}
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		pending.clear();
+		cancelAll = true;
+	}
+	wakeUp();
+	std::function<void()> notification;
+	while(notifications.tryReceive(notification)){}
+}
+
+void ofURLFileLoaderImpl::setup(const ofURLFileLoaderSettings & settings){
+	cache.setup(settings.cacheDirectory, settings.maxCacheSize);
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		this->settings = settings;
+		settingsChanged = true;
+	}
+	wakeUp();
+}
+
+ofURLFileLoaderCacheStats ofURLFileLoaderImpl::getCacheStats(){
+	return cache.getStats();
+}
+
+void ofURLFileLoaderImpl::clearCache(){
+	cache.clear();
 }
 
 void ofURLFileLoaderImpl::start() {
@@ -113,166 +804,217 @@ void ofURLFileLoaderImpl::start() {
 
 void ofURLFileLoaderImpl::stop() {
 	stopThread();
-	requests.close();
-	responses.close();
-	waitForThread();
+	wakeUp();
+	waitForThread(false);
+	cache.flush();
+	ofRemoveListener(ofEvents().update,this,&ofURLFileLoaderImpl::update);
 }
 
-void ofURLFileLoaderImpl::threadedFunction() {
-	setThreadName("ofURLFileLoader " + ofToString(getThreadId()));
-	while( isThreadRunning() ){
-		int cancelled;
-		while(cancelRequestQueue.tryReceive(cancelled)){
-			cancelledRequests.insert(cancelled);
+void ofURLFileLoaderImpl::wakeUp(){
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+	}
+	requestsCondition.notify_all();
+	curl_multi_wakeup(multi.get());
+}
+
+void ofURLFileLoaderImpl::applySettings(){
+	auto maxHost = long(threadSettings.maxConnectionsPerHost);
+	curl_multi_setopt(multi.get(), CURLMOPT_MAX_HOST_CONNECTIONS, maxHost);
+	// keeps enough finished connections around to reuse them
+	curl_multi_setopt(multi.get(), CURLMOPT_MAXCONNECTS, long(std::max<size_t>(threadSettings.maxConcurrentRequests, 1) * 2));
+	curl_multi_setopt(multi.get(), CURLMOPT_PIPELINING, long(CURLPIPE_MULTIPLEX));
+}
+
+// returns true if some of the requests were answered from the cache so
+// others can start in their place
+bool ofURLFileLoaderImpl::startTransfers(std::vector<PendingRequest> & requests){
+	bool answered = false;
+	for(auto & next: requests){
+		std::unique_ptr<Transfer> transfer(new Transfer(next.request, next.retries, &notifications));
+		if(prepareCache(cache, *transfer)){
+			notifyResponse(*transfer);
+			answered = true;
+			continue;
 		}
-		ofHttpRequest request;
-		if(requests.receive(request)){
-			if(cancelledRequests.find(request.getId())==cancelledRequests.end()){
-				ofHttpResponse response(handleRequest(request));
-				int status = response.status;
-				if(!responses.send(move(response))){
-					break;
-				}
-				if(status==-1){
-					// retry
-					requests.send(request);
-				}
-			}else{
-				cancelledRequests.erase(cancelled);
-			}
+
+		// reused handles keep their connections and dns cache
+		CURL * handle;
+		if(idleHandles.empty()){
+			handle = curl_easy_init();
 		}else{
-			break;
+			handle = idleHandles.back();
+			idleHandles.pop_back();
+			curl_easy_reset(handle);
 		}
+		setupTransfer(handle, *transfer, threadSettings);
+		curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer.get());
+		curl_multi_add_handle(multi.get(), handle);
+		active[handle] = std::move(transfer);
 	}
+	return answered;
 }
 
-namespace{
-	size_t saveToFile_cb(void *buffer, size_t size, size_t nmemb, void *userdata){
-		auto saveTo = (ofFile*)userdata;
-		saveTo->write((const char*)buffer, size * nmemb);
-		return size * nmemb;
+void ofURLFileLoaderImpl::cancelTransfers(){
+	std::vector<int> cancelled;
+	bool all;
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		std::swap(cancelled, cancelledRequests);
+		all = cancelAll;
+		cancelAll = false;
 	}
-
-	size_t saveToMemory_cb(void *buffer, size_t size, size_t nmemb, void *userdata){
-		auto response = (ofHttpResponse*)userdata;
-		response->data.append((const char*)buffer, size * nmemb);
-		return size * nmemb;
+	for(auto it = active.begin(); it != active.end();){
+		auto id = it->second->request.getId();
+		if(all || std::find(cancelled.begin(), cancelled.end(), id) != cancelled.end()){
+			curl_multi_remove_handle(multi.get(), it->first);
+			idleHandles.push_back(it->first);
+			it = active.erase(it);
+		}else{
+			++it;
+		}
 	}
+}
 
-    size_t readBody_cb(void *ptr, size_t size, size_t nmemb, void *userdata){
-        auto body = (std::string*)userdata;
+void ofURLFileLoaderImpl::notifyResponse(Transfer & transfer){
+	transfer.notify();
+	auto response = std::make_shared<ofHttpResponse>(std::move(transfer.response));
+	notifications.send([response]{
+		try{
+			if(response->request.done){
+				response->request.done(*response);
+			}
+		}catch(...){
 
-        if(size*nmemb < 1){
-            return 0;
-        }
+		}
 
-        if(!body->empty()) {
-            auto sent = std::min(size * nmemb, body->size());
-            memcpy(ptr, body->c_str(), sent);
-            *body = body->substr(sent);
-            return sent;
-        }
+		ofNotifyEvent(ofURLResponseEvent(),*response);
+	});
+}
 
-        return 0;                          /* no more data left to deliver */
-    }
+void ofURLFileLoaderImpl::finishTransfer(CURL * handle, CURLcode result){
+	auto it = active.find(handle);
+	curl_multi_remove_handle(multi.get(), handle);
+	idleHandles.push_back(handle);
+	if(it == active.end()){
+		return;
+	}
+	auto transfer = std::move(it->second);
+	active.erase(it);
+	finishResponse(handle, *transfer, result);
+	// streamed data can't be taken back, those aren't retried once started
+	if(transfer->response.status == -1 && transfer->retries < threadSettings.maxRetries && !transfer->streamed){
+		std::unique_lock<std::mutex> lck(mutex);
+		pending.push_back({transfer->request, transfer->retries + 1});
+		std::push_heap(pending.begin(), pending.end());
+		return;
+	}
+	finishCache(cache, *transfer);
+	notifyResponse(*transfer);
 }
 
-ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
-	curl_slist *headers = nullptr;
-	curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYPEER, 0);
-	curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYHOST, 0);
-	curl_easy_setopt(curl.get(), CURLOPT_URL, request.url.c_str());
-
-	// always follow redirections
-	curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
-
-	// Set content type and any other header
-	if(request.contentType!=""){
-		headers = curl_slist_append(headers, ("Content-Type: " + request.contentType).c_str());
-	}
-	for(map<string,string>::const_iterator it = request.headers.cbegin(); it!=request.headers.cend(); it++){
-		headers = curl_slist_append(headers, (it->first + ": " +it->second).c_str());
-	}
-
-	curl_easy_setopt(curl.get(), CURLOPT_HTTPHEADER, headers);
-
-    std::string body = request.body;
-
-	// set body if there's any
-	if(request.body!=""){
-//		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 1L); // Tis does PUT instead of POST
-		curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, request.body.size());
-		curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, nullptr);
-		//curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, request.body.c_str());
-		curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, readBody_cb);
-		curl_easy_setopt(curl.get(), CURLOPT_READDATA, &body);
-	}else{
-//		curl_easy_setopt(curl.get(), CURLOPT_UPLOAD, 0L);
-		curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, 0);
-        //curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, nullptr);
-        curl_easy_setopt(curl.get(), CURLOPT_READFUNCTION, nullptr);
-        curl_easy_setopt(curl.get(), CURLOPT_READDATA, nullptr);
-	}
-	if(request.method == ofHttpRequest::GET){
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 1);
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 0);
-	}else{
-		curl_easy_setopt(curl.get(), CURLOPT_POST, 1);
-		curl_easy_setopt(curl.get(), CURLOPT_HTTPGET, 0);
-	}
-
-    if(request.timeoutSeconds>0){
-        curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, request.timeoutSeconds);
-    }
+void ofURLFileLoaderImpl::threadedFunction() {
+	setThreadName("ofURLFileLoader " + ofToString(getThreadId()));
+	std::vector<PendingRequest> next;
+	while( isThreadRunning() ){
+		cancelTransfers();
+		next.clear();
+		{
+			std::unique_lock<std::mutex> lck(mutex);
+			if(settingsChanged){
+				threadSettings = settings;
+				settingsChanged = false;
+				applySettings();
+			}
+			auto maxActive = std::max<size_t>(threadSettings.maxConcurrentRequests, 1);
+			while(active.size() + next.size() < maxActive && !pending.empty()){
+				std::pop_heap(pending.begin(), pending.end());
+				next.push_back(std::move(pending.back()));
+				pending.pop_back();
+			}
+			if(active.empty() && next.empty()){
+				// nothing to do until there's a new request
+				if(pending.empty() && cancelledRequests.empty() && !cancelAll && !settingsChanged && isThreadRunning()){
+					requestsCondition.wait(lck);
+				}
+				continue;
+			}
+		}
 
-	// start request and receive response
-	ofHttpResponse response(request, 0, "");
-	CURLcode err = CURLE_OK;
-	if(request.saveTo){
-		ofFile saveTo(request.name, ofFile::WriteOnly, true);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &saveTo);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToFile_cb);
-		err = curl_easy_perform(curl.get());
-	}else{
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &response);
-		curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, saveToMemory_cb);
-		err = curl_easy_perform(curl.get());
-	}
-	if(err==CURLE_OK){
-		long http_code = 0;
-		curl_easy_getinfo (curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
-		response.status = http_code;
-	}else{
-		response.error = curl_easy_strerror(err);
-		response.status = -1;
+		// cached responses are read outside of the lock so new requests
+		// don't wait for them
+		bool finished = startTransfers(next);
+		if(active.empty()){
+			continue;
+		}
+
+		int running = 0;
+		curl_multi_perform(multi.get(), &running);
+		CURLMsg * msg;
+		int left;
+		while((msg = curl_multi_info_read(multi.get(), &left))){
+			if(msg->msg == CURLMSG_DONE){
+				finishTransfer(msg->easy_handle, msg->data.result);
+				finished = true;
+			}
+		}
+		for(auto & transfer: active){
+			transfer.second->notify();
+		}
+
+		// waits for data in any of the transfers or wakeUp(), unless some
+		// finished and waiting requests can start now
+		if(!finished){
+			curl_multi_poll(multi.get(), nullptr, 0, 1000, nullptr);
+		}
 	}
 
-	if(headers){
-		curl_slist_free_all(headers);
+	for(auto & transfer: active){
+		curl_multi_remove_handle(multi.get(), transfer.first);
+		curl_easy_cleanup(transfer.first);
+	}
+	active.clear();
+	for(auto handle: idleHandles){
+		curl_easy_cleanup(handle);
 	}
+	idleHandles.clear();
+}
 
-	return response;
+ofHttpResponse ofURLFileLoaderImpl::handleRequest(const ofHttpRequest & request) {
+	ofURLFileLoaderSettings settings;
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		settings = this->settings;
+	}
+	Transfer transfer(request, 0, nullptr);
+	if(prepareCache(cache, transfer)){
+		return transfer.response;
+	}
+	std::unique_ptr<CURL, void(*)(CURL*)> curl(curl_easy_init(), curl_easy_cleanup);
+	setupTransfer(curl.get(), transfer, settings);
+	CURLcode err = curl_easy_perform(curl.get());
+	finishResponse(curl.get(), transfer, err);
+	finishCache(cache, transfer);
+	return transfer.response;
 }
 
 
 int ofURLFileLoaderImpl::handleRequestAsync(const ofHttpRequest& request){
-	requests.send(request);
+	{
+		std::unique_lock<std::mutex> lck(mutex);
+		pending.push_back({request, 0});
+		std::push_heap(pending.begin(), pending.end());
+	}
 	start();
+	wakeUp();
 	return request.getId();
 }
 
 void ofURLFileLoaderImpl::update(ofEventArgs & args){
-	ofHttpResponse response;
-	while(responses.tryReceive(response)){
-		try{
-			response.request.done(response);
-		}catch(...){
-
-		}
-
-		ofNotifyEvent(ofURLResponseEvent(),response);
+	std::function<void()> notification;
+	while(notifications.tryReceive(notification)){
+		notification();
 	}
-
 }
 
 ofURLFileLoader::ofURLFileLoader()
@@ -307,6 +1049,18 @@ void ofURLFileLoader::stop(){
 	impl->stop();
 }
 
+void ofURLFileLoader::setup(const ofURLFileLoaderSettings & settings){
+	impl->setup(settings);
+}
+
+ofURLFileLoaderCacheStats ofURLFileLoader::getCacheStats(){
+	return impl->getCacheStats();
+}
+
+void ofURLFileLoader::clearCache(){
+	impl->clearCache();
+}
+
 ofHttpResponse ofURLFileLoader::handleRequest(const ofHttpRequest & request){
 	return impl->handleRequest(request);
 }
@@ -402,6 +1156,18 @@ void ofStopURLLoader(){
 	getFileLoader().stop();
 }
 
+void ofSetURLLoaderSettings(const ofURLFileLoaderSettings & settings){
+	getFileLoader().setup(settings);
+}
+
+ofURLFileLoaderCacheStats ofGetURLLoaderCacheStats(){
+	return getFileLoader().getCacheStats();
+}
+
+void ofClearURLLoaderCache(){
+	getFileLoader().clearCache();
+}
+
 void ofURLFileLoaderShutdown(){
 	if(initialized){
 		ofRemoveAllURLRequests();
@@ -20,7 +20,17 @@ public:
 	std::string				body; //< POST body data
 	std::string				contentType; //< POST data mime type
 	std::function<void(const ofHttpResponse&)> done;
+	/// called from the update thread while the response downloads with
+	/// the bytes received so far and the total, 0 if it's unknown
+	std::function<void(uint64_t received, uint64_t total)> progress;
+	/// if set, receives the response in pieces as it downloads instead of
+	/// keeping it all in the response data, in order and before done. called
+	/// from the update thread for asynchronous requests and from the thread
+	/// that makes the request for blocking ones. ignored when saving to a file
+	std::function<void(const ofBuffer & chunk)> stream;
     size_t              timeoutSeconds = 0;
+	int					priority = 0; //< requests with higher priority start first
+	bool				useCache = true; //< whether a GET request can be answered from the loader's cache
 
 	/// \return the unique id for this request
 	int getId() const;
@@ -53,6 +63,42 @@ public:
 	std::string				error; //< HTTP error string, if any (OK, Not Found, etc)
 };
 
+/// \struct ofURLFileLoaderSettings
+/// \brief settings of the asynchronous requests of an ofURLFileLoader
+struct ofURLFileLoaderSettings{
+	/// requests running at the same time, the rest wait in the queue
+	size_t maxConcurrentRequests = 8;
+	/// connections open to the same host at the same time, 0 for no limit.
+	/// finished connections are kept open and reused by later requests
+	size_t maxConnectionsPerHost = 4;
+	/// seconds to wait for a connection, 0 uses curl's default
+	size_t connectTimeoutSeconds = 30;
+	/// seconds a request can take when its timeoutSeconds is 0, 0 for no limit
+	size_t timeoutSeconds = 0;
+	/// times a request that couldn't connect or timed out is retried
+	/// before its response is notified
+	size_t maxRetries = 3;
+	/// directory where the responses to GET requests are kept between runs,
+	/// relative to the data folder. empty disables the cache. responses are
+	/// reused without asking the server while their Cache-Control max-age
+	/// lasts, and revalidated with their ETag or Last-Modified after that
+	std::filesystem::path cacheDirectory;
+	/// bytes the cache can use, the least recently used responses are
+	/// removed to stay under it
+	uint64_t maxCacheSize = 256 * 1024 * 1024;
+};
+
+/// \struct ofURLFileLoaderCacheStats
+/// \brief usage of the cache of an ofURLFileLoader since it was set up
+struct ofURLFileLoaderCacheStats{
+	uint64_t hits = 0; //< requests answered from the cache, revalidated ones included
+	uint64_t revalidations = 0; //< hits the server confirmed with 304 Not Modified
+	uint64_t misses = 0; //< cacheable requests that downloaded the response
+	uint64_t evictions = 0; //< responses removed to stay under the maximum size
+	uint64_t size = 0; //< bytes used by the cached responses
+	size_t numEntries = 0; //< number of cached responses
+};
+
 /// \brief make an HTTP GET request
 /// blocks until a response is returned or the request times out
 /// \param url HTTP url to request, ie. "http://somewebsite.com/someapi/someimage.jpg"
@@ -93,6 +139,16 @@ void ofRemoveAllURLRequests();
 /// \brief stop & remove all active and waiting HTTP requests
 void ofStopURLLoader();
 
+/// \brief set the concurrency, connection reuse and timeouts of the
+/// asynchronous requests
+void ofSetURLLoaderSettings(const ofURLFileLoaderSettings & settings);
+
+/// \brief hits, misses and size of the cache of the url loader
+ofURLFileLoaderCacheStats ofGetURLLoaderCacheStats();
+
+/// \brief remove all the responses in the cache of the url loader
+void ofClearURLLoaderCache();
+
 ofEvent<ofHttpResponse> & ofURLResponseEvent();
 
 template<class T>
@@ -150,6 +206,16 @@ class ofURLFileLoader  {
 	
 		/// \brief stop & remove all active and waiting HTTP requests
 		void stop();
+
+		/// \brief set the concurrency, connection reuse and timeouts of
+		/// the asynchronous requests
+		void setup(const ofURLFileLoaderSettings & settings);
+
+		/// \return hits, misses and size of the cache
+		ofURLFileLoaderCacheStats getCacheStats();
+
+		/// \brief remove all the responses in the cache
+		void clearCache();
 	
 		// \brief low level HTTP request implementation
 		/// blocks until a response is returned or the request times out
@@ -210,6 +276,17 @@ public:
 	/// \brief stop & remove all active and waiting HTTP requests
 	virtual void stop()=0;
 
+	/// \brief set the concurrency, connection reuse and timeouts of the
+	/// asynchronous requests, ignored by loaders that don't support them
+	virtual void setup(const ofURLFileLoaderSettings & settings){}
+
+	/// \return hits, misses and size of the cache, empty for loaders
+	/// without one
+	virtual ofURLFileLoaderCacheStats getCacheStats(){ return ofURLFileLoaderCacheStats(); }
+
+	/// \brief remove all the responses in the cache
+	virtual void clearCache(){}
+
 	/// \brief low level HTTP request implementation
 	/// blocks until a response is returned or the request times out
 	/// \return HTTP response on success or failure
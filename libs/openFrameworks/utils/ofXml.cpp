@@ -26,7 +26,14 @@ bool ofXml::load(const std::filesystem::path & file){
 }
 
 bool ofXml::load(const ofBuffer & buffer){
-	return parse(buffer.getText());
+	auto auxDoc = std::make_shared<pugi::xml_document>();
+	if(auxDoc->load_buffer(buffer.getData(), buffer.size())){
+		doc = auxDoc;
+		xml = doc->root();
+		return true;
+	}else{
+		return false;
+	}
 }
 
 bool ofXml::parse(const std::string & xmlStr){
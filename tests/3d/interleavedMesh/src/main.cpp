@@ -0,0 +1,74 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+struct Vertex2D{
+	glm::vec2 position;
+	glm::vec2 texCoord;
+};
+
+// the formats are resolved at compile time
+static_assert(ofVertexFormat<ofVertexPNCT>::hasNormals, "PNCT has normals");
+static_assert(ofVertexFormat<ofVertexPNCT>::hasColors, "PNCT has colors");
+static_assert(ofVertexFormat<ofVertexPNCT>::hasTexCoords, "PNCT has tex coords");
+static_assert(!ofVertexFormat<ofVertexP>::hasNormals, "P has no normals");
+static_assert(!ofVertexFormat<ofVertexPN>::hasColors, "PN has no colors");
+static_assert(!ofVertexFormat<ofVertexPC>::hasTexCoords, "PC has no tex coords");
+static_assert(ofVertexFormat<ofVertexPNCT>::numPositionCoords == 3, "3d positions");
+static_assert(ofVertexFormat<Vertex2D>::numPositionCoords == 2, "2d positions");
+static_assert(ofVertexFormat<ofVertexPNCT>::stride == sizeof(ofVertexPNCT), "stride is the size of the vertex");
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "vertex format offsets";
+			typedef ofVertexFormat<ofVertexPNCT> PNCT;
+			test_eq(PNCT::normalOffset(), int(offsetof(ofVertexPNCT, normal)), "PNCT normal offset");
+			test_eq(PNCT::colorOffset(), int(offsetof(ofVertexPNCT, color)), "PNCT color offset");
+			test_eq(PNCT::texCoordOffset(), int(offsetof(ofVertexPNCT, texCoord)), "PNCT tex coord offset");
+			test_eq(ofVertexFormat<ofVertexPT>::texCoordOffset(), int(sizeof(glm::vec3)), "PT tex coord after the position");
+			test_eq(ofVertexFormat<ofVertexP>::normalOffset(), -1, "missing normals have no offset");
+			test_eq(ofVertexFormat<ofVertexPN>::colorOffset(), -1, "missing colors have no offset");
+			test_eq(ofVertexFormat<ofVertexPC>::texCoordOffset(), -1, "missing tex coords have no offset");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "conversion from and to ofMesh";
+			auto mesh = ofMesh::sphere(10, 8);
+			for(std::size_t i = 0; i < mesh.getNumVertices(); i++){
+				mesh.addColor(ofFloatColor(i / float(mesh.getNumVertices()), 0.5, 1));
+			}
+
+			ofInterleavedMesh interleaved(mesh);
+			test_eq(interleaved.getNumVertices(), mesh.getNumVertices(), "same number of vertices");
+			test(interleaved.getIndices() == mesh.getIndices(), "same indices");
+			test_eq(interleaved.getMode(), mesh.getMode(), "same mode");
+
+			auto back = interleaved.getMesh();
+			test(back.getVertices() == mesh.getVertices(), "positions round trip");
+			test(back.getNormals() == mesh.getNormals(), "normals round trip");
+			test(back.getColors() == mesh.getColors(), "colors round trip");
+			test(back.getTexCoords() == mesh.getTexCoords(), "tex coords round trip");
+			test(back.getIndices() == mesh.getIndices(), "indices round trip");
+
+			ofInterleavedMesh_<ofVertexPN> positionsNormals(mesh);
+			auto reduced = positionsNormals.getMesh();
+			test(reduced.getNormals() == mesh.getNormals(), "attributes in the format are kept");
+			test(!reduced.hasColors() && !reduced.hasTexCoords(), "attributes missing in the format are dropped");
+
+			ofInterleavedMesh_<Vertex2D> flat(mesh);
+			test_eq(flat.getMesh().getVertices()[1], glm::vec3(glm::vec2(mesh.getVertices()[1]), 0.f), "2d positions drop z");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,169 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// reference implementation testing every triangle in the mesh
+	float bruteForceRay(const ofMesh & mesh, const glm::vec3 & origin, const glm::vec3 & direction){
+		float closest = std::numeric_limits<float>::max();
+		auto & vertices = mesh.getVertices();
+		auto & indices = mesh.getIndices();
+		for(std::size_t i = 0; i + 2 < indices.size(); i += 3){
+			auto & v0 = vertices[indices[i]];
+			auto e1 = vertices[indices[i + 1]] - v0;
+			auto e2 = vertices[indices[i + 2]] - v0;
+			auto p = glm::cross(direction, e2);
+			float det = glm::dot(e1, p);
+			if(det == 0) continue;
+			auto s = origin - v0;
+			float u = glm::dot(s, p) / det;
+			if(u < 0 || u > 1) continue;
+			auto q = glm::cross(s, e1);
+			float v = glm::dot(direction, q) / det;
+			if(v < 0 || u + v > 1) continue;
+			float t = glm::dot(e2, q) / det;
+			if(t >= 0 && t < closest){
+				closest = t;
+			}
+		}
+		return closest;
+	}
+
+	ofMesh randomTriangles(std::size_t numTriangles){
+		ofMesh mesh;
+		for(std::size_t i = 0; i < numTriangles; i++){
+			glm::vec3 center(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+			for(int k = 0; k < 3; k++){
+				mesh.addVertex(center + glm::vec3(ofRandom(-5, 5), ofRandom(-5, 5), ofRandom(-5, 5)));
+			}
+		}
+		mesh.setupIndicesAuto();
+		return mesh;
+	}
+
+	void run(){
+		ofSeedRandom(0);
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ray queries against brute force";
+			auto mesh = randomTriangles(5000);
+			ofMeshBVH bvh(mesh);
+			test_eq(bvh.getNumTriangles(), 5000u, "all triangles are in the tree");
+
+			bool allEqual = true;
+			bool anyHitEqual = true;
+			for(int i = 0; i < 200; i++){
+				glm::vec3 origin(ofRandom(-100, 100), ofRandom(-100, 100), ofRandom(-100, 100));
+				auto direction = glm::normalize(glm::vec3(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1)));
+				auto hit = bvh.intersectRay(origin, direction);
+				auto expected = bruteForceRay(mesh, origin, direction);
+				bool expectedHit = expected < std::numeric_limits<float>::max();
+				allEqual &= hit.hit == expectedHit && (!expectedHit || std::abs(hit.distance - expected) < 0.001);
+				anyHitEqual &= bvh.intersectsRay(origin, direction) == expectedHit;
+			}
+			test(allEqual, "first hit matches brute force");
+			test(anyHitEqual, "any hit matches brute force");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "closest point and overlap queries";
+			auto mesh = ofMesh::plane(100, 100, 11, 11, OF_PRIMITIVE_TRIANGLES);
+			ofMeshBVH bvh(mesh);
+			auto closest = bvh.getClosestPoint({10, 20, 30});
+			test(bool(closest), "closest point found");
+			test_eq(closest.distance, 30.f, "closest point distance to plane");
+			test(glm::distance(closest.position, glm::vec3(10, 20, 0)) < 0.001, "closest point position on plane");
+			test(!bvh.getClosestPoint({10, 20, 30}, 20), "closest point respects max distance");
+
+			auto inSphere = bvh.getTrianglesInSphere({0, 0, 1}, 2);
+			test(!inSphere.empty(), "sphere touching the plane overlaps triangles");
+			test(bvh.getTrianglesInSphere({0, 0, 3}, 2).empty(), "sphere above the plane doesn't overlap");
+			test_eq(bvh.getTrianglesInBox({-60, -60, -1}, {60, 60, 1}).size(), mesh.getNumIndices() / 3, "box containing the plane overlaps all triangles");
+			test(bvh.getTrianglesInBox({-60, -60, 1}, {60, 60, 2}).empty(), "box above the plane doesn't overlap");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "refit";
+			auto mesh = ofMesh::plane(100, 100, 11, 11, OF_PRIMITIVE_TRIANGLES);
+			ofMeshBVH bvh(mesh);
+			for(auto & v: mesh.getVertices()){
+				v.z += 50;
+			}
+			bvh.refit(mesh);
+			auto hit = bvh.intersectRay({0, 0, 100}, {0, 0, -1});
+			test(bool(hit), "ray hits refitted mesh");
+			test_eq(hit.distance, 50.f, "ray hits refitted mesh at the new position");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "axis aligned rays on node boundaries";
+			auto mesh = ofMesh::plane(100, 100, 11, 11, OF_PRIMITIVE_TRIANGLES);
+			ofMeshBVH bvh(mesh);
+			bool allHit = true;
+			bool allAnyHit = true;
+			// rays along -z starting exactly over the vertices of the grid,
+			// which lie on the planes of the boxes of the tree
+			for(auto & v: mesh.getVertices()){
+				glm::vec3 origin(v.x, v.y, 10);
+				auto hit = bvh.intersectRay(origin, {0, 0, -1});
+				allHit &= hit.hit && std::abs(hit.distance - 10.f) < 0.001;
+				allAnyHit &= bvh.intersectsRay(origin, {0, 0, -1});
+			}
+			test(allHit, "rays along grid lines hit the plane");
+			test(allAnyHit, "any hit rays along grid lines hit the plane");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark 1M triangles";
+			auto mesh = ofMesh::plane(1000, 1000, 708, 708, OF_PRIMITIVE_TRIANGLES);
+			for(auto & v: mesh.getVertices()){
+				v.z = sin(v.x * 0.1) * 5;
+			}
+			ofLogNotice() << mesh.getNumIndices() / 3 << " triangles";
+
+			auto then = ofGetElapsedTimeMicros();
+			ofMeshBVH bvh(mesh);
+			auto buildTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "build: " << buildTime / 1000. << "ms";
+
+			then = ofGetElapsedTimeMicros();
+			bvh.refit(mesh);
+			ofLogNotice() << "refit: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+
+			std::size_t numRays = 10000;
+			std::size_t hits = 0;
+			then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < numRays; i++){
+				glm::vec3 origin(ofRandom(-400, 400), ofRandom(-400, 400), 100);
+				hits += bvh.intersectRay(origin, {0, 0, -1}).hit;
+			}
+			auto bvhTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "bvh: " << numRays << " rays in " << bvhTime / 1000. << "ms";
+			test_eq(hits, numRays, "all rays hit the plane");
+
+			std::size_t numBruteForceRays = 10;
+			then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < numBruteForceRays; i++){
+				glm::vec3 origin(ofRandom(-400, 400), ofRandom(-400, 400), 100);
+				bruteForceRay(mesh, origin, {0, 0, -1});
+			}
+			auto bruteForceTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "brute force: " << numBruteForceRays << " rays in " << bruteForceTime / 1000. << "ms";
+			test_lt(bvhTime / double(numRays), bruteForceTime / double(numBruteForceRays), "bvh is faster than brute force");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
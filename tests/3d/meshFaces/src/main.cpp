@@ -0,0 +1,110 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "face views";
+			auto mesh = ofMesh::box(10, 10, 10, 2, 2, 2);
+			auto & faces = mesh.getUniqueFaces();
+			test_eq(mesh.getNumFaces(), faces.size(), "number of faces");
+			test_eq(mesh.getFaceViews().size(), faces.size(), "number of face views");
+
+			bool allEqual = true;
+			for(auto face: mesh.getFaceViews()){
+				auto & unique = faces[face.getId()];
+				for(std::size_t k = 0; k < 3; k++){
+					allEqual &= face.getVertex(k) == unique.getVertex(k);
+					allEqual &= face.getNormal(k) == unique.getNormal(k);
+					allEqual &= face.getTexCoord(k) == unique.getTexCoord(k);
+				}
+				allEqual &= glm::distance(face.getFaceNormal(), unique.getFaceNormal()) < 0.0001;
+			}
+			test(allEqual, "face views match unique faces");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "flatten";
+			auto mesh = ofMesh::sphere(10, 16, OF_PRIMITIVE_TRIANGLES);
+			auto original = mesh;
+			mesh.flatten();
+			test(!mesh.hasIndices(), "flattened mesh is not indexed");
+			test_eq(mesh.getNumVertices(), original.getNumIndices(), "one vertex per face corner");
+			test_eq(mesh.getNumFaces(), original.getNumFaces(), "same number of faces");
+
+			bool allEqual = true;
+			for(std::size_t i = 0; i < mesh.getNumFaces(); i++){
+				auto flat = mesh.getFaceView(i);
+				auto indexed = original.getFaceView(i);
+				for(std::size_t k = 0; k < 3; k++){
+					allEqual &= flat.getVertex(k) == indexed.getVertex(k);
+					allEqual &= flat.getNormal(k) == indexed.getNormal(k);
+					allEqual &= flat.getTexCoord(k) == indexed.getTexCoord(k);
+				}
+			}
+			test(allEqual, "flattened faces keep their attributes");
+
+			mesh = original;
+			mesh.flatten(true);
+			auto face = mesh.getFaceView(10);
+			test_eq(face.getNormal(0), face.getFaceNormal(), "face normals replace vertex normals");
+			test_eq(face.getNormal(2), face.getFaceNormal(), "all corners use the face normal");
+
+			mesh = original;
+			mesh.flatNormals();
+			test_eq(mesh.getNumIndices(), original.getNumIndices(), "flatNormals keeps the mesh indexed");
+			face = mesh.getFaceView(10);
+			test_eq(face.getNormal(0), -face.getFaceNormal(), "flatNormals keeps its normal orientation");
+
+			mesh = ofMesh::box(10, 10, 10, 1, 1, 1);
+			auto flat = mesh;
+			flat.flatNormals();
+			mesh.smoothNormals(10);
+			test_eq(mesh.getNumVertices(), flat.getNumVertices(), "smoothNormals duplicates the vertices of every face");
+			test_eq(mesh.getNumNormals(), mesh.getNumVertices(), "smoothNormals sets a normal per vertex");
+			test(glm::distance(mesh.getNormals()[0], mesh.getFaceView(0).getFaceNormal()) < 0.0001, "sharp edges keep the face normal");
+			test(glm::distance(mesh.getFace(3).getVertex(1), flat.getVertices()[10]) < 0.0001, "getFace reads the face from the mesh");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark 2M triangles";
+			auto mesh = ofMesh::plane(1000, 1000, 1000, 1000, OF_PRIMITIVE_TRIANGLES);
+			ofLogNotice() << mesh.getNumFaces() << " triangles";
+
+			auto then = ofGetElapsedTimeMicros();
+			glm::vec3 normalSum(0);
+			for(auto face: mesh.getFaceViews()){
+				normalSum += face.getFaceNormal();
+			}
+			ofLogNotice() << "face normals with views: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+			test(normalSum.x == 0 && normalSum.y == 0, "all face normals are perpendicular to the plane");
+
+			then = ofGetElapsedTimeMicros();
+			auto & faces = mesh.getUniqueFaces();
+			ofLogNotice() << "getUniqueFaces: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+
+			then = ofGetElapsedTimeMicros();
+			ofMesh fromTriangles;
+			fromTriangles.setFromTriangles(faces, true);
+			ofLogNotice() << "setFromTriangles: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+
+			then = ofGetElapsedTimeMicros();
+			mesh.flatten(true);
+			ofLogNotice() << "flatten: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+			test_eq(mesh.getNumVertices(), fromTriangles.getNumVertices(), "flatten and setFromTriangles produce the same number of vertices");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
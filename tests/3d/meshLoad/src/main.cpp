@@ -0,0 +1,171 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofxAssimpUtils.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// writes a grid of quads with positions, normals and texture
+	// coordinates so faces share vertices
+	void writeGridObj(const std::string & path, int resolution){
+		std::stringstream ss;
+		ss << "# grid " << resolution << "x" << resolution << "\n";
+		for(int y = 0; y <= resolution; y++){
+			for(int x = 0; x <= resolution; x++){
+				ss << "v " << x * 0.5f << " " << y * 0.25f << " " << sin(x * 0.1f) << "\n";
+				ss << "vt " << x / float(resolution) << " " << y / float(resolution) << "\n";
+			}
+		}
+		ss << "vn 0 0 1\n";
+		auto index = [&](int x, int y){
+			return y * (resolution + 1) + x + 1;
+		};
+		for(int y = 0; y < resolution; y++){
+			for(int x = 0; x < resolution; x++){
+				ss << "f";
+				for(auto i: {index(x, y), index(x + 1, y), index(x + 1, y + 1), index(x, y + 1)}){
+					ss << " " << i << "/" << i << "/1";
+				}
+				ss << "\n";
+			}
+		}
+		ofBuffer buffer;
+		buffer.set(ss.str());
+		ofBufferToFile(path, buffer);
+	}
+
+	void writeFile(const std::string & path, const std::string & contents){
+		ofBuffer buffer;
+		buffer.set(contents);
+		ofBufferToFile(path, buffer);
+	}
+
+	void writeStl(const std::string & path, const ofMesh & mesh, bool binary){
+		auto faces = mesh.getUniqueFaces();
+		ofBuffer buffer;
+		if(binary){
+			std::string header(80, ' ');
+			buffer.append(header);
+			uint32_t numFaces = faces.size();
+			buffer.append(reinterpret_cast<const char*>(&numFaces), sizeof(numFaces));
+			for(auto & face: faces){
+				float facet[12];
+				auto normal = face.getFaceNormal();
+				memcpy(facet, &normal, sizeof(normal));
+				for(int i = 0; i < 3; i++){
+					auto v = face.getVertex(i);
+					memcpy(facet + 3 + i * 3, &v, sizeof(v));
+				}
+				buffer.append(reinterpret_cast<const char*>(facet), sizeof(facet));
+				buffer.append(std::string(2, '\0'));
+			}
+		}else{
+			std::stringstream ss;
+			ss << "solid test\n";
+			for(auto & face: faces){
+				auto normal = face.getFaceNormal();
+				ss << "  facet normal " << normal.x << " " << normal.y << " " << normal.z << "\n";
+				ss << "    outer loop\n";
+				for(int i = 0; i < 3; i++){
+					auto v = face.getVertex(i);
+					ss << "      vertex " << v.x << " " << v.y << " " << v.z << "\n";
+				}
+				ss << "    endloop\n";
+				ss << "  endfacet\n";
+			}
+			ss << "endsolid test\n";
+			buffer.set(ss.str());
+		}
+		ofBufferToFile(path, buffer);
+	}
+
+	void benchmark(const std::string & path){
+		auto then = ofGetElapsedTimeMicros();
+		ofMesh mesh;
+		mesh.load(path);
+		auto ofTime = ofGetElapsedTimeMicros() - then;
+
+		// ofxAssimpModelLoader uploads the meshes to vbos which needs a GL
+		// context and would be part of the timing, so use the assimp C api
+		// with the same processing ofMesh::load does: triangulating and
+		// merging shared vertices
+		then = ofGetElapsedTimeMicros();
+		ofMesh assimpMesh;
+		auto scene = aiImportFile(ofToDataPath(path, true).c_str(), aiProcess_Triangulate | aiProcess_JoinIdenticalVertices);
+		if(scene && scene->mNumMeshes > 0){
+			aiMeshToOfMesh(scene->mMeshes[0], assimpMesh);
+		}
+		aiReleaseImport(scene);
+		auto assimpTime = ofGetElapsedTimeMicros() - then;
+
+		ofLogNotice() << ofFilePath::getFileName(path) << ": ofMesh::load " << ofTime / 1000. << "ms, "
+					  << "assimp " << assimpTime / 1000. << "ms";
+		auto numTriangles = [](const ofMesh & mesh){
+			return mesh.hasIndices() ? mesh.getNumIndices() / 3 : mesh.getNumVertices() / 3;
+		};
+		test_eq(numTriangles(mesh), numTriangles(assimpMesh), "same number of triangles as assimp for " + ofFilePath::getFileName(path));
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "obj";
+			writeGridObj("grid.obj", 10);
+			ofMesh mesh;
+			mesh.load("grid.obj");
+			test_eq(mesh.getMode(), OF_PRIMITIVE_TRIANGLES, "obj loads triangles");
+			test_eq(mesh.getNumIndices(), 10u * 10u * 6u, "quads are triangulated");
+			test_eq(mesh.getNumVertices(), 11u * 11u, "shared vertices are merged");
+			test_eq(mesh.getNumNormals(), mesh.getNumVertices(), "one normal per vertex");
+			test_eq(mesh.getNumTexCoords(), mesh.getNumVertices(), "one tex coord per vertex");
+			test(glm::distance(mesh.getVertices()[1], glm::vec3(0.5f, 0.f, sin(0.1f))) < 0.0001, "vertex position");
+			test(glm::distance(mesh.getTexCoords()[1], glm::vec2(0.1f, 0.f)) < 0.0001, "vertex tex coord");
+			test_eq(mesh.getNormals()[1], glm::vec3(0, 0, 1), "vertex normal");
+
+			writeFile("relative.obj", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf -3 -2 -1\n");
+			mesh.load("relative.obj");
+			test_eq(mesh.getNumIndices(), 3u, "negative indices");
+			test_eq(mesh.getIndices()[0], 0u, "negative indices are relative to the last vertex");
+
+			writeFile("wrong.obj", "v 0 0 0\nf 1 2 3\n");
+			mesh.load("wrong.obj");
+			test_eq(mesh.getNumIndices(), 3u, "a wrong file leaves the mesh untouched");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "stl";
+			auto box = ofMesh::box(10, 10, 10, 1, 1, 1);
+			writeStl("box_ascii.stl", box, false);
+			writeStl("box_binary.stl", box, true);
+			ofMesh ascii, binary;
+			ascii.load("box_ascii.stl");
+			binary.load("box_binary.stl");
+			test_eq(ascii.getNumVertices(), 36u, "ascii stl triangles");
+			test_eq(binary.getNumVertices(), 36u, "binary stl triangles");
+			test_eq(binary.getNumNormals(), 36u, "binary stl normals");
+			test_eq(ascii.getVertices()[5], binary.getVertices()[5], "ascii and binary load the same vertices");
+			test_eq(ascii.getNormals()[5], binary.getNormals()[5], "ascii and binary load the same normals");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark against assimp";
+			writeGridObj("big.obj", 700);
+			auto plane = ofMesh::plane(1000, 1000, 500, 500, OF_PRIMITIVE_TRIANGLES);
+			writeStl("big_ascii.stl", plane, false);
+			writeStl("big_binary.stl", plane, true);
+			benchmark("big.obj");
+			benchmark("big_ascii.stl");
+			benchmark("big_binary.stl");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
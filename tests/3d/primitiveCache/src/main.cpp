@@ -0,0 +1,119 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofPrimitiveCache::clear();
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "primitives with the same parameters share the mesh";
+			ofSpherePrimitive sphere1(50, 32);
+			ofSpherePrimitive sphere2(50, 32);
+			ofSpherePrimitive sphere3(60, 32);
+			test(sphere1.isMeshShared(), "sphere mesh is shared");
+			test_eq(&static_cast<const ofSpherePrimitive&>(sphere1).getMesh(),
+					&static_cast<const ofSpherePrimitive&>(sphere2).getMesh(),
+					"same parameters use the same mesh");
+			test(&static_cast<const ofSpherePrimitive&>(sphere1).getMesh() !=
+				 &static_cast<const ofSpherePrimitive&>(sphere3).getMesh(),
+				 "different parameters use different meshes");
+
+			auto stats = ofPrimitiveCache::getStats();
+			test_gt(stats.numHits, 0u, "cache hits are counted");
+			test_gt(stats.bytesSaved, 0u, "memory saved is reported");
+			ofLogNotice() << stats;
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "copy on write";
+			ofBoxPrimitive box1(10, 10, 10, 2, 2, 2);
+			ofBoxPrimitive box2(10, 10, 10, 2, 2, 2);
+			auto numVertices = box2.getMesh().getNumVertices();
+			test(box1.isMeshShared(), "untouched box is still shared");
+			test(!box2.isMeshShared(), "box is copied once modified");
+			box2.getMesh().addVertex({0, 0, 0});
+			test_eq(box1.getMesh().getNumVertices(), numVertices, "modifying a copy doesn't change the shared mesh");
+
+			ofBoxPrimitive box3(10, 10, 10, 2, 2, 2);
+			test_eq(box3.getMesh().getNumVertices(), numVertices, "new primitives get the original mesh");
+
+			auto copy = box3;
+			test(!copy.isMeshShared(), "copying a detached primitive copies the mesh");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "detached meshes stay valid";
+			ofSpherePrimitive sphere(50, 8);
+			ofMesh * mesh = sphere.getMeshPtr();
+			sphere.setResolution(16);
+			ofSpherePrimitive reference(50, 16);
+			test_eq(sphere.getMeshPtr(), mesh, "changing the parameters keeps the same mesh");
+			test_eq(mesh->getNumVertices(), reference.getMesh().getNumVertices(), "the mesh is updated with the new parameters");
+			test(!sphere.isMeshShared(), "a detached mesh isn't shared again");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "texture coordinates";
+			ofPlanePrimitive plane1(100, 100, 4, 4);
+			plane1.mapTexCoords(0, 0, 640, 480);
+			ofPlanePrimitive plane2(100, 100, 4, 4);
+			test(!plane1.isMeshShared(), "mapping tex coords copies the mesh");
+			test(plane2.isMeshShared(), "other planes keep sharing the mesh");
+			test_eq(plane2.getMesh().getTexCoords().back().x, 1.f, "shared mesh keeps normalized tex coords");
+			test_eq(plane1.getMesh().getTexCoords().back().x, 640.f, "copied mesh has the new tex coords");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "unused meshes are released";
+			ofPrimitiveCache::clear();
+			{
+				ofCylinderPrimitive cylinder(10, 20, 12, 6, 2);
+			}
+			ofCylinderPrimitive cylinder(10, 30, 12, 6, 2);
+			test_eq(ofPrimitiveCache::getStats().numMeshes, 1u, "only meshes in use are kept");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "disabled cache";
+			ofPrimitiveCache::setEnabled(false);
+			ofConePrimitive cone1(10, 20, 12, 6, 2);
+			ofConePrimitive cone2(10, 20, 12, 6, 2);
+			test(&static_cast<const ofConePrimitive&>(cone1).getMesh() !=
+				 &static_cast<const ofConePrimitive&>(cone2).getMesh(),
+				 "disabled cache generates a new mesh for every primitive");
+			ofPrimitiveCache::setEnabled(true);
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark 500 spheres";
+			ofPrimitiveCache::clear();
+			auto then = ofGetElapsedTimeMicros();
+			std::vector<ofSpherePrimitive> spheres;
+			for(int i = 0; i < 500; i++){
+				spheres.emplace_back(20, 64);
+			}
+			auto cachedTime = ofGetElapsedTimeMicros() - then;
+			auto stats = ofPrimitiveCache::getStats();
+			ofLogNotice() << "cached: " << cachedTime / 1000. << "ms, " << stats;
+			test_eq(stats.numMisses, 1u, "the sphere mesh is generated only once");
+			test_eq(stats.numMeshes, 1u, "all the spheres share one mesh");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,125 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	struct Counter{
+		std::atomic<uint64_t> calls{0};
+		void listener(const int &){
+			calls++;
+		}
+	};
+
+	// time per notification of an event with numListeners listeners
+	// notified concurrently from numThreads threads
+	void benchmark(std::size_t numListeners, std::size_t numThreads){
+		const std::size_t numNotifications = 100000;
+		ofEvent<const int> event;
+		std::vector<Counter> counters(numListeners);
+		for(auto & counter: counters){
+			ofAddListener(event, &counter, &Counter::listener);
+		}
+
+		auto then = ofGetElapsedTimeMicros();
+		std::vector<std::thread> threads;
+		for(std::size_t i = 0; i < numThreads; i++){
+			threads.emplace_back([&]{
+				for(std::size_t n = 0; n < numNotifications; n++){
+					event.notify(int(n));
+				}
+			});
+		}
+		for(auto & thread: threads){
+			thread.join();
+		}
+		auto time = ofGetElapsedTimeMicros() - then;
+
+		uint64_t calls = 0;
+		for(auto & counter: counters){
+			calls += counter.calls;
+		}
+		ofLogNotice() << numListeners << " listeners, " << numThreads << " threads: "
+					  << time * 1000. / (numNotifications * numThreads) << "ns per notification";
+		test_eq(calls, uint64_t(numListeners * numThreads * numNotifications), ofToString(numListeners) + " listeners notified from " + ofToString(numThreads) + " threads");
+
+		for(auto & counter: counters){
+			ofRemoveListener(event, &counter, &Counter::listener);
+		}
+		test_eq(event.size(), 0u, "all listeners removed");
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "changing listeners while notifying";
+			ofEvent<void> event;
+			int added = 0;
+			int removed = 0;
+			ofEventListener addedListener;
+			ofEventListener removedListener;
+			bool first = true;
+			ofEventListener adder(event.newListener([&]{
+				if(first){
+					addedListener = event.newListener([&]{
+						added++;
+					});
+					removedListener.unsubscribe();
+					first = false;
+				}
+			}, 0));
+			removedListener = event.newListener([&]{
+				removed++;
+			}, 1);
+			event.notify();
+			test_eq(added, 0, "listener added while notifying is called from the next notification");
+			test_eq(removed, 0, "listener removed while notifying is not called anymore");
+			event.notify();
+			test_eq(added, 1, "listener added while notifying is called");
+			test_eq(event.size(), 2u, "removed listener is gone");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "adding and removing from other threads";
+			ofEvent<const int> event;
+			Counter counter;
+			ofAddListener(event, &counter, &Counter::listener);
+			std::atomic<bool> done{false};
+			std::thread changer([&]{
+				std::vector<Counter> others(10);
+				while(!done){
+					for(auto & other: others){
+						ofAddListener(event, &other, &Counter::listener);
+					}
+					for(auto & other: others){
+						ofRemoveListener(event, &other, &Counter::listener);
+					}
+				}
+			});
+			for(int i = 0; i < 100000; i++){
+				event.notify(i);
+			}
+			done = true;
+			changer.join();
+			test_eq(counter.calls.load(), uint64_t(100000), "listener is notified while others change");
+			test_eq(event.size(), 1u, "only the original listener is left");
+		}
+
+		std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+		for(auto numListeners: {1, 10, 100}){
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << numListeners << " listeners";
+			benchmark(numListeners, 1);
+			benchmark(numListeners, numThreads);
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
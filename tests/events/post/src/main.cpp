@@ -0,0 +1,150 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "deferred delivery";
+			ofEventQueue queue;
+			ofEvent<const int> event;
+			std::vector<int> received;
+			std::vector<std::thread::id> threads;
+			ofEventListener listener(event.newListener([&](const int & i){
+				received.push_back(i);
+				threads.push_back(std::this_thread::get_id());
+			}));
+			std::thread poster([&]{
+				for(int i = 0; i < 10; i++){
+					event.post(queue, nullptr, i);
+				}
+			});
+			poster.join();
+			test(received.empty(), "posted events wait for the queue to be flushed");
+			test_eq(queue.size(), 10u, "posted events are queued");
+			test_eq(queue.flush(), 10u, "flush delivers all the posted events");
+			test_eq(received.size(), 10u, "listener received all the posted events");
+			bool inOrder = true;
+			for(int i = 0; i < int(received.size()); i++){
+				inOrder &= received[i] == i;
+			}
+			test(inOrder, "posted events are delivered in order");
+			bool flushingThread = true;
+			for(auto & id: threads){
+				flushingThread &= id == std::this_thread::get_id();
+			}
+			test(flushingThread, "posted events are delivered in the flushing thread");
+			test_eq(queue.flush(), 0u, "flushing an empty queue does nothing");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "latest";
+			ofEventQueue queue;
+			ofEvent<float> progress;
+			ofEvent<void> done;
+			std::vector<std::string> received;
+			ofEventListener progressListener(progress.newListener([&](float & p){
+				received.push_back(ofToString(p));
+			}));
+			ofEventListener doneListener(done.newListener([&]{
+				received.push_back("done");
+			}));
+			progress.post(queue, nullptr, 0.1f, OF_EVENT_POST_LATEST);
+			done.post(queue, nullptr);
+			progress.post(queue, nullptr, 0.5f, OF_EVENT_POST_LATEST);
+			progress.post(queue, nullptr, 1.0f, OF_EVENT_POST_LATEST);
+			test_eq(queue.size(), 2u, "posts of the same event are coalesced");
+			queue.flush();
+			test_eq(received.size(), 2u, "only the latest value is delivered");
+			test_eq(received.front(), ofToString(1.0f), "latest value is delivered");
+			test_eq(received.back(), "done", "coalesced post keeps the position of the first one");
+
+			auto stats = queue.getStats();
+			test_eq(stats.numPosted, 4u, "posts are counted");
+			test_eq(stats.numCoalesced, 2u, "coalesced posts are counted");
+			test_eq(stats.numDelivered, 2u, "delivered notifications are counted");
+			test_eq(stats.maxDepth, 2u, "maximum queue depth is counted");
+			test_eq(stats.depth, 0u, "flushed queue is empty");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "lifetime";
+			ofEventQueue queue;
+			int received = 0;
+			{
+				ofEvent<void> event;
+				ofEventListener listener(event.newListener([&]{
+					received++;
+				}));
+				event.post(queue, nullptr);
+			}
+			queue.flush();
+			test_eq(received, 0, "events destroyed before flushing are not delivered");
+
+			ofEvent<void> event;
+			ofEventListener listener(event.newListener([&]{
+				received++;
+				if(received == 1){
+					event.post(queue, nullptr);
+				}
+			}));
+			event.post(queue, nullptr);
+			test_eq(queue.flush(), 1u, "events posted while flushing are not delivered");
+			test_eq(queue.flush(), 1u, "events posted while flushing are delivered in the next flush");
+			test_eq(received, 2, "listener posting its own event");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "many threads";
+			ofEventQueue queue;
+			ofEvent<const int> event;
+			int sum = 0;
+			ofEventListener listener(event.newListener([&](const int & i){
+				sum += i;
+			}));
+			std::vector<std::thread> posters;
+			for(int t = 0; t < 4; t++){
+				posters.emplace_back([&]{
+					for(int i = 0; i < 1000; i++){
+						event.post(queue, nullptr, 1);
+					}
+				});
+			}
+			std::size_t delivered = 0;
+			while(delivered < 4000){
+				delivered += queue.flush();
+			}
+			for(auto & poster: posters){
+				poster.join();
+			}
+			test_eq(sum, 4000, "all posts from all threads are delivered");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "main queue";
+			ofEvent<const int> event;
+			int received = 0;
+			ofEventListener listener(event.newListener([&](const int & i){
+				received = i;
+			}));
+			event.post(5);
+			test_eq(received, 0, "posting to the main queue waits for the main loop");
+			ofGetMainEventQueue().flush();
+			test_eq(received, 5, "main queue delivers the posted events");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
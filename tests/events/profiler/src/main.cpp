@@ -0,0 +1,70 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void slowListener(int &){
+		ofSleepMillis(2);
+	}
+
+	void fastListener(int &){
+	}
+
+	void run(){
+		ofEventProfiler::reset();
+		ofEvent<int> slow;
+		ofEvent<int> fast;
+		slow.setName("slow");
+		fast.setName("fast");
+		ofAddListener(slow, this, &ofApp::slowListener);
+		ofAddListener(fast, this, &ofApp::fastListener);
+		ofEventListener lambda(fast.newListener([](int &){}));
+
+		auto tracePath = ofToDataPath("trace.json", true);
+		bool tracing = ofEventProfiler::startTrace(tracePath);
+		for(int i = 0; i < 10; i++){
+			slow.notify(i);
+			fast.notify(i);
+		}
+		ofEventProfiler::stopTrace();
+
+		auto stats = ofEventProfiler::getStats();
+		if(!ofEventProfiler::isEnabled()){
+			ofLogNotice() << "built without OF_EVENT_PROFILING";
+			test(stats.empty(), "disabled profiler has no stats");
+			test(!tracing, "disabled profiler doesn't trace");
+			return;
+		}
+
+		ofEventProfiler::dump(std::cout);
+		test_eq(stats.size(), 3u, "every listener is profiled");
+		test_eq(stats.front().event, "slow", "listeners are sorted by total time");
+		test_eq(stats.front().calls, 10u, "calls are counted");
+		test_gt(stats.front().maxTime, 2000000u, "max time is measured in nanoseconds");
+		test(stats.front().totalTime >= stats.front().maxTime * 10 / 2, "total time is accumulated");
+		test(stats.front().listener.find("ofApp") != std::string::npos, "member listeners are named after their class");
+
+		auto byCalls = ofEventProfiler::getStats(ofEventProfiler::Calls);
+		test(byCalls.front().calls >= byCalls.back().calls, "listeners can be sorted by calls");
+
+		test(tracing, "trace started");
+		auto trace = ofLoadJson(tracePath);
+		test_eq(trace.size(), 30u, "every call is traced");
+		test_eq(trace[0]["cat"], "slow", "traced calls have the event name");
+		ofFile::removeFile(tracePath);
+
+		ofRemoveListener(slow, this, &ofApp::slowListener);
+		ofEventProfiler::reset();
+		stats = ofEventProfiler::getStats();
+		test(stats.empty(), "reset sets the counters to 0");
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
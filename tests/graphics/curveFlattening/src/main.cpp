@@ -0,0 +1,102 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	glm::vec3 bezierPoint(const glm::vec3 & p0, const glm::vec3 & p1, const glm::vec3 & p2, const glm::vec3 & p3, float t){
+		float u = 1 - t;
+		return p0 * (u * u * u) + p1 * (3 * u * u * t) + p2 * (3 * u * t * t) + p3 * (t * t * t);
+	}
+
+	// distance from the exact curve to the polyline sampled densely
+	template<class F>
+	float maxDeviation(const ofPolyline & polyline, F curvePoint){
+		float maxDistance = 0;
+		for(int i = 0; i <= 2000; i++){
+			auto p = curvePoint(i / 2000.f);
+			maxDistance = std::max(maxDistance, glm::distance(p, polyline.getClosestPoint(p)));
+		}
+		return maxDistance;
+	}
+
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "polyline";
+			glm::vec3 p0(0, 0, 0), p1(0, 300, 0), p2(400, -200, 0), p3(400, 100, 0);
+			for(float tolerance: {0.1f, 0.5f, 2.f}){
+				ofPolyline polyline;
+				polyline.setCurveTolerance(tolerance);
+				polyline.addVertex(p0);
+				polyline.bezierTo(p1, p2, p3);
+				auto deviation = maxDeviation(polyline, [&](float t){ return bezierPoint(p0, p1, p2, p3, t); });
+				test_lt(deviation, tolerance, "bezier within tolerance " + ofToString(tolerance) + " with " + ofToString(polyline.size()) + " vertices");
+			}
+
+			ofPolyline fixed, adaptive;
+			adaptive.setCurveTolerance(0.5);
+			for(auto polyline: {&fixed, &adaptive}){
+				polyline->addVertex(0, 0);
+				polyline->bezierTo(0, 3, 4, -2, 4, 1);
+			}
+			test_lt(adaptive.size(), fixed.size(), "small curves get less vertices than the fixed resolution");
+
+			ofPolyline quad;
+			quad.setCurveTolerance(0.25);
+			quad.quadBezierTo(glm::vec3(0, 0, 0), glm::vec3(100, 200, 0), glm::vec3(200, 0, 0));
+			auto quadDeviation = maxDeviation(quad, [](float t){
+				return glm::vec3(0, 0, 0) * ((1 - t) * (1 - t)) + glm::vec3(100, 200, 0) * (2 * t * (1 - t)) + glm::vec3(200, 0, 0) * (t * t);
+			});
+			test_lt(quadDeviation, 0.25f, "quadratic bezier within tolerance");
+
+			ofPolyline small, big;
+			small.setCurveTolerance(0.5);
+			big.setCurveTolerance(0.5);
+			small.arc(glm::vec3(0, 0, 0), 10, 10, 0, 360);
+			big.arc(glm::vec3(0, 0, 0), 1000, 1000, 0, 360);
+			test_lt(small.size(), big.size(), "bigger arcs get more vertices");
+			auto arcDeviation = maxDeviation(big, [](float t){
+				return glm::vec3(cos(t * TWO_PI) * 1000, sin(t * TWO_PI) * 1000, 0);
+			});
+			test_lt(arcDeviation, 0.5f, "arc within tolerance");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "path";
+			ofPath path;
+			path.setCurveTolerance(0.5);
+			path.circle(0, 0, 100);
+			path.setCurveScale(1);
+			auto vertices = path.getOutline()[0].size();
+			path.setCurveScale(1.1);
+			test_eq(path.getOutline()[0].size(), vertices, "small scale changes don't regenerate the polylines");
+			test_eq(path.getCurveScale(), 1.f, "small scale changes keep the curve scale");
+			path.setCurveScale(4);
+			test_gt(path.getOutline()[0].size(), vertices, "zooming in adds vertices");
+			path.setCurveScale(1);
+			test_eq(path.getOutline()[0].size(), vertices, "zooming out removes them again");
+
+			ofPath fixed;
+			fixed.circle(0, 0, 100);
+			path.setCurveTolerance(0);
+			test_eq(path.getOutline()[0].size(), fixed.getOutline()[0].size(), "0 tolerance goes back to the circle resolution");
+
+			ofPath polylines;
+			polylines.setMode(ofPath::POLYLINES);
+			polylines.setCurveTolerance(0.5);
+			polylines.moveTo(0, 0);
+			polylines.setCurveScale(4);
+			test_eq(polylines.getOutline()[0].getCurveTolerance(), 0.125f, "the curve scale updates the polylines in polylines mode");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,159 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// holes have a negative area so the sum is the filled area
+	float getArea(const std::vector<ofPolyline> & contours){
+		float area = 0;
+		for(auto & contour: contours){
+			area += contour.getArea();
+		}
+		return area;
+	}
+
+	bool areClose(float a, float b, float tolerance = 0.01f){
+		return std::abs(a - b) < tolerance;
+	}
+
+	void run(){
+		ofTessellator tessellator;
+		std::vector<ofPolyline> result;
+		std::vector<ofPolyline> a{ofPolyline::fromRectangle({0, 0, 10, 10})};
+		std::vector<ofPolyline> b{ofPolyline::fromRectangle({5, 5, 10, 10})};
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "boolean operations";
+			tessellator.clipToPolylines(a, OF_POLY_WINDING_ODD, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_UNION, result);
+			test_eq(result.size(), 1u, "union of overlapping squares is one contour");
+			test(areClose(getArea(result), 175), "union area");
+			test(result.size() == 1 && result[0].isClosed(), "result contours are closed");
+
+			tessellator.clipToPolylines(a, OF_POLY_WINDING_ODD, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_INTERSECTION, result);
+			test(areClose(getArea(result), 25), "intersection area");
+
+			tessellator.clipToPolylines(a, OF_POLY_WINDING_ODD, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_DIFFERENCE, result);
+			test(areClose(getArea(result), 75), "difference area");
+
+			tessellator.clipToPolylines(b, OF_POLY_WINDING_ODD, a, OF_POLY_WINDING_ODD, OF_POLY_CLIP_DIFFERENCE, result);
+			test(areClose(getArea(result), 75), "difference in the other order");
+
+			tessellator.clipToPolylines(a, OF_POLY_WINDING_ODD, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_XOR, result);
+			test_eq(result.size(), 2u, "xor of overlapping squares");
+			test(areClose(getArea(result), 150), "xor area");
+
+			std::vector<ofPolyline> big{ofPolyline::fromRectangle({-10, -10, 40, 40})};
+			tessellator.clipToPolylines(a, OF_POLY_WINDING_ODD, big, OF_POLY_WINDING_ODD, OF_POLY_CLIP_DIFFERENCE, result);
+			test(result.empty(), "subtracting a bigger shape leaves nothing");
+			tessellator.clipToPolylines(big, OF_POLY_WINDING_ODD, a, OF_POLY_WINDING_ODD, OF_POLY_CLIP_DIFFERENCE, result);
+			test_eq(result.size(), 2u, "subtracting a smaller shape leaves a hole");
+			test(areClose(getArea(result), 1500), "area with a hole");
+
+			// the same square twice is a hole with the odd winding mode
+			std::vector<ofPolyline> twice{a[0], a[0]};
+			tessellator.clipToPolylines(twice, OF_POLY_WINDING_ODD, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_UNION, result);
+			test(areClose(getArea(result), 100), "inputs use their own winding mode");
+			tessellator.clipToPolylines(twice, OF_POLY_WINDING_NONZERO, b, OF_POLY_WINDING_ODD, OF_POLY_CLIP_UNION, result);
+			test(areClose(getArea(result), 175), "inputs use their own winding mode");
+
+			ofPolyline bowtie;
+			bowtie.addVertex(0, 0);
+			bowtie.addVertex(10, 10);
+			bowtie.addVertex(10, 0);
+			bowtie.addVertex(0, 10);
+			bowtie.close();
+			tessellator.clipToPolylines({bowtie}, OF_POLY_WINDING_ODD, {}, OF_POLY_WINDING_ODD, OF_POLY_CLIP_UNION, result);
+			test_eq(result.size(), 2u, "self intersecting contour is split");
+			test(areClose(getArea(result), 50), "self intersecting contour area");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "offset";
+			tessellator.offsetToPolylines(a, OF_POLY_WINDING_ODD, 1, result, OF_LINE_JOIN_MITER);
+			test(areClose(getArea(result), 144), "miter outset");
+			tessellator.offsetToPolylines(a, OF_POLY_WINDING_ODD, 1, result, OF_LINE_JOIN_BEVEL);
+			test(areClose(getArea(result), 142), "bevel outset");
+			tessellator.offsetToPolylines(a, OF_POLY_WINDING_ODD, 1, result, OF_LINE_JOIN_ROUND, 4, 0.01f);
+			test(areClose(getArea(result), 140 + PI, 0.1f), "round outset");
+			tessellator.offsetToPolylines(a, OF_POLY_WINDING_ODD, -1, result);
+			test(areClose(getArea(result), 64), "inset");
+			tessellator.offsetToPolylines(a, OF_POLY_WINDING_ODD, -6, result);
+			test(result.empty(), "inset bigger than the shape leaves nothing");
+
+			ofPolyline l;
+			l.addVertex(0, 0);
+			l.addVertex(10, 0);
+			l.addVertex(10, 4);
+			l.addVertex(4, 4);
+			l.addVertex(4, 10);
+			l.addVertex(0, 10);
+			l.close();
+			tessellator.offsetToPolylines({l}, OF_POLY_WINDING_ODD, 1, result, OF_LINE_JOIN_MITER);
+			test_eq(result.size(), 1u, "outset of a concave shape");
+			test(areClose(getArea(result), 12 * 6 + 6 * 6), "outset of a concave shape area");
+
+			std::vector<ofPolyline> withHole{ofPolyline::fromRectangle({0, 0, 20, 20}), ofPolyline::fromRectangle({5, 5, 10, 10})};
+			tessellator.offsetToPolylines(withHole, OF_POLY_WINDING_ODD, 1, result);
+			test(areClose(getArea(result), 22 * 22 - 8 * 8), "holes shrink when the shape grows");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ofPath";
+			ofPath path;
+			path.rectangle(0, 0, 10, 10);
+			ofPath other;
+			other.rectangle(5, 5, 10, 10);
+			path.clip(other, OF_POLY_CLIP_UNION);
+			test_eq(path.getMode(), ofPath::POLYLINES, "clipped path uses polylines");
+			test_eq(path.getWindingMode(), OF_POLY_WINDING_ODD, "clipped path uses the odd winding mode");
+			test(areClose(getArea(path.getOutline()), 175), "path union area");
+			test_gt(path.getTessellation().getNumIndices(), 0u, "clipped path is tessellated");
+
+			path.offset(-1);
+			test(areClose(getArea(path.getOutline()), 8 * 8 + 8 * 8 - 3 * 3), "path inset area");
+
+			ofPath empty;
+			empty.rectangle(0, 0, 1, 1);
+			empty.clip(other, OF_POLY_CLIP_INTERSECTION);
+			test(areClose(getArea(empty.getOutline()), 0), "disjoint intersection is empty");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark";
+			auto contour = [](std::size_t numVertices, float cx){
+				ofPolyline polyline;
+				for(std::size_t i = 0; i < numVertices; i++){
+					float angle = i * TWO_PI / numVertices;
+					float radius = ofRandom(70, 130);
+					polyline.addVertex(cx + cos(angle) * radius, sin(angle) * radius);
+				}
+				polyline.close();
+				return std::vector<ofPolyline>{polyline};
+			};
+			ofSeedRandom(0);
+			auto first = contour(20000, 0);
+			auto second = contour(20000, 50);
+			auto then = ofGetElapsedTimeMicros();
+			tessellator.clipToPolylines(first, OF_POLY_WINDING_ODD, second, OF_POLY_WINDING_ODD, OF_POLY_CLIP_UNION, result);
+			ofLogNotice() << "union of 2 x 20000 vertices: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+			test(!result.empty(), "union of big contours");
+			then = ofGetElapsedTimeMicros();
+			tessellator.offsetToPolylines(first, OF_POLY_WINDING_ODD, 5, result, OF_LINE_JOIN_ROUND);
+			ofLogNotice() << "offset of 20000 vertices: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+			test(!result.empty(), "offset of a big contour");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,163 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// noisy contour going around the origin a number of times so the
+	// winding number can be bigger than 1
+	ofPolyline randomContour(std::size_t numVertices, int turns){
+		ofPolyline polyline;
+		for(std::size_t i = 0; i < numVertices; i++){
+			float angle = i * TWO_PI * turns / numVertices;
+			float radius = ofRandom(70, 130);
+			polyline.addVertex(cos(angle) * radius, sin(angle) * radius);
+		}
+		polyline.close();
+		return polyline;
+	}
+
+	std::vector<glm::vec3> randomPoints(std::size_t numPoints){
+		std::vector<glm::vec3> points;
+		for(std::size_t i = 0; i < numPoints; i++){
+			points.emplace_back(ofRandom(-150, 150), ofRandom(-150, 150), 0);
+		}
+		return points;
+	}
+
+	void run(){
+		ofSeedRandom(0);
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "queries against linear search";
+			auto linear = randomContour(5000, 3);
+			auto indexed = linear;
+			indexed.setUseSpatialIndex(true);
+			test(indexed.isUsingSpatialIndex(), "spatial index enabled");
+			test_eq(indexed.getSpatialIndex().getNumSegments(), 5000u, "closed polyline has a segment per vertex");
+
+			bool closestEqual = true;
+			bool nearestEqual = true;
+			bool insideEqual = true;
+			bool windingEqual = true;
+			for(auto & p: randomPoints(500)){
+				unsigned int linearIndex, indexedIndex;
+				auto expected = linear.getClosestPoint(p, &linearIndex);
+				auto closest = indexed.getClosestPoint(p, &indexedIndex);
+				closestEqual &= std::abs(glm::distance(p, closest) - glm::distance(p, expected)) < 0.001;
+				nearestEqual &= linearIndex == indexedIndex;
+				insideEqual &= linear.inside(p) == indexed.inside(p);
+				windingEqual &= linear.getWindingNumber(p) == indexed.getWindingNumber(p);
+			}
+			test(closestEqual, "closest point matches linear search");
+			test(nearestEqual, "nearest index matches linear search");
+			test(insideEqual, "inside matches linear search");
+			test(windingEqual, "winding number matches linear search");
+
+			auto center = glm::vec3(0, 0, 0);
+			test_eq(indexed.getWindingNumber(center), 3, "contour winds 3 times around its center");
+			test(indexed.inside(center, OF_POLY_WINDING_ODD), "odd winding rule");
+			test(indexed.inside(center, OF_POLY_WINDING_ABS_GEQ_TWO), "abs geq two winding rule");
+			test(!indexed.inside(center, OF_POLY_WINDING_NEGATIVE), "negative winding rule");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "batch queries";
+			auto polyline = randomContour(5000, 1);
+			polyline.setUseSpatialIndex(true);
+			auto points = randomPoints(10000);
+			std::vector<unsigned int> nearestIndices;
+			auto closest = polyline.getClosestPoints(points, &nearestIndices);
+			auto inside = polyline.inside(points);
+			test_eq(closest.size(), points.size(), "one closest point per query");
+			test_eq(inside.size(), points.size(), "one inside result per query");
+
+			bool closestEqual = true;
+			bool insideEqual = true;
+			for(std::size_t i = 0; i < points.size(); i++){
+				unsigned int nearest;
+				closestEqual &= polyline.getClosestPoint(points[i], &nearest) == closest[i] && nearest == nearestIndices[i];
+				insideEqual &= polyline.inside(points[i]) == inside[i];
+			}
+			test(closestEqual, "batch closest points match single queries");
+			test(insideEqual, "batch inside matches single queries");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "intersections";
+			auto square = ofPolyline::fromRectangle({0, 0, 100, 100});
+			auto intersections = square.getIntersections({-50, 50, 0}, {150, 50, 0});
+			test_eq(intersections.size(), 2u, "line crosses the square twice");
+			if(intersections.size() == 2){
+				test_eq(intersections[0].position, glm::vec3(0, 50, 0), "first crossing position");
+				test_eq(intersections[0].index, 3.5f, "first crossing index");
+				test_eq(intersections[1].position, glm::vec3(100, 50, 0), "second crossing position");
+				test_lt(intersections[0].t, intersections[1].t, "crossings are sorted along the line");
+			}
+			test_eq(square.getIntersections({-50, -50, 0}, {50, 50, 0}).size(), 1u, "crossing through a vertex is reported once");
+			test(square.getIntersections({10, 10, 0}, {90, 90, 0}).empty(), "line inside the square doesn't cross it");
+
+			square.setClosed(false);
+			test_eq(square.getIntersections({-50, 50, 0}, {150, 50, 0}).size(), 1u, "open polyline has no closing segment");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "invalidation";
+			auto square = ofPolyline::fromRectangle({0, 0, 100, 100});
+			square.setUseSpatialIndex(true);
+			test(square.inside(glm::vec3(50, 50, 0)), "point inside before moving the square");
+			square.translate(glm::vec3(200, 0, 0));
+			test(!square.inside(glm::vec3(50, 50, 0)), "index is rebuilt after translate");
+			square[0] = glm::vec3(0, 0, 0);
+			test_eq(square.getClosestPoint(glm::vec3(-10, 0, 0)), glm::vec3(0, 0, 0), "index is rebuilt after changing a vertex");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark 20k vertices";
+			auto linear = randomContour(20000, 1);
+			auto indexed = linear;
+			indexed.setUseSpatialIndex(true);
+			auto points = randomPoints(5000);
+
+			auto then = ofGetElapsedTimeMicros();
+			indexed.getSpatialIndex();
+			ofLogNotice() << "build: " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+
+			then = ofGetElapsedTimeMicros();
+			for(auto & p: points){
+				indexed.getClosestPoint(p);
+				indexed.inside(p);
+			}
+			auto indexedTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "indexed: " << points.size() << " queries in " << indexedTime / 1000. << "ms";
+
+			then = ofGetElapsedTimeMicros();
+			indexed.getClosestPoints(points);
+			indexed.inside(points);
+			ofLogNotice() << "batch: " << points.size() << " queries in " << (ofGetElapsedTimeMicros() - then) / 1000. << "ms";
+
+			std::size_t numLinearQueries = 50;
+			then = ofGetElapsedTimeMicros();
+			for(std::size_t i = 0; i < numLinearQueries; i++){
+				linear.getClosestPoint(points[i]);
+				linear.inside(points[i]);
+			}
+			auto linearTime = ofGetElapsedTimeMicros() - then;
+			ofLogNotice() << "linear: " << numLinearQueries << " queries in " << linearTime / 1000. << "ms";
+			test_lt(indexedTime / double(points.size()), linearTime / double(numLinearQueries), "index is faster than linear search");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,142 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// area covered by the triangles of a strip, degenerate triangles
+	// between strips don't add anything
+	float stripArea(const ofMesh & mesh){
+		auto & v = mesh.getVertices();
+		float area = 0;
+		for(std::size_t i = 2; i < v.size(); i++){
+			auto a = v[i-2], b = v[i-1], c = v[i];
+			area += std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5f;
+		}
+		return area;
+	}
+
+	void run(){
+		ofStroker stroker;
+		ofMesh mesh;
+		ofStrokeStyle style;
+		style.width = 10;
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "caps";
+			ofPolyline line;
+			line.addVertex(0, 0);
+			line.addVertex(100, 0);
+
+			stroker.strokeToMesh(line, style, mesh);
+			test_eq(mesh.getMode(), OF_PRIMITIVE_TRIANGLE_STRIP, "stroke is a triangle strip");
+			test_eq(mesh.getNumVertices(), 4u, "butt caps");
+			test_eq(mesh.getNumTexCoords(), mesh.getNumVertices(), "one texcoord per vertex");
+			test_eq(stripArea(mesh), 1000.f, "butt caps area");
+
+			style.cap = OF_LINE_CAP_SQUARE;
+			stroker.strokeToMesh(line, style, mesh);
+			test_eq(mesh.getNumVertices(), 8u, "square caps");
+			test_eq(stripArea(mesh), 1100.f, "square caps extend half the width");
+
+			style.cap = OF_LINE_CAP_ROUND;
+			stroker.strokeToMesh(line, style, mesh);
+			test_gt(mesh.getNumVertices(), 8u, "round caps");
+			test_lt(std::abs(stripArea(mesh) - (1000.f + PI * 25.f)), 5.f, "round caps area");
+			style.cap = OF_LINE_CAP_BUTT;
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "joins";
+			ofPolyline corner;
+			corner.addVertex(0, 0);
+			corner.addVertex(100, 0);
+			corner.addVertex(100, 100);
+
+			stroker.strokeToMesh(corner, style, mesh);
+			test_eq(mesh.getNumVertices(), 6u, "miter join");
+			test_eq(stripArea(mesh), 2000.f, "miter join area");
+
+			style.join = OF_LINE_JOIN_BEVEL;
+			stroker.strokeToMesh(corner, style, mesh);
+			test_eq(mesh.getNumVertices(), 8u, "bevel join");
+			test_eq(stripArea(mesh), 1987.5f, "bevel join area");
+
+			style.join = OF_LINE_JOIN_ROUND;
+			stroker.strokeToMesh(corner, style, mesh);
+			test_gt(mesh.getNumVertices(), 8u, "round join");
+			test_lt(std::abs(stripArea(mesh) - (1975.f + PI * 25.f / 4.f)), 2.f, "round join area");
+
+			ofPolyline sharp;
+			sharp.addVertex(0, 0);
+			sharp.addVertex(100, 0);
+			sharp.addVertex(0, 20);
+			style.join = OF_LINE_JOIN_MITER;
+			stroker.strokeToMesh(sharp, style, mesh);
+			test_eq(mesh.getNumVertices(), 8u, "sharp corner over the miter limit is beveled");
+			style.miterLimit = 20;
+			stroker.strokeToMesh(sharp, style, mesh);
+			test_eq(mesh.getNumVertices(), 6u, "sharp corner under the miter limit is mitered");
+			style.miterLimit = 4;
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "closed polylines";
+			auto square = ofPolyline::fromRectangle({0, 0, 100, 100});
+			stroker.strokeToMesh(square, style, mesh);
+			test_eq(stripArea(mesh), 110.f * 110.f - 90.f * 90.f, "closed stroke area");
+			test_eq(mesh.getTexCoords().back().x, 400.f, "texcoord x is the distance along the line");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "dashes";
+			ofPolyline line;
+			line.addVertex(0, 0);
+			line.addVertex(100, 0);
+			style.dashes = {10, 10};
+			stroker.strokeToMesh(line, style, mesh);
+			// 5 dashes of 4 vertices joined by 2 degenerate vertices
+			test_eq(mesh.getNumVertices(), 28u, "dashes are joined with degenerate triangles");
+			test_lt(std::abs(stripArea(mesh) - 500.f), 0.01f, "dashes cover half the line");
+			test_eq(mesh.getTexCoords()[2].x, 10.f, "dash texcoords keep the distance along the line");
+
+			style.dashes = {10};
+			style.dashOffset = 5;
+			stroker.strokeToMesh(line, style, mesh);
+			test_eq(mesh.getNumVertices(), 34u, "odd dash patterns are repeated and offset");
+			test_lt(std::abs(stripArea(mesh) - 500.f), 0.01f, "offset dashes cover half the line");
+			style.dashes.clear();
+			style.dashOffset = 0;
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ofPath stroke";
+			ofPath path;
+			path.rectangle(0, 0, 100, 100);
+			test(path.getStrokeMesh().getVertices().empty(), "no stroke without stroke width");
+			path.setStrokeWidth(10);
+			test_eq(stripArea(path.getStrokeMesh()), 110.f * 110.f - 90.f * 90.f, "path stroke area");
+			auto numVertices = path.getStrokeMesh().getNumVertices();
+			path.setStrokeStyle(style);
+			auto strokeStyle = path.getStrokeStyle();
+			strokeStyle.join = OF_LINE_JOIN_ROUND;
+			path.setStrokeStyle(strokeStyle);
+			test_gt(path.getStrokeMesh().getNumVertices(), numVertices, "stroke is regenerated when the style changes");
+			path.translate(glm::vec2(100, 0));
+			test_gt(path.getStrokeMesh().getVertices()[0].x, 90.f, "stroke is regenerated when the shape changes");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
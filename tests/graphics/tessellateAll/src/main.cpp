@@ -0,0 +1,85 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	std::vector<ofPath> randomPaths(std::size_t numPaths){
+		std::vector<ofPath> paths(numPaths);
+		for(auto & path: paths){
+			glm::vec2 center(ofRandom(1000), ofRandom(1000));
+			path.moveTo(center.x, center.y);
+			for(int i = 0; i < 10; i++){
+				path.bezierTo(center.x + ofRandom(-50, 50), center.y + ofRandom(-50, 50),
+							  center.x + ofRandom(-50, 50), center.y + ofRandom(-50, 50),
+							  center.x + ofRandom(-50, 50), center.y + ofRandom(-50, 50));
+			}
+			path.close();
+			path.circle(center.x, center.y, ofRandom(5, 20));
+		}
+		return paths;
+	}
+
+	void run(){
+		// without the cache the serial pass would get the meshes the
+		// parallel one just cached instead of tessellating them again
+		ofTessellationCache::setEnabled(false);
+		ofSeedRandom(0);
+		auto paths = randomPaths(5000);
+		auto serial = paths;
+
+		std::size_t numCalls = 0;
+		std::size_t lastDone = 0;
+		bool increasing = true;
+		auto threadId = std::this_thread::get_id();
+		bool sameThread = true;
+		auto then = ofGetElapsedTimeMicros();
+		ofTessellateAll(paths, [&](std::size_t done, std::size_t total){
+			numCalls++;
+			increasing &= done > lastDone && total == paths.size();
+			sameThread &= std::this_thread::get_id() == threadId;
+			lastDone = done;
+		});
+		auto parallelTime = ofGetElapsedTimeMicros() - then;
+
+		test_gt(numCalls, 0u, "progress is reported");
+		test(increasing, "progress increases");
+		test_eq(lastDone, paths.size(), "progress ends with all the paths");
+		test(sameThread, "progress is reported from the calling thread");
+
+		then = ofGetElapsedTimeMicros();
+		for(auto & path: serial){
+			path.tessellate();
+		}
+		auto serialTime = ofGetElapsedTimeMicros() - then;
+		ofLogNotice() << "parallel: " << parallelTime / 1000. << "ms, serial: " << serialTime / 1000. << "ms";
+
+		bool equal = true;
+		for(std::size_t i = 0; i < paths.size(); i++){
+			auto & mesh = paths[i].getTessellation();
+			auto & expected = serial[i].getTessellation();
+			equal &= mesh.getVertices() == expected.getVertices() && mesh.getIndices() == expected.getIndices();
+		}
+		test(equal, "same tessellation as tessellating one by one");
+
+		std::vector<ofPath*> pointers{&paths[0], nullptr, &paths[1]};
+		paths[0].translate(glm::vec2(10, 0));
+		ofTessellateAll(pointers);
+		test(paths[0].getTessellation().getVertices() != serial[0].getTessellation().getVertices(), "changed paths are tessellated again");
+
+		std::vector<ofPath> empty;
+		ofTessellateAll(empty, [&](std::size_t, std::size_t){
+			test(false, "no progress for no paths");
+		});
+
+		ofTessellationCache::setEnabled(true);
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
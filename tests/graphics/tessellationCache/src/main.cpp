@@ -0,0 +1,118 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	ofPath flower(float x, float y, int petals){
+		ofPath path;
+		path.moveTo(x, y);
+		for(int i = 0; i < petals; i++){
+			float angle = i * TWO_PI / petals;
+			float next = (i + 1) * TWO_PI / petals;
+			path.bezierTo(x + cos(angle) * 100, y + sin(angle) * 100,
+						  x + cos(next) * 100, y + sin(next) * 100,
+						  x, y);
+		}
+		path.close();
+		path.circle(x, y, 20);
+		return path;
+	}
+
+	void run(){
+		ofTessellationCache::clear();
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "sharing";
+			auto a = flower(100, 100, 12);
+			auto b = flower(100, 100, 12);
+			auto & meshA = a.getTessellation();
+			auto & meshB = b.getTessellation();
+			test_eq(&meshA, &meshB, "identical paths share their tessellation");
+			auto stats = ofTessellationCache::getStats();
+			test_eq(stats.numMisses, 1u, "first path tessellates");
+			test_eq(stats.numHits, 1u, "second path comes from the cache");
+			test_gt(stats.bytesUsed, 0u, "cache memory is counted");
+
+			b.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
+			test(&b.getTessellation() != &meshA, "different winding mode is a different mesh");
+
+			auto c = flower(100, 100, 12);
+			c.setCurveResolution(40);
+			test(&c.getTessellation() != &meshA, "different curve resolution is a different mesh");
+
+			auto d = flower(100, 100, 12);
+			d.translate(glm::vec2(10, 0));
+			test(&d.getTessellation() != &meshA, "changed paths get a new mesh");
+			test_eq(meshA.getNumVertices(), a.getTessellation().getNumVertices(), "shared meshes aren't modified");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "eviction";
+			ofTessellationCache::clear();
+			auto first = flower(0, 0, 12);
+			first.getTessellation();
+			auto bytes = ofTessellationCache::getStats().bytesUsed;
+			auto budget = ofTessellationCache::getByteBudget();
+			ofTessellationCache::setByteBudget(bytes * 3);
+			for(int i = 1; i < 10; i++){
+				flower(i, 0, 12).getTessellation();
+			}
+			auto stats = ofTessellationCache::getStats();
+			test(stats.bytesUsed <= bytes * 3, "cache stays under the budget");
+			test_gt(stats.numEvictions, 0u, "least recently used meshes are evicted");
+			test(first.getTessellation().getNumVertices() > 0, "evicted meshes stay alive while in use");
+			flower(9, 0, 12).getTessellation();
+			test_eq(ofTessellationCache::getStats().numHits, stats.numHits + 1, "recently used mesh is still cached");
+			flower(0, 0, 12).getTessellation();
+			test_eq(ofTessellationCache::getStats().numMisses, stats.numMisses + 1, "least recently used mesh was evicted");
+			ofTessellationCache::setByteBudget(budget);
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "disabled";
+			ofTessellationCache::clear();
+			ofTessellationCache::setEnabled(false);
+			auto a = flower(100, 100, 12);
+			auto b = flower(100, 100, 12);
+			test(&a.getTessellation() != &b.getTessellation(), "disabled cache doesn't share");
+			test_eq(a.getTessellation().getNumIndices(), b.getTessellation().getNumIndices(), "disabled cache tessellates the same");
+			test_eq(ofTessellationCache::getStats().numMisses, 0u, "disabled cache isn't used");
+			ofTessellationCache::setEnabled(true);
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "benchmark";
+			ofTessellationCache::clear();
+			auto then = ofGetElapsedTimeMicros();
+			for(int frame = 0; frame < 1000; frame++){
+				flower(100, 100, 40).getTessellation();
+			}
+			auto cachedTime = ofGetElapsedTimeMicros() - then;
+
+			ofTessellationCache::setEnabled(false);
+			then = ofGetElapsedTimeMicros();
+			for(int frame = 0; frame < 1000; frame++){
+				flower(100, 100, 40).getTessellation();
+			}
+			auto uncachedTime = ofGetElapsedTimeMicros() - then;
+			ofTessellationCache::setEnabled(true);
+
+			ofLogNotice() << "rebuilding a path 1000 times, cached: " << cachedTime / 1000. << "ms, uncached: " << uncachedTime / 1000. << "ms";
+			ofLogNotice() << ofTessellationCache::getStats();
+			test_lt(cachedTime, uncachedTime, "cached paths are faster to rebuild");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,127 @@
+#include "ofMain.h"
+#include "ofxUnitTests.h"
+#include "ofAppNoWindow.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// glyph like outline: a curved contour with a hole
+	std::vector<ofPolyline> glyph(float x, float y, float size){
+		ofPath path;
+		path.setCurveResolution(8);
+		path.moveTo(x, y);
+		path.bezierTo(x + size, y - size * 0.2f, x + size * 1.2f, y + size, x + size * 0.5f, y + size * 1.1f);
+		path.bezierTo(x - size * 0.2f, y + size * 1.2f, x - size * 0.3f, y + size * 0.3f, x, y);
+		path.close();
+		path.circle(x + size * 0.45f, y + size * 0.5f, size * 0.2f);
+		return path.getOutline();
+	}
+
+	// svg like shape: a star with many points
+	std::vector<ofPolyline> star(float x, float y, float size, int points){
+		ofPolyline polyline;
+		for(int i = 0; i < points * 2; i++){
+			float angle = i * PI / points;
+			float radius = i % 2 ? size * 0.4f : size;
+			polyline.addVertex(x + cos(angle) * radius, y + sin(angle) * radius);
+		}
+		polyline.close();
+		return {polyline};
+	}
+
+	// the previous allocation strategy, libtess2 allocating every node with
+	// malloc
+	void tessellateWithMalloc(TESStesselator * tess, const std::vector<ofPolyline> & contours, ofMesh & mesh){
+		for(auto & contour: contours){
+			tessAddContour(tess, 3, &contour.getVertices()[0].x, sizeof(glm::vec3), contour.size());
+		}
+		tessTesselate(tess, TESS_WINDING_ODD, TESS_POLYGONS, 3, 3, 0);
+		mesh.clear();
+		mesh.addVertices((glm::vec3*)tessGetVertices(tess), tessGetVertexCount(tess));
+		mesh.addIndices((ofIndexType*)tessGetElements(tess), tessGetElementCount(tess) * 3);
+	}
+
+	void benchmark(const std::string & name, const std::vector<std::vector<ofPolyline>> & shapes){
+		ofLogNotice() << "---------------------------------------";
+		ofLogNotice() << name;
+		ofTessellator tessellator;
+		auto tess = tessNewTess(nullptr);
+		ofMesh arenaMesh, mallocMesh;
+
+		bool equal = true;
+		for(auto & shape: shapes){
+			tessellator.tessellateToMesh(shape, OF_POLY_WINDING_ODD, arenaMesh);
+			tessellateWithMalloc(tess, shape, mallocMesh);
+			equal &= arenaMesh.getVertices() == mallocMesh.getVertices() && arenaMesh.getIndices() == mallocMesh.getIndices();
+		}
+		test(equal, name + " same tessellation with the arena");
+
+		tessellator.resetAllocationStats();
+		auto then = ofGetElapsedTimeMicros();
+		for(auto & shape: shapes){
+			tessellator.tessellateToMesh(shape, OF_POLY_WINDING_ODD, arenaMesh);
+		}
+		auto arenaTime = ofGetElapsedTimeMicros() - then;
+
+		then = ofGetElapsedTimeMicros();
+		for(auto & shape: shapes){
+			tessellateWithMalloc(tess, shape, mallocMesh);
+		}
+		auto mallocTime = ofGetElapsedTimeMicros() - then;
+		tessDeleteTess(tess);
+
+		auto stats = tessellator.getAllocationStats();
+		ofLogNotice() << "arena: " << arenaTime / 1000. << "ms, malloc: " << mallocTime / 1000. << "ms";
+		ofLogNotice() << stats.allocations << " allocations, " << stats.blocks << " blocks, peak " << stats.peakBytes << " bytes";
+		test_eq(stats.tessellations, shapes.size(), name + " tessellations are counted");
+		test_gt(stats.allocations, 0u, name + " allocations are counted");
+		test_gt(stats.peakBytes, 0u, name + " peak bytes are counted");
+		test_lt(stats.blocks, 4u, name + " the arena is reused between tessellations");
+	}
+
+	void run(){
+		ofSeedRandom(0);
+
+		std::vector<std::vector<ofPolyline>> glyphs;
+		for(int i = 0; i < 5000; i++){
+			glyphs.push_back(glyph(ofRandom(1000), ofRandom(1000), ofRandom(8, 40)));
+		}
+		benchmark("5000 glyphs", glyphs);
+
+		std::vector<std::vector<ofPolyline>> stars;
+		for(int i = 0; i < 2000; i++){
+			stars.push_back(star(ofRandom(1000), ofRandom(1000), ofRandom(10, 100), ofRandom(5, 40)));
+		}
+		benchmark("2000 svg shapes", stars);
+
+		std::vector<ofPolyline> scene;
+		for(auto & shape: glyphs){
+			scene.insert(scene.end(), shape.begin(), shape.end());
+		}
+		benchmark("one big shape", {scene});
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "reset";
+			ofTessellator tessellator;
+			ofMesh mesh;
+			tessellator.tessellateToMesh(glyphs[0], OF_POLY_WINDING_ODD, mesh);
+			tessellator.resetAllocationStats();
+			auto stats = tessellator.getAllocationStats();
+			test_eq(stats.allocations, 0u, "reset allocations");
+			test_eq(stats.tessellations, 0u, "reset tessellations");
+
+			auto copy = tessellator;
+			copy.tessellateToMesh(glyphs[1], OF_POLY_WINDING_ODD, mesh);
+			test_gt(mesh.getNumIndices(), 0u, "copied tessellator has its own arena");
+			test_eq(tessellator.getAllocationStats().tessellations, 0u, "copied tessellator has its own counters");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
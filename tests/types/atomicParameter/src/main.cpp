@@ -0,0 +1,108 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ofParameter compatibility";
+			ofAtomicParameter<float> volume{"volume", 0.5, 0, 1};
+			test_eq(volume.load(), 0.5f, "initial value");
+			volume = 0.25;
+			test_eq(volume.load(), 0.25f, "set");
+
+			ofParameterGroup group{"synth"};
+			group.add(volume);
+			test_eq(volume.type(), std::string(typeid(ofParameter<float>).name()), "same type as an ofParameter");
+			group.getFloat("volume") = 0.75;
+			test_eq(volume.load(), 0.75f, "set through a reference");
+			group.getFloat("volume").fromString("0.125");
+			test_eq(volume.load(), 0.125f, "set through deserialization");
+			test_eq(volume.toString(), ofToString(0.125f), "serialization");
+
+			bool listenerSawValue = false;
+			auto listener = volume.newListener([&](float & v){
+				listenerSawValue = volume.load() == v;
+			});
+			volume = 0.5;
+			test(listenerSawValue, "value stored before other listeners run");
+
+			volume.setWithoutEventNotifications(0.3);
+			test_eq(volume.load(), 0.3f, "set without notifications");
+
+			{
+				ofParameterTransaction transaction;
+				volume = 1;
+				test_eq(volume.load(), 0.3f, "transactions store the value when committed");
+			}
+			test_eq(volume.load(), 1.f, "transaction committed");
+
+			ofAtomicParameter<float> copy = volume;
+			volume = 0.1;
+			test_eq(copy.load(), 0.1f, "copies share the value");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "reads from another thread";
+			ofAtomicParameter<glm::vec4> color{"color", glm::vec4(0)};
+			std::atomic<bool> done{false};
+			std::atomic<int> torn{0};
+			std::atomic<int> reads{0};
+			std::thread reader([&]{
+				while(!done){
+					auto v = color.load();
+					if(v.x != v.y || v.y != v.z || v.z != v.w){
+						torn++;
+					}
+					reads++;
+				}
+			});
+			for(int i = 0; i < 100000; i++){
+				color = glm::vec4(float(i));
+			}
+			done = true;
+			reader.join();
+			test_gt(reads.load(), 0, "reader ran");
+			test_eq(torn.load(), 0, "vectors are never read half written");
+			test_eq(color.load(), glm::vec4(99999), "last value");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "smoothing";
+			ofAtomicParameter<float> gain{"gain", 0};
+			test_eq(gain.smooth(64, 1000), 0.f, "first block starts at the value");
+			gain = 1;
+			test_eq(gain.smooth(64, 1000), 1.f, "no smoothing jumps to the value");
+
+			gain.setSmoothing(OF_PARAMETER_SMOOTHING_LINEAR, 0.1);
+			gain = 0;
+			test_eq(gain.smooth(50, 1000), 0.5f, "linear ramp half way");
+			test_eq(gain.getBlockStart(), 1.f, "block start");
+			test_eq(gain.smooth(25, 1000), 0.25f, "linear ramp three quarters");
+			test_eq(gain.smooth(50, 1000), 0.f, "linear ramp reaches the value");
+			test_eq(gain.smooth(50, 1000), 0.f, "linear ramp stays at the value");
+
+			gain.setSmoothing(OF_PARAMETER_SMOOTHING_ONE_POLE, 0.1);
+			gain = 1;
+			auto first = gain.smooth(100, 1000);
+			test(first > 0.6f && first < 0.65f, "one pole moves 1 - 1/e in one time constant");
+			float last = first;
+			for(int i = 0; i < 10; i++){
+				last = gain.smooth(100, 1000);
+			}
+			test(last > 0.9999f && last <= 1.f, "one pole converges");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
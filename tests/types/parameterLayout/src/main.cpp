@@ -0,0 +1,171 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofParameterGroup parameters{"parameters"};
+		ofParameter<float> size{"size", 10, 0, 100};
+		ofParameter<int> count{"count", 1, 0, 10};
+		ofParameter<bool> enabled{"enabled", false};
+		ofParameter<std::string> label{"label", "text"};
+		ofParameterGroup style{"style"};
+		ofParameter<ofFloatColor> color{"color", ofFloatColor(0, 0, 0, 1)};
+		ofParameter<glm::vec3> position{"position", glm::vec3(0)};
+		style.add(color, position);
+		parameters.add(size, count, enabled, label, style);
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "layout";
+			ofParameterLayout layout(parameters);
+			test_eq(layout.size(), 5u, "strings are skipped");
+			test_eq(layout.getSnapshotSize(), 1u + 2u + 1u + 4u + 3u, "vectors and colors take a float per component, ints 2");
+			test_eq(layout.getPath(3), std::string("style/color"), "paths include the name of the groups");
+			test_eq(layout.getOffset(4), 8u, "offsets follow the size of previous parameters");
+
+			ofParameterGroup repeated{"repeated"};
+			ofParameter<float> reference = size;
+			repeated.add(size, reference);
+			test_eq(ofParameterLayout(repeated).size(), 1u, "repeated parameters are skipped");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "capture and restore";
+			ofParameterLayout layout(parameters);
+			auto initial = layout.capture();
+			size = 50;
+			count = 7;
+			enabled = true;
+			color = ofFloatColor(1, 0.5, 0.25, 1);
+			position = glm::vec3(1, 2, 3);
+			auto changed = layout.capture();
+
+			layout.restore(initial);
+			test_eq(size.get(), 10.f, "float restored");
+			test_eq(count.get(), 1, "int restored");
+			test_eq(enabled.get(), false, "bool restored");
+			test_eq(color.get(), ofFloatColor(0, 0, 0, 1), "color restored");
+			test_eq(position.get(), glm::vec3(0), "vector restored");
+
+			int numNotifications = 0;
+			bool sawWholePreset = true;
+			auto listener = parameters.parameterChangedE().newListener([&](ofAbstractParameter &){
+				numNotifications++;
+				sawWholePreset &= size == 50 && count == 7 && enabled && position.get() == glm::vec3(1, 2, 3);
+			});
+			layout.restore(changed);
+			test_eq(numNotifications, 5, "a notification per changed parameter");
+			test(sawWholePreset, "listeners see the whole preset");
+
+			numNotifications = 0;
+			layout.restore(changed);
+			test_eq(numNotifications, 0, "parameters that didn't change don't notify");
+
+			layout.restore(initial, false);
+			test_eq(numNotifications, 0, "restoring without notifications");
+			test_eq(size.get(), 10.f, "restoring without notifications sets the values");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "precision";
+			ofParameterGroup precise{"precise"};
+			ofParameter<double> ratio{"ratio", 0.1};
+			ofParameter<int> big{"big", (1 << 24) + 1};
+			precise.add(ratio, big);
+			ofParameterLayout layout(precise);
+			auto snapshot = layout.capture();
+
+			int numNotifications = 0;
+			auto listener = precise.parameterChangedE().newListener([&](ofAbstractParameter &){
+				numNotifications++;
+			});
+			layout.restore(snapshot);
+			test_eq(numNotifications, 0, "unchanged doubles and ints don't notify");
+			test_eq(ratio.get(), 0.1, "doubles keep their precision");
+			test_eq(big.get(), (1 << 24) + 1, "ints keep their precision");
+
+			ratio = 1.0 / 3.0;
+			big = -123456789;
+			auto changed = layout.capture();
+			layout.restore(snapshot);
+			layout.restore(changed);
+			test_eq(ratio.get(), 1.0 / 3.0, "doubles restored exactly");
+			test_eq(big.get(), -123456789, "ints restored exactly");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "lerp";
+			ofParameterLayout layout(parameters);
+			size = 0;
+			count = 0;
+			enabled = false;
+			auto from = layout.capture();
+			size = 100;
+			count = 3;
+			enabled = true;
+			auto to = layout.capture();
+
+			std::vector<float> mixed;
+			ofParameterLayout::lerp(from, to, 0.25, mixed);
+			layout.restore(mixed);
+			test_eq(size.get(), 25.f, "floats are interpolated");
+			test_eq(count.get(), 1, "ints are rounded");
+			test_eq(enabled.get(), false, "bools are false up to half way");
+			ofParameterLayout::lerp(from, to, 0.75, mixed);
+			layout.restore(mixed);
+			test_eq(enabled.get(), true, "bools are true after half way");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "save and load";
+			ofParameterLayout layout(parameters);
+			size = 42;
+			position = glm::vec3(4, 5, 6);
+			auto saved = layout.capture();
+			test(layout.save("preset.ofpl", saved), "preset saved");
+
+			std::vector<float> loaded;
+			test(layout.load("preset.ofpl", loaded), "preset loaded");
+			test(loaded == saved, "loaded preset is equal to the saved one");
+
+			ofParameterGroup other{"parameters"};
+			ofParameter<float> otherSize{"size", 0};
+			ofParameter<double> speed{"speed", 3};
+			ofParameterGroup otherStyle{"style"};
+			ofParameter<glm::vec3> otherPosition{"position", glm::vec3(0)};
+			otherStyle.add(otherPosition);
+			other.add(speed, otherStyle, otherSize);
+			ofParameterLayout otherLayout(other);
+			test(otherLayout.getHash() != layout.getHash(), "different layouts have different hashes");
+			test(otherLayout.load("preset.ofpl", loaded), "preset loaded into a different layout");
+			otherLayout.restore(loaded);
+			test_eq(otherSize.get(), 42.f, "parameters are matched by path");
+			test_eq(otherPosition.get(), glm::vec3(4, 5, 6), "parameters in subgroups are matched by path");
+			test_eq(speed.get(), 3., "parameters not in the file keep their value");
+
+			ofBuffer corrupted = ofBufferFromFile("preset.ofpl", true);
+			corrupted.getData()[4] = 99;
+			ofBufferToFile("corrupted.ofpl", corrupted, true);
+			test(!layout.load("corrupted.ofpl", loaded), "unknown versions are rejected");
+
+			ofBuffer truncated = ofBufferFromFile("preset.ofpl", true);
+			truncated.resize(truncated.size() - 1);
+			ofBufferToFile("truncated.ofpl", truncated, true);
+			test(!layout.load("truncated.ofpl", loaded), "truncated files are rejected");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
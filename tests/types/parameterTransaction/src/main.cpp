@@ -0,0 +1,188 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofParameterGroup parameters{"parameters"};
+		ofParameter<float> x{"x", 0};
+		ofParameter<float> y{"y", 0};
+		ofParameterGroup style{"style"};
+		ofParameter<int> width{"width", 1};
+		style.add(width);
+		parameters.add(x, y, style);
+
+		int xChanged = 0;
+		float xLast = 0;
+		int parameterChanged = 0;
+		int parametersBatch = 0;
+		int styleBatch = 0;
+		ofEventListeners listeners;
+		listeners.push(x.newListener([&](float & value){
+			xChanged++;
+			xLast = value;
+		}));
+		listeners.push(parameters.parameterChangedE().newListener([&](ofAbstractParameter &){
+			parameterChanged++;
+		}));
+		listeners.push(parameters.batchChangedE().newListener([&]{
+			parametersBatch++;
+		}));
+		listeners.push(style.batchChangedE().newListener([&]{
+			styleBatch++;
+		}));
+		auto reset = [&]{
+			xChanged = 0;
+			parameterChanged = 0;
+			parametersBatch = 0;
+			styleBatch = 0;
+		};
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "without transaction";
+			reset();
+			for(int i = 0; i < 10; i++){
+				x = i;
+			}
+			width = 2;
+			test_eq(xChanged, 10, "every set notifies the parameter");
+			test_eq(parameterChanged, 11, "every set notifies the group");
+			test_eq(parametersBatch, 11, "every set notifies the group batch event");
+			test_eq(styleBatch, 1, "sets notify the batch event of the subgroup");
+			test(!ofParameterTransaction::isActive(), "no transaction active");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "transaction";
+			reset();
+			{
+				ofParameterTransaction transaction;
+				test(ofParameterTransaction::isActive(), "transaction active");
+				for(int i = 0; i < 10; i++){
+					x = i;
+					y = i;
+				}
+				width = 3;
+				test_eq(x.get(), 9.f, "values change right away");
+				test_eq(xChanged, 0, "notifications wait for the commit");
+				test_eq(transaction.size(), 3u, "changes are deduplicated");
+			}
+			test_eq(xChanged, 1, "parameter notified once");
+			test_eq(xLast, 9.f, "parameter notified with its last value");
+			test_eq(parameterChanged, 3, "group notified once per changed parameter");
+			test_eq(parametersBatch, 1, "group batch event notified once");
+			test_eq(styleBatch, 1, "subgroup batch event notified once");
+			test(!ofParameterTransaction::isActive(), "transaction finished");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "explicit commit";
+			reset();
+			ofParameterTransaction transaction;
+			x = 1;
+			transaction.commit();
+			test_eq(xChanged, 1, "commit notifies");
+			test_eq(transaction.size(), 0u, "commit clears the changes");
+			x = 2;
+			test_eq(xChanged, 1, "sets after commit are batched again");
+			transaction.commit();
+			test_eq(xChanged, 2, "second commit notifies");
+			transaction.commit();
+			test_eq(parametersBatch, 2, "commit without changes doesn't notify");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "nested transactions";
+			reset();
+			{
+				ofParameterTransaction outer;
+				x = 1;
+				{
+					ofParameterTransaction inner;
+					x = 2;
+					y = 2;
+				}
+				test_eq(xChanged, 0, "inner transaction hands its changes to the outer one");
+				test_eq(outer.size(), 2u, "changes merged into the outer transaction");
+			}
+			test_eq(xChanged, 1, "outer transaction notifies once");
+			test_eq(parametersBatch, 1, "outer transaction notifies the group once");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "transactions destroyed out of order";
+			reset();
+			auto outer = std::make_unique<ofParameterTransaction>();
+			auto inner = std::make_unique<ofParameterTransaction>();
+			x = 1;
+			outer.reset();
+			test_eq(xChanged, 0, "destroying the outer transaction keeps the inner one batching");
+			test(ofParameterTransaction::isActive(), "the inner transaction is still active");
+			inner.reset();
+			test_eq(xChanged, 1, "the inner transaction notifies without the outer one");
+			test(!ofParameterTransaction::isActive(), "no transaction is active after both are destroyed");
+			x = 2;
+			test_eq(xChanged, 2, "sets notify right away again");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "sets from listeners";
+			reset();
+			ofEventListener listener(x.newListener([&](float & value){
+				y = value * 2;
+			}));
+			{
+				ofParameterTransaction transaction;
+				x = 5;
+			}
+			test_eq(y.get(), 10.f, "listeners can set other parameters during the commit");
+			test_eq(parameterChanged, 2, "sets from listeners notify normally");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "deferred commit";
+			reset();
+			ofEventQueue queue;
+			{
+				ofParameterTransaction transaction(queue);
+				x = 1;
+				y = 1;
+			}
+			{
+				ofParameterTransaction transaction(queue);
+				x = 2;
+			}
+			std::thread worker([&]{
+				ofParameterTransaction transaction(queue);
+				width = 4;
+			});
+			worker.join();
+			test_eq(xChanged, 0, "deferred transactions wait for the queue");
+			test_eq(queue.size(), 1u, "transactions committed to a queue are merged");
+			queue.flush();
+			test_eq(xChanged, 1, "parameter notified once when the queue is flushed");
+			test_eq(xLast, 2.f, "parameter notified with its last value");
+			test_eq(parameterChanged, 3, "group notified once per changed parameter");
+			test_eq(parametersBatch, 1, "group batch event notified once per flush");
+			test_eq(styleBatch, 1, "changes from other threads are merged");
+			queue.flush();
+			test_eq(xChanged, 1, "nothing left after the flush");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -212,6 +212,43 @@ class ofApp: public ofxUnitTestsApp{
 			test(allLinesEqual, "all lines are correct");
 			test_eq(numLines,lines.size(),"lines iterator correct numLines");
 		}
+
+		{
+			ofLogNotice() << "-------------------";
+			ofLogNotice() << "mapped file";
+			std::string text("Lorem ipsum dolor sit amet,\nconsectetur adipiscing elit.\n");
+			ofBufferToFile("mapped.txt", ofBuffer(text.c_str(), text.size()));
+			ofBuffer buffer;
+			test(buffer.mapFile("mapped.txt", OF_BUFFER_ACCESS_SEQUENTIAL), "mapFile");
+			test(buffer.isMapped(), "isMapped");
+			test_eq(buffer.size(), text.size(), "mapped size");
+			test_eq(buffer.getText(), text, "mapped getText");
+			const ofBuffer & constBuffer = buffer;
+			test(constBuffer.end() == constBuffer.begin() + text.size(), "correct boundaries");
+			test_eq(buffer.getFirstLine(), "Lorem ipsum dolor sit amet,", "mapped lines");
+			test(buffer.isMapped(), "reading doesn't copy the mapping");
+
+			ofBuffer copy = buffer;
+			buffer.getData()[0] = 'l';
+			test(!buffer.isMapped(), "writing copies the mapping");
+			test_eq(ofBufferFromFile("mapped.txt").getText(), text, "writing to the buffer doesn't change the file");
+			test(copy.isMapped(), "copies keep the mapping");
+			test_eq(copy.getText(), text, "copies don't see each other's writes");
+
+			copy.append("Vivamus viverra tortor ut condimentum");
+			test(!copy.isMapped(), "append copies the mapping");
+			test_eq(copy.getText(), text + "Vivamus viverra tortor ut condimentum", "data is correct after append");
+			test_eq(buffer.getText(), "l" + text.substr(1), "data is correct after writing");
+
+			ofBuffer empty;
+			ofBufferToFile("empty.txt", empty);
+			test(empty.mapFile("empty.txt"), "map empty file");
+			test_eq(empty.size(), 0, "empty mapped size");
+
+			ofBuffer missing;
+			test(!missing.mapFile("doesnt_exist.txt"), "map missing file fails");
+			test_eq(missing.size(), 0, "missing mapped size");
+		}
 	}
 };
 
@@ -0,0 +1,144 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ofParallelFor";
+			std::vector<int> results(100000, 0);
+			ofParallelFor(0, results.size(), 64, [&](size_t i){
+				results[i] = int(i) * 2;
+			});
+			bool allRan = true;
+			for(size_t i = 0; i < results.size(); i++){
+				allRan &= results[i] == int(i) * 2;
+			}
+			test(allRan, "every index once");
+
+			std::atomic<int> calls{0};
+			ofParallelFor(10, 10, [&](size_t){
+				calls++;
+			});
+			test_eq(calls.load(), 0, "empty range");
+
+			std::atomic<size_t> covered{0};
+			std::atomic<bool> biggerThanGrain{false};
+			ofParallelForRange(5, 1005, 100, [&](size_t first, size_t last){
+				covered += last - first;
+				if(last - first > 100){
+					biggerThanGrain = true;
+				}
+			});
+			test_eq(covered.load(), size_t(1000), "ranges cover the whole range");
+			test(!biggerThanGrain, "ranges no bigger than the grain");
+
+			std::atomic<int> inner{0};
+			ofParallelFor(0, 16, 1, [&](size_t){
+				ofParallelFor(0, 100, 10, [&](size_t){
+					inner++;
+				});
+			});
+			test_eq(inner.load(), 1600, "nested loops");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "ofParallelReduce";
+			auto sum = ofParallelReduce(0, 100000, 0, uint64_t(0),
+				[](size_t i){ return uint64_t(i); },
+				[](uint64_t a, uint64_t b){ return a + b; });
+			test_eq(sum, uint64_t(100000) * 99999 / 2, "sum");
+
+			auto digits = ofParallelReduce(0, 100, 7, std::string(),
+				[](size_t i){ return ofToString(i % 10); },
+				[](const std::string & a, const std::string & b){ return a + b; });
+			std::string expected;
+			for(size_t i = 0; i < 100; i++){
+				expected += ofToString(i % 10);
+			}
+			test_eq(digits, expected, "reduced in order");
+
+			std::vector<float> values(100000);
+			for(size_t i = 0; i < values.size(); i++){
+				values[i] = 1.f / (i + 1);
+			}
+			auto floatSum = [&]{
+				return ofParallelReduce(0, values.size(), 1000, 0.f,
+					[&](size_t i){ return values[i]; },
+					[](float a, float b){ return a + b; });
+			};
+			float serial = 0;
+			for(size_t chunk = 0; chunk < values.size(); chunk += 1000){
+				float partial = 0;
+				for(size_t i = chunk; i < chunk + 1000; i++){
+					partial += values[i];
+				}
+				serial += partial;
+			}
+			bool deterministic = true;
+			for(int i = 0; i < 10; i++){
+				deterministic &= floatSum() == serial;
+			}
+			test(deterministic, "floating point results don't depend on the scheduling");
+
+			auto empty = ofParallelReduce(3, 3, 0, 7,
+				[](size_t){ return 1; },
+				[](int a, int b){ return a + b; });
+			test_eq(empty, 7, "empty range returns the identity");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "pixels and meshes";
+			ofPixels pixels;
+			pixels.allocate(64, 48, OF_PIXELS_GRAY);
+			ofParallelForRows(pixels, [](ofPixels::Line line){
+				for(auto & c: line){
+					c = line.getLineNum();
+				}
+			});
+			bool rowsSet = true;
+			for(size_t y = 0; y < pixels.getHeight(); y++){
+				for(size_t x = 0; x < pixels.getWidth(); x++){
+					rowsSet &= pixels[y * pixels.getWidth() + x] == y;
+				}
+			}
+			test(rowsSet, "every row once");
+
+			const ofPixels & constPixels = pixels;
+			std::atomic<size_t> total{0};
+			ofParallelForRows(constPixels, [&](ofPixels::ConstLine line){
+				size_t lineTotal = 0;
+				for(auto c: line){
+					lineTotal += c;
+				}
+				total += lineTotal;
+			});
+			test_eq(total.load(), size_t(64 * 47 * 48 / 2), "read only rows");
+
+			ofMesh mesh;
+			for(int i = 0; i < 10000; i++){
+				mesh.addVertex({float(i), 0, 0});
+			}
+			ofParallelForVertices(mesh, [](glm::vec3 & v, size_t i){
+				v.y = float(i) * 2;
+			});
+			bool verticesSet = true;
+			for(size_t i = 0; i < mesh.getNumVertices(); i++){
+				verticesSet &= mesh.getVertex(i) == glm::vec3(float(i), float(i) * 2, 0);
+			}
+			test(verticesSet, "every vertex once");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
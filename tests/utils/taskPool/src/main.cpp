@@ -0,0 +1,179 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "workers";
+			ofTaskPool::Settings settings;
+			settings.numThreads = 1000;
+			ofTaskPool pool(settings);
+			test_eq(pool.getNumThreads(), ofTaskPool::getMaxThreads(), "number of threads capped to the number of cores");
+			test(!pool.isWorkerThread(), "main thread isn't a worker");
+			// waiting for a task would run it in this thread, poll instead
+			std::atomic<int> inWorker{-1};
+			pool.post([&]{
+				inWorker = pool.isWorkerThread();
+			});
+			while(inWorker == -1){
+				ofSleepMillis(1);
+			}
+			test_eq(inWorker.load(), 1, "tasks run in the workers");
+			test_gt(ofGetTaskPool().getNumThreads(), 0u, "shared pool has workers");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "tasks";
+			ofTaskPool pool;
+			ofTask<int> empty;
+			test(!empty.isValid(), "default task is invalid");
+			auto answer = pool.submit([]{
+				return 42;
+			});
+			test(answer.isValid(), "submitted task is valid");
+			test_eq(answer.get(), 42, "result");
+			test(answer.isReady(), "ready after get");
+
+			auto text = answer.then([](int value){
+				return ofToString(value);
+			}).then([](const std::string & text){
+				return text + "!";
+			});
+			test_eq(text.get(), std::string("42!"), "continuations receive the result");
+
+			std::atomic<bool> ran{false};
+			auto done = pool.submit([&]{
+				ran = true;
+			}).then([&]{
+				return ran.load();
+			});
+			test(done.get(), "continuations of void tasks");
+
+			auto failed = pool.submit([]() -> int{
+				throw std::runtime_error("failed");
+			});
+			bool caught = false;
+			try{
+				failed.get();
+			}catch(const std::runtime_error &){
+				caught = true;
+			}
+			test(caught, "exceptions are rethrown by get");
+
+			bool noState = false;
+			try{
+				empty.get();
+			}catch(const std::future_error & e){
+				noState = e.code() == std::future_errc::no_state;
+			}
+			test(noState, "get on an invalid task throws no_state");
+			auto invalidThen = empty.then([](int value){
+				return value;
+			});
+			test(!invalidThen.isValid(), "continuations of an invalid task are invalid");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "nested tasks";
+			ofTaskPool pool;
+			std::function<uint64_t(int)> fib = [&](int n) -> uint64_t{
+				if(n < 12){
+					uint64_t a = 0, b = 1;
+					for(int i = 0; i < n; i++){
+						auto c = a + b;
+						a = b;
+						b = c;
+					}
+					return a;
+				}
+				auto left = pool.submit([&fib, n]{ return fib(n - 1); });
+				auto right = fib(n - 2);
+				return left.get() + right;
+			};
+			test_eq(pool.submit([&]{ return fib(25); }).get(), uint64_t(75025), "tasks waiting for tasks don't block the workers");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "task groups";
+			ofTaskPool pool;
+			std::vector<int> results(1000, 0);
+			{
+				ofTaskGroup group(pool);
+				for(int i = 0; i < int(results.size()); i++){
+					group.run([&results, i]{
+						results[i] = i * 2;
+					});
+				}
+				group.wait();
+				test(group.isDone(), "group done after wait");
+			}
+			bool allRan = true;
+			for(int i = 0; i < int(results.size()); i++){
+				allRan &= results[i] == i * 2;
+			}
+			test(allRan, "all the functions of the group ran");
+
+			std::atomic<int> count{0};
+			{
+				ofTaskGroup group(pool);
+				for(int i = 0; i < 100; i++){
+					group.run([&]{
+						ofSleepMillis(1);
+						count++;
+					});
+				}
+			}
+			test_eq(count.load(), 100, "destructor waits for the group");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "work stealing";
+			ofTaskPool pool;
+			std::mutex mutex;
+			std::set<std::thread::id> threads;
+			// all the tasks are submitted from one worker so the others
+			// can only get them by stealing
+			pool.submit([&]{
+				ofTaskGroup group(pool);
+				for(int i = 0; i < 200; i++){
+					group.run([&]{
+						ofSleepMillis(1);
+						std::unique_lock<std::mutex> lck(mutex);
+						threads.insert(std::this_thread::get_id());
+					});
+				}
+			}).wait();
+			test(threads.size() >= pool.getNumThreads(), "idle workers steal tasks");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "destruction";
+			std::atomic<int> count{0};
+			{
+				ofTaskPool pool;
+				for(int i = 0; i < 100; i++){
+					pool.post([&]{
+						count++;
+					});
+				}
+			}
+			test_eq(count.load(), 100, "pending tasks run before the pool is destroyed");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
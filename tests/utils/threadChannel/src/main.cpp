@@ -0,0 +1,167 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "bounded channels";
+			ofSpscThreadChannel<int> channel(5);
+			test_eq(channel.capacity(), size_t(8), "capacity rounded to a power of 2");
+			test(channel.empty(), "empty");
+			for(int i = 0; i < 3; i++){
+				channel.send(i);
+			}
+			test_eq(channel.size(), size_t(3), "size");
+			int value = -1;
+			bool inOrder = true;
+			for(int i = 0; i < 3; i++){
+				inOrder &= channel.tryReceive(value) && value == i;
+			}
+			test(inOrder, "values received in the order they were sent");
+			test(!channel.tryReceive(value), "tryReceive doesn't block when empty");
+			auto start = ofGetElapsedTimeMillis();
+			test(!channel.tryReceive(value, 20), "tryReceive with timeout");
+			test_gt(ofGetElapsedTimeMillis() - start, uint64_t(10), "tryReceive waits for the timeout");
+
+			std::string text = "sent";
+			ofSpscThreadChannel<std::string> texts(4);
+			texts.send(text);
+			texts.send(std::move(text));
+			std::vector<std::string> received;
+			test_eq(texts.receiveAll(received), size_t(2), "receiveAll");
+			test_eq(received.size(), size_t(2), "receiveAll appends the values");
+			test_eq(received[1], std::string("sent"), "values moved through the channel");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "overflow";
+			ofSpscThreadChannel<int> newest(4, OF_THREAD_CHANNEL_DROP_NEWEST);
+			for(int i = 0; i < 4; i++){
+				newest.send(i);
+			}
+			test(!newest.send(4), "drop newest drops the value sent");
+			test_eq(newest.getNumOverflows(), uint64_t(1), "overflows counted");
+			std::vector<int> values;
+			newest.receiveAll(values);
+			test_eq(values, std::vector<int>({0, 1, 2, 3}), "drop newest keeps the oldest values");
+
+			ofSpscThreadChannel<int> oldest(4, OF_THREAD_CHANNEL_DROP_OLDEST);
+			for(int i = 0; i < 6; i++){
+				oldest.send(i);
+			}
+			test_eq(oldest.getNumOverflows(), uint64_t(2), "drop oldest overflows counted");
+			values.clear();
+			oldest.receiveAll(values);
+			test_eq(values, std::vector<int>({2, 3, 4, 5}), "drop oldest keeps the newest values");
+
+			ofSpscThreadChannel<int> block(2);
+			block.send(0);
+			block.send(1);
+			test(!block.trySend(2), "trySend doesn't block when full");
+			test(!block.trySend(2, 10), "trySend with timeout");
+			std::thread receiver([&]{
+				ofSleepMillis(10);
+				int value;
+				block.receive(value);
+			});
+			test(block.send(2), "send blocks until there's room");
+			receiver.join();
+			values.clear();
+			block.receiveAll(values);
+			test_eq(values, std::vector<int>({1, 2}), "blocked value sent");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "close";
+			ofSpscThreadChannel<int> channel(4);
+			std::atomic<int> result{-1};
+			std::thread receiver([&]{
+				int value;
+				result = channel.receive(value);
+			});
+			ofSleepMillis(10);
+			channel.close();
+			receiver.join();
+			test_eq(result.load(), 0, "close wakes up the receiver");
+			test(!channel.send(1), "send fails once closed");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "threads";
+			const int numValues = 100000;
+			ofSpscThreadChannel<int> spsc(64);
+			std::thread producer([&]{
+				for(int i = 0; i < numValues; i++){
+					spsc.send(i);
+				}
+			});
+			bool inOrder = true;
+			for(int i = 0; i < numValues; i++){
+				int value;
+				inOrder &= spsc.receive(value) && value == i;
+			}
+			producer.join();
+			test(inOrder, "spsc receives every value in order");
+
+			const int numProducers = 4;
+			ofMpscThreadChannel<int> mpsc(64);
+			std::vector<std::thread> producers;
+			for(int p = 0; p < numProducers; p++){
+				producers.emplace_back([&, p]{
+					for(int i = 0; i < numValues / numProducers; i++){
+						mpsc.send(p * numValues + i);
+					}
+				});
+			}
+			std::vector<int> next(numProducers, 0);
+			bool producerOrder = true;
+			for(int i = 0; i < numValues; i++){
+				int value;
+				mpsc.receive(value);
+				auto & expected = next[value / numValues];
+				producerOrder &= value % numValues == expected;
+				expected++;
+			}
+			for(auto & producer: producers){
+				producer.join();
+			}
+			test(producerOrder, "mpsc keeps the order of every sender");
+			test(mpsc.empty(), "mpsc received every value");
+
+			ofSpscThreadChannel<int> dropping(16, OF_THREAD_CHANNEL_DROP_OLDEST);
+			std::atomic<bool> done{false};
+			std::thread sender([&]{
+				for(int i = 0; i < numValues; i++){
+					dropping.send(i);
+				}
+				done = true;
+			});
+			int last = -1;
+			bool increasing = true;
+			int value;
+			while(!done || !dropping.empty()){
+				if(dropping.tryReceive(value)){
+					increasing &= value > last;
+					last = value;
+				}
+			}
+			sender.join();
+			test(increasing, "dropping the oldest while receiving keeps the order");
+			test_eq(last, numValues - 1, "newest value received");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
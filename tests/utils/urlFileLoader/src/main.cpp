@@ -0,0 +1,331 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+#include "ofxNetwork.h"
+
+// answers GET requests on localhost with the path as the body, paths
+// starting with /delay/ms wait that many milliseconds before answering
+// without blocking other connections. paths starting with /fresh can be
+// cached for a minute and /etag ones have to be revalidated every time
+class HttpStandIn: public ofThread{
+public:
+	bool setup(){
+		port = ofRandom(15000, 65535);
+		if(!server.setup(port, false)){
+			return false;
+		}
+		startThread();
+		return true;
+	}
+
+	~HttpStandIn(){
+		waitForThread(true);
+		server.close();
+	}
+
+	std::string url(const std::string & path) const{
+		return "http://127.0.0.1:" + ofToString(port) + path;
+	}
+
+	int getNumConnections(){
+		return server.getLastID();
+	}
+
+	std::atomic<int> numRequests{0};
+	std::atomic<int> numNotModified{0};
+
+private:
+	struct Reply{
+		int client;
+		uint64_t time;
+		std::string data;
+	};
+
+	void threadedFunction(){
+		while(isThreadRunning()){
+			for(int i = 0; i < server.getLastID(); i++){
+				if(!server.isClientConnected(i)){
+					continue;
+				}
+				char data[4096];
+				int received = server.receiveRawBytes(i, data, sizeof(data));
+				if(received > 0){
+					requests[i].append(data, received);
+				}
+				auto & request = requests[i];
+				auto end = request.find("\r\n\r\n");
+				if(end == std::string::npos){
+					continue;
+				}
+				auto path = ofSplitString(request.substr(0, request.find("\r\n")), " ")[1];
+				auto revalidating = request.substr(0, end).find("If-None-Match: \"v1\"") != std::string::npos;
+				request.erase(0, end + 4);
+				numRequests++;
+				uint64_t delay = 0;
+				if(path.find("/delay/") == 0){
+					delay = ofFromString<uint64_t>(path.substr(7));
+				}
+				std::string body = path;
+				if(ofIsStringInString(path, "/big")){
+					body.assign(100000, 'x');
+				}
+				std::string headers;
+				if(path.find("/fresh") == 0 || path.find("/etag") == 0){
+					headers = "ETag: \"v1\"\r\nCache-Control: " + std::string(path.find("/fresh") == 0 ? "max-age=60" : "no-cache") + "\r\n";
+					if(revalidating){
+						numNotModified++;
+						replies.push_back({i, ofGetElapsedTimeMillis(), "HTTP/1.1 304 Not Modified\r\n" + headers + "\r\n"});
+						continue;
+					}
+				}
+				replies.push_back({i, ofGetElapsedTimeMillis() + delay,
+					"HTTP/1.1 200 OK\r\n" + headers + "Content-Length: " + ofToString(body.size()) + "\r\n\r\n" + body});
+			}
+			auto now = ofGetElapsedTimeMillis();
+			for(auto it = replies.begin(); it != replies.end();){
+				if(it->time <= now){
+					server.sendRawBytes(it->client, it->data.c_str(), it->data.size());
+					it = replies.erase(it);
+				}else{
+					++it;
+				}
+			}
+			ofSleepMillis(1);
+		}
+	}
+
+	int port;
+	ofxTCPServer server;
+	std::map<int, std::string> requests;
+	std::vector<Reply> replies;
+};
+
+class ofApp: public ofxUnitTestsApp{
+	// responses are notified from update, keep it running while waiting
+	void waitFor(std::function<bool()> done, uint64_t timeoutMs){
+		auto start = ofGetElapsedTimeMillis();
+		ofEventArgs args;
+		while(!done() && ofGetElapsedTimeMillis() - start < timeoutMs){
+			ofEvents().update.notify(args);
+			ofSleepMillis(2);
+		}
+	}
+
+	void run(){
+		HttpStandIn http;
+		if(!test(http.setup(), "http stand-in")){
+			return;
+		}
+		ofURLFileLoader loader;
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "requests";
+			auto response = loader.get(http.url("/hello"));
+			test_eq(response.status, 200, "blocking request");
+			test_eq(response.data.getText(), std::string("/hello"), "blocking request data");
+
+			int numDone = 0;
+			auto start = ofGetElapsedTimeMillis();
+			for(int i = 0; i < 8; i++){
+				ofHttpRequest request(http.url("/delay/300"), "");
+				request.done = [&](const ofHttpResponse & response){
+					numDone += response.status == 200;
+				};
+				loader.handleRequestAsync(request);
+			}
+			waitFor([&]{ return numDone == 8; }, 5000);
+			test_eq(numDone, 8, "async requests");
+			test_lt(ofGetElapsedTimeMillis() - start, uint64_t(1200), "async requests run at the same time");
+
+			auto connections = http.getNumConnections();
+			numDone = 0;
+			for(int i = 0; i < 10; i++){
+				ofHttpRequest request(http.url("/reuse"), "");
+				request.done = [&](const ofHttpResponse &){
+					numDone++;
+				};
+				loader.handleRequestAsync(request);
+				waitFor([&]{ return numDone == i + 1; }, 2000);
+			}
+			test_eq(numDone, 10, "sequential requests");
+			test_lt(http.getNumConnections() - connections, 3, "connections are reused");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "priorities";
+			ofURLFileLoaderSettings settings;
+			settings.maxConcurrentRequests = 1;
+			loader.setup(settings);
+			std::vector<int> order;
+			ofHttpRequest busy(http.url("/delay/200"), "");
+			busy.done = [&](const ofHttpResponse &){
+				order.push_back(0);
+			};
+			loader.handleRequestAsync(busy);
+			ofSleepMillis(50);
+			for(int priority: {1, 5, 3}){
+				ofHttpRequest request(http.url("/priority"), "");
+				request.priority = priority;
+				request.done = [&order, priority](const ofHttpResponse &){
+					order.push_back(priority);
+				};
+				loader.handleRequestAsync(request);
+			}
+			waitFor([&]{ return order.size() == 4; }, 3000);
+			test_eq(ofToString(order), ofToString(std::vector<int>{0, 5, 3, 1}), "waiting requests start by priority");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "cancel and timeouts";
+			ofURLFileLoaderSettings settings;
+			settings.maxRetries = 0;
+			loader.setup(settings);
+
+			bool cancelledDone = false;
+			ofHttpRequest cancelled(http.url("/delay/500"), "");
+			cancelled.done = [&](const ofHttpResponse &){
+				cancelledDone = true;
+			};
+			auto id = loader.handleRequestAsync(cancelled);
+			ofSleepMillis(100);
+			loader.remove(id);
+			waitFor([&]{ return cancelledDone; }, 800);
+			test(!cancelledDone, "running requests can be cancelled");
+
+			int status = 0;
+			ofHttpRequest slow(http.url("/delay/3000"), "");
+			slow.timeoutSeconds = 1;
+			slow.done = [&](const ofHttpResponse & response){
+				status = response.status;
+			};
+			loader.handleRequestAsync(slow);
+			waitFor([&]{ return status != 0; }, 2500);
+			test_eq(status, -1, "requests time out");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "progress";
+			uint64_t received = 0;
+			uint64_t total = 0;
+			bool progressInUpdate = true;
+			bool done = false;
+			auto mainThread = std::this_thread::get_id();
+			ofHttpRequest request(http.url("/big"), "");
+			request.progress = [&](uint64_t r, uint64_t t){
+				received = r;
+				total = t;
+				progressInUpdate &= std::this_thread::get_id() == mainThread;
+			};
+			request.done = [&](const ofHttpResponse &){
+				done = true;
+			};
+			loader.handleRequestAsync(request);
+			waitFor([&]{ return done; }, 2000);
+			test_eq(received, uint64_t(100000), "progress reaches the size of the response");
+			test_eq(total, uint64_t(100000), "progress total");
+			test(progressInUpdate, "progress notified in update");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "streaming";
+			size_t streamed = 0;
+			size_t streamedBeforeDone = 0;
+			size_t dataSize = 1;
+			ofHttpRequest request(http.url("/big"), "");
+			request.stream = [&](const ofBuffer & chunk){
+				streamed += chunk.size();
+			};
+			request.done = [&](const ofHttpResponse & response){
+				streamedBeforeDone = streamed;
+				dataSize = response.data.size();
+			};
+			loader.handleRequestAsync(request);
+			waitFor([&]{ return dataSize != 1; }, 2000);
+			test_eq(streamedBeforeDone, size_t(100000), "whole response streamed before done");
+			test_eq(dataSize, size_t(0), "streamed responses aren't kept in the data");
+
+			size_t blockingStreamed = 0;
+			ofHttpRequest blocking(http.url("/big"), "");
+			blocking.stream = [&](const ofBuffer & chunk){
+				blockingStreamed += chunk.size();
+			};
+			loader.handleRequest(blocking);
+			test_eq(blockingStreamed, size_t(100000), "blocking requests stream");
+		}
+
+		{
+			ofLogNotice() << "---------------------------------------";
+			ofLogNotice() << "cache";
+			ofDirectory::removeDirectory("urlCache", true);
+			ofURLFileLoaderSettings settings;
+			settings.cacheDirectory = "urlCache";
+			settings.maxCacheSize = 250000;
+			loader.setup(settings);
+
+			int numRequests = http.numRequests;
+			loader.get(http.url("/fresh/small"));
+			auto cached = loader.get(http.url("/fresh/small"));
+			test_eq(cached.data.getText(), std::string("/fresh/small"), "cached response");
+			test_eq(http.numRequests - numRequests, 1, "fresh responses don't reach the server");
+
+			loader.get(http.url("/etag"));
+			auto revalidated = loader.get(http.url("/etag"));
+			test_eq(revalidated.status, 200, "revalidated status");
+			test_eq(revalidated.data.getText(), std::string("/etag"), "revalidated response");
+			test_eq(http.numNotModified.load(), 1, "expired responses revalidated with their ETag");
+
+			loader.get(http.url("/hello"));
+			auto stats = loader.getCacheStats();
+			test_eq(stats.numEntries, size_t(2), "responses without validators or max-age aren't cached");
+			test_eq(stats.hits, uint64_t(2), "hits");
+			test_eq(stats.revalidations, uint64_t(1), "revalidations");
+			test_eq(stats.misses, uint64_t(3), "misses");
+
+			std::string streamed;
+			bool done = false;
+			ofHttpRequest request(http.url("/fresh/small"), "");
+			request.stream = [&](const ofBuffer & chunk){
+				streamed += chunk.getText();
+			};
+			request.done = [&](const ofHttpResponse &){
+				done = true;
+			};
+			loader.handleRequestAsync(request);
+			waitFor([&]{ return done; }, 2000);
+			test_eq(streamed, std::string("/fresh/small"), "cached responses stream");
+
+			for(int i = 0; i < 3; i++){
+				loader.get(http.url("/fresh/big" + ofToString(i)));
+			}
+			stats = loader.getCacheStats();
+			test(stats.size <= settings.maxCacheSize, "cache stays under its maximum size");
+			test_gt(stats.evictions, uint64_t(0), "least recently used responses evicted");
+
+			ofURLFileLoader reopened;
+			reopened.setup(settings);
+			numRequests = http.numRequests;
+			auto persisted = reopened.get(http.url("/fresh/big2"));
+			test_eq(persisted.data.size(), size_t(100000), "cache persists between loaders");
+			test_eq(http.numRequests.load(), numRequests, "persisted responses don't reach the server");
+
+			loader.clearCache();
+			test_eq(loader.getCacheStats().numEntries, size_t(0), "clear cache");
+			ofDirectory::removeDirectory("urlCache", true);
+		}
+		loader.stop();
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}